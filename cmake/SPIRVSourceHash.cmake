@@ -0,0 +1,21 @@
+# Write the SHA1 of the sources of the translator to OUTPUT as the
+# SPIRV_SOURCE_HASH macro. The sources are listed one per line in INPUTS.
+# OUTPUT is only rewritten if the hash changed, so that the files including
+# it are not recompiled needlessly.
+
+file(STRINGS ${INPUTS} Sources)
+set(Hashes "")
+foreach(Source ${Sources})
+  file(SHA1 ${Source} Hash)
+  set(Hashes "${Hashes}${Hash}")
+endforeach()
+string(SHA1 Hash "${Hashes}")
+
+set(Content "#define SPIRV_SOURCE_HASH \"${Hash}\"\n")
+set(OldContent "")
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} OldContent)
+endif()
+if(NOT OldContent STREQUAL Content)
+  file(WRITE ${OUTPUT} "${Content}")
+endif()
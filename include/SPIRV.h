@@ -55,6 +55,7 @@ void initializeOCL21ToSPIRVPass(PassRegistry&);
 void initializeOCLTypeToSPIRVPass(PassRegistry&);
 void initializeSPIRVLowerBoolPass(PassRegistry&);
 void initializeSPIRVLowerConstExprPass(PassRegistry&);
+void initializeSPIRVLowerInstPass(PassRegistry&);
 void initializeSPIRVLowerOCLBlocksPass(PassRegistry&);
 void initializeSPIRVLowerMemmovePass(PassRegistry&);
 void initializeSPIRVRegularizeLLVMPass(PassRegistry&);
@@ -62,11 +63,147 @@ void initializeSPIRVToOCL20Pass(PassRegistry&);
 void initializeTransOCLMDPass(PassRegistry&);
 }
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
 
 namespace SPIRV {
 class SPIRVModule;
 
+/// \brief When the LLVM module is verified during translation.
+enum VerifyPolicyKind {
+  VerifyNone,
+  VerifyEndOfPipeline,
+  VerifyAfterEachPass,
+};
+
+/// \brief Highest SPIR-V version the LLVM to SPIR-V translation may use for
+/// optional features.
+enum SPIRVMaxVersionKind {
+  SPIRVMaxVersion10,
+  SPIRVMaxVersion11,
+};
+
+/// \brief Options controlling one translation between LLVM and SPIR-V.
+/// Every translation and every pass of it works on its own copy, so
+/// translations with different options may run concurrently in one process.
+struct TranslatorOptions {
+  /// Run mem2reg before translating LLVM to SPIR-V.
+  bool MemToReg;
+  /// Lower constant expressions to instructions.
+  bool LowerConstExpr;
+  /// Erase OpenCL metadata after translating it to SPIR-V friendly metadata.
+  bool EraseOCLMD;
+  /// Verify the module after lowering boolean instructions.
+  bool LowerBoolValidate;
+  /// Verify the module after lowering llvm.memmove.
+  bool LowerMemmoveValidate;
+  /// Expand OpenCL step and smoothstep functions with scalar edges.
+  bool EnableStepExpansion;
+  /// Generate OpenCL kernel argument name metadata.
+  bool GenKernelArgNameMD;
+  /// Generate access qualifier postfix in OpenCL image type names.
+  bool GenImgTypeAccQualPostfix;
+  /// Mangled atomic type name prefix used when translating to OpenCL 2.0.
+  std::string MangledAtomicTypeNamePrefix;
+  /// When to verify the LLVM module. Verification is off by default in
+  /// release builds.
+  VerifyPolicyKind Verify;
+  /// Highest SPIR-V version of the loop controls the writer may emit.
+  /// DependencyInfinite needs SPIR-V 1.1, so parallel loops are only
+  /// annotated with it if 1.1 is allowed. SPIR-V 1.0 by default.
+  SPIRVMaxVersionKind MaxSPIRVVersion;
+  /// If not empty, only the kernel with this name and the functions and
+  /// global variables it references are translated from SPIR-V.
+  std::string KernelName;
+  /// Release the SPIR-V body of each function as soon as it has been
+  /// translated to LLVM, to reduce the peak memory usage of the reader.
+  bool ReleaseFunctionBodies;
+  /// Translate SPIR-V to LLVM IR with SPIR-V builtin functions and variables
+  /// as described in docs/SPIRVRepresentationInLLVM.rst, instead of OpenCL
+  /// builtins. The SPIRVToOCL20 and OCL20To12 passes are not run.
+  bool SPIRVFriendlyIR;
+  /// Translate OpenCL.std extended instructions which have an LLVM intrinsic
+  /// counterpart, e.g. sqrt or popcount, to calls of the intrinsic instead of
+  /// OpenCL builtins.
+  bool ExtInstToIntrinsics;
+  /// Maximum length in bytes of an llvm.memset of zero translated to a copy
+  /// from a zero-initialized constant shared by the module. Longer, non-zero
+  /// and variable length memsets are lowered to stores.
+  unsigned MemsetZeroPoolMaxSize;
+  /// Directory of the on-disk cache of translation results used by
+  /// WriteSPIRV and ReadSPIRV. The cache is disabled if empty. WriteSPIRV
+  /// does not run the translation passes on the module if its result is
+  /// found in the cache.
+  std::string CacheDir;
+  /// Size limit of the translation cache in megabytes. The least recently
+  /// used results are removed when it is exceeded. Zero means no limit.
+  unsigned CacheMaxSizeMB;
+  /// Reuse the SPIR-V of the functions of a module which were translated
+  /// before and are found unchanged in the translation cache, instead of
+  /// translating them again. It requires CacheDir and the binary format.
+  /// The result is equivalent to a translation without the cache, but its
+  /// ids and the order of its module scope instructions depend on which
+  /// functions were found, so it is not byte-identical.
+  bool FunctionCache;
+
+  TranslatorOptions()
+    :MemToReg(true), LowerConstExpr(true), EraseOCLMD(true),
+     LowerBoolValidate(false), LowerMemmoveValidate(false),
+     EnableStepExpansion(true), GenKernelArgNameMD(false),
+     GenImgTypeAccQualPostfix(false),
+     MangledAtomicTypeNamePrefix("U7_Atomic"),
+#ifdef NDEBUG
+     Verify(VerifyNone),
+#else
+     Verify(VerifyAfterEachPass),
+#endif
+     MaxSPIRVVersion(SPIRVMaxVersion10), ReleaseFunctionBodies(false),
+     SPIRVFriendlyIR(false), ExtInstToIntrinsics(false),
+     MemsetZeroPoolMaxSize(1024), CacheMaxSizeMB(1024), FunctionCache(false) {}
+
+  /// Write the options which affect the result of a translation, to key the
+  /// translation cache. The others only affect verification, debugging or
+  /// performance: LowerBoolValidate, LowerMemmoveValidate, Verify,
+  /// ReleaseFunctionBodies, CacheDir and CacheMaxSizeMB. A member added to
+  /// this struct must be written here or added to that list.
+  void writeKey(llvm::raw_ostream &OS) const {
+    OS << MemToReg << LowerConstExpr << EraseOCLMD << EnableStepExpansion
+       << GenKernelArgNameMD << GenImgTypeAccQualPostfix << SPIRVFriendlyIR
+       << ExtInstToIntrinsics << MaxSPIRVVersion << ' '
+       << MemsetZeroPoolMaxSize << ' '
+       << MangledAtomicTypeNamePrefix.size() << ':'
+       << MangledAtomicTypeNamePrefix
+       << KernelName.size() << ':' << KernelName
+       << FunctionCache;
+  }
+};
+
+/// \brief Get the default translator options. They are initialized with the
+/// built-in defaults and updated by the command line options of the
+/// translator.
+const TranslatorOptions &getDefaultTranslatorOptions();
+
+/// \brief Set the maximum number of mangled builtin names kept in the cache
+/// shared by all translations in the process, and empty the cache. Zero
+/// disables the cache. The limit is initialized by the
+/// -spirv-mangle-cache-size option and is not part of TranslatorOptions,
+/// since one translation changing it would affect all the others.
+void setMangleCacheSize(unsigned Size);
+
+/// \brief Get the number of builtin names found in the cache of mangled names
+/// and the number of builtin names mangled since the process started. Unlike
+/// the -stats counters these are also kept in release builds.
+void getMangleCacheStats(uint64_t &Hits, uint64_t &Misses);
+
+/// \brief Get the number of entries of the translation cache used and the
+/// number of lookups which found no entry or one that could not be used
+/// since the process started. Lookups of functions made with
+/// TranslatorOptions::FunctionCache are included. The counts are also kept
+/// in release builds.
+void getTranslationCacheStats(uint64_t &Hits, uint64_t &Misses);
+
 /// \brief Check if a string contains SPIR-V binary.
 bool IsSPIRVBinary(std::string &Img);
 
@@ -96,59 +233,121 @@ namespace llvm {
 /// \returns true if succeeds.
 bool WriteSPIRV(llvm::Module *M, llvm::raw_ostream &OS, std::string &ErrMsg);
 
+/// \brief Translate LLVM module to SPIRV with the given options and write to
+/// ostream.
+/// \returns true if succeeds.
+bool WriteSPIRV(llvm::Module *M, llvm::raw_ostream &OS,
+    const SPIRV::TranslatorOptions &Opts, std::string &ErrMsg);
+
+/// \brief Translate LLVM module to SPIRV and append the SPIR-V binary words
+/// to \p Words.
+/// \returns true if succeeds.
+bool WriteSPIRV(llvm::Module *M, llvm::SmallVectorImpl<uint32_t> &Words,
+    std::string &ErrMsg);
+bool WriteSPIRV(llvm::Module *M, llvm::SmallVectorImpl<uint32_t> &Words,
+    const SPIRV::TranslatorOptions &Opts, std::string &ErrMsg);
+
 /// \brief Load SPIRV from istream and translate to LLVM module.
 /// \returns true if succeeds.
 bool ReadSPIRV(llvm::LLVMContext &C, std::istream &IS, llvm::Module *&M,
     std::string &ErrMsg);
 
+/// \brief Load SPIRV from istream and translate to LLVM module with the given
+/// options.
+/// \returns true if succeeds.
+bool ReadSPIRV(llvm::LLVMContext &C, std::istream &IS,
+    const SPIRV::TranslatorOptions &Opts, llvm::Module *&M,
+    std::string &ErrMsg);
+
+/// \brief Load SPIRV binary from memory and translate to LLVM module.
+/// The words are decoded in place without being copied.
+/// \returns true if succeeds.
+bool ReadSPIRV(llvm::LLVMContext &C, llvm::ArrayRef<uint32_t> Words,
+    llvm::Module *&M, std::string &ErrMsg);
+bool ReadSPIRV(llvm::LLVMContext &C, llvm::ArrayRef<uint32_t> Words,
+    const SPIRV::TranslatorOptions &Opts, llvm::Module *&M,
+    std::string &ErrMsg);
+
+/// \brief Link SPIRV binary modules without translating them to LLVM and
+/// write the SPIRV binary of the result to ostream. Imports are resolved to
+/// the exports of the same name and identical types and constants unified.
+/// \returns true if succeeds.
+bool LinkSPIRV(llvm::ArrayRef<llvm::ArrayRef<uint32_t>> Inputs,
+    llvm::raw_ostream &OS, std::string &ErrMsg);
+
 /// \brief Regularize LLVM module by removing entities not representable by
 /// SPIRV.
 bool RegularizeLLVMForSPIRV(llvm::Module *M, std::string &ErrMsg);
+bool RegularizeLLVMForSPIRV(llvm::Module *M,
+    const SPIRV::TranslatorOptions &Opts, std::string &ErrMsg);
 
 /// \brief Mangle OpenCL builtin function function name.
 void MangleOpenCLBuiltin(const std::string &UnmangledName,
     ArrayRef<Type*> ArgTypes, std::string &MangledName);
 
+/// \brief Demangle the mangled name of an OpenCL builtin function into its
+/// signature, e.g. "clamp(float4, float4, float4)", and mangle the signature
+/// again into \p Remangled. The two names differ where the mangler and clang
+/// mangle differently, see lib/Mangler/NameMangleAPI.h.
+/// \returns false if the name can not be demangled.
+bool DemangleOpenCLBuiltin(const std::string &MangledName,
+    std::string &Signature, std::string &Remangled);
+
 /// Create a pass for translating LLVM to SPIR-V.
-ModulePass *createLLVMToSPIRV(SPIRV::SPIRVModule *);
+ModulePass *createLLVMToSPIRV(SPIRV::SPIRVModule *,
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for translating OCL 2.0 builtin functions to equivalent
 /// OCL 1.2 builtin functions.
-ModulePass *createOCL20To12();
+ModulePass *createOCL20To12(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for translating OCL 2.0 builtin functions to SPIR-V builtin
 /// functions.
-ModulePass *createOCL20ToSPIRV();
+ModulePass *createOCL20ToSPIRV(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for translating OCL 2.1 builtin functions to SPIR-V builtin
 /// functions.
-ModulePass *createOCL21ToSPIRV();
+ModulePass *createOCL21ToSPIRV(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for adapting OCL types for SPIRV.
 ModulePass *createOCLTypeToSPIRV();
 
 /// Create a pass for lowering cast instructions of i1 type.
-ModulePass *createSPIRVLowerBool();
+ModulePass *createSPIRVLowerBool(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for lowering constant expressions to instructions.
-ModulePass *createSPIRVLowerConstExpr();
+ModulePass *createSPIRVLowerConstExpr(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
+
+/// Create a pass for lowering constant expressions, casts of i1 type,
+/// llvm.memmove and llvm.memset in a single walk over the module.
+ModulePass *createSPIRVLowerInst(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for lowering OCL 2.0 blocks to functions calls.
 ModulePass *createSPIRVLowerOCLBlocks();
 
-/// Create a pass for lowering llvm.memmove to llvm.memcpys with a temporary variable.
-ModulePass *createSPIRVLowerMemmove();
+/// Create a pass for lowering llvm.memmove to llvm.memcpy or to copy loops.
+ModulePass *createSPIRVLowerMemmove(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for regularize LLVM module to be translated to SPIR-V.
-ModulePass *createSPIRVRegularizeLLVM();
+ModulePass *createSPIRVRegularizeLLVM(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for translating SPIR-V builtin functions to OCL 2.0 builtin
 /// functions.
-ModulePass *createSPIRVToOCL20();
+ModulePass *createSPIRVToOCL20(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create a pass for translating SPIR 1.2/2.0 metadata to SPIR-V friendly
 /// metadata.
-ModulePass *createTransOCLMD();
+ModulePass *createTransOCLMD(
+    const SPIRV::TranslatorOptions &Opts = SPIRV::getDefaultTranslatorOptions());
 
 /// Create and return a pass that writes the module to the specified
 /// ostream.
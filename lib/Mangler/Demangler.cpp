@@ -0,0 +1,321 @@
+//===-------------------------- Demangler.cpp ----------------------------===//
+//
+//                              SPIR Tools
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===---------------------------------------------------------------------===//
+/*
+ * Parses the Itanium mangled names of OpenCL builtins back into function
+ * descriptors.
+ */
+
+#include "FunctionDescriptor.h"
+#include "ManglingUtils.h"
+#include "NameMangleAPI.h"
+#include "ParameterType.h"
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace SPIR {
+
+class DemangleParser {
+public:
+
+  DemangleParser(const std::string& s) : m_str(s), m_pos(0) {
+  }
+
+  bool parse(FunctionDescriptor& fd) {
+    size_t len;
+    if (!consume("_Z") || !parseNumber(len) || len > m_str.size() - m_pos)
+      return false;
+    fd.name = m_str.substr(m_pos, len);
+    m_pos += len;
+    while (m_pos < m_str.size()) {
+      RefParamType type;
+      if (!parseType(type))
+        return false;
+      fd.parameters.push_back(type);
+    }
+    return !fd.parameters.empty();
+  }
+
+private:
+
+  // A substitution candidate. Address space and CV qualifiers are not part
+  // of ParamType, so a qualified pointee keeps them beside its type. The
+  // function type of a block has no ParamType of its own either; it is
+  // represented by the block and can only be used after U13block_pointer.
+  struct Candidate {
+    RefParamType type;
+    bool qualifiers[ATTR_QUALIFIER_LAST - ATTR_QUALIFIER_FIRST + 1];
+    TypeAttributeEnum addrSpace;
+    bool isQualified;
+    bool isFunction;
+
+    Candidate() : addrSpace(ATTR_PRIVATE), isQualified(false),
+        isFunction(false) {
+      for (unsigned int i = ATTR_QUALIFIER_FIRST; i <= ATTR_QUALIFIER_LAST; i++)
+        qualifiers[i] = false;
+    }
+  };
+
+  bool peek(char c) const {
+    return m_pos < m_str.size() && m_str[m_pos] == c;
+  }
+
+  bool consume(const char* s) {
+    size_t len = std::char_traits<char>::length(s);
+    if (m_str.compare(m_pos, len, s) != 0)
+      return false;
+    m_pos += len;
+    return true;
+  }
+
+  bool parseNumber(size_t& n) {
+    size_t start = m_pos;
+    n = 0;
+    for (; m_pos < m_str.size() && isdigit(m_str[m_pos]); ++m_pos)
+      n = n * 10 + (m_str[m_pos] - '0');
+    return m_pos != start;
+  }
+
+  bool parseSourceName(std::string& name) {
+    size_t len;
+    if (!parseNumber(len) || len > m_str.size() - m_pos)
+      return false;
+    name = m_str.substr(m_pos, len);
+    m_pos += len;
+    return true;
+  }
+
+  // <substitution> ::= S_ | S <seq-id> _
+  bool parseSubstitution(Candidate& c) {
+    if (!consume("S"))
+      return false;
+    size_t index = 0;
+    if (!peek('_')) {
+      for (; m_pos < m_str.size() && m_str[m_pos] != '_'; ++m_pos) {
+        char ch = m_str[m_pos];
+        if (isdigit(ch))
+          index = index * 36 + (ch - '0');
+        else if (ch >= 'A' && ch <= 'Z')
+          index = index * 36 + (ch - 'A' + 10);
+        else
+          return false;
+      }
+      ++index;
+    }
+    if (!consume("_") || index >= m_substitutions.size())
+      return false;
+    c = m_substitutions[index];
+    return true;
+  }
+
+  // Maps the name of an OpenCL opaque type or enumeration to its primitive.
+  // Clang spells images with an access qualifier suffix and with underscores,
+  // e.g. "ocl_image2d_msaa_ro", which are dropped before the comparison.
+  static bool getPrimitive(const std::string& name, TypePrimitiveEnum& prim) {
+    std::string key = name;
+    bool isOCL = key.compare(0, 4, "ocl_") == 0;
+    if (isOCL) {
+      size_t len = key.size();
+      if (len > 3 && (key.compare(len - 3, 3, "_ro") == 0 ||
+                      key.compare(len - 3, 3, "_wo") == 0 ||
+                      key.compare(len - 3, 3, "_rw") == 0))
+        key.erase(len - 3);
+      key = stripUnderscores(key);
+    }
+    for (unsigned i = PRIMITIVE_STRUCT_FIRST; i <= PRIMITIVE_LAST; ++i) {
+      std::string mangled = mangledPrimitiveString((TypePrimitiveEnum)i);
+      size_t start = mangled.find_first_not_of("0123456789");
+      if (start == 0)
+        continue;
+      mangled.erase(0, start);
+      if ((isOCL ? stripUnderscores(mangled) : mangled) == key) {
+        prim = (TypePrimitiveEnum)i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static std::string stripUnderscores(const std::string& s) {
+    std::string res;
+    for (size_t i = 0; i < s.size(); ++i)
+      if (s[i] != '_')
+        res += s[i];
+    return res;
+  }
+
+  static bool getBuiltinPrimitive(char c, TypePrimitiveEnum& prim) {
+    switch (c) {
+    case 'v': prim = PRIMITIVE_VOID; return true;
+    case 'b': prim = PRIMITIVE_BOOL; return true;
+    case 'h': prim = PRIMITIVE_UCHAR; return true;
+    case 'a':
+    case 'c': prim = PRIMITIVE_CHAR; return true;
+    case 't': prim = PRIMITIVE_USHORT; return true;
+    case 's': prim = PRIMITIVE_SHORT; return true;
+    case 'j': prim = PRIMITIVE_UINT; return true;
+    case 'i': prim = PRIMITIVE_INT; return true;
+    case 'y':
+    case 'm': prim = PRIMITIVE_ULONG; return true;
+    case 'x':
+    case 'l': prim = PRIMITIVE_LONG; return true;
+    case 'f': prim = PRIMITIVE_FLOAT; return true;
+    case 'd': prim = PRIMITIVE_DOUBLE; return true;
+    case 'z': prim = PRIMITIVE_VAR_ARG; return true;
+    default: return false;
+    }
+  }
+
+  // <qualified-type> ::= <qualifiers> <type>
+  // Both the order emitted by clang (address space first) and the one
+  // emitted by NameMangler (CV qualifiers first) are accepted.
+  bool parseQualifiedType(Candidate& c) {
+    for (;;) {
+      if (consume("r"))
+        c.qualifiers[ATTR_RESTRICT] = c.isQualified = true;
+      else if (consume("V"))
+        c.qualifiers[ATTR_VOLATILE] = c.isQualified = true;
+      else if (consume("K"))
+        c.qualifiers[ATTR_CONST] = c.isQualified = true;
+      else if (m_str.compare(m_pos, 4, "U3AS") == 0) {
+        // The address space is the vendor qualifier "AS<digit>".
+        ++m_pos;
+        std::string as;
+        if (!parseSourceName(as) || !isdigit(as[2]) ||
+            as[2] - '0' > ATTR_ADDR_SPACE_LAST - ATTR_ADDR_SPACE_FIRST)
+          return false;
+        c.addrSpace = (TypeAttributeEnum)(ATTR_ADDR_SPACE_FIRST + as[2] - '0');
+        c.isQualified = true;
+      } else
+        break;
+    }
+    if (!c.isQualified) {
+      if (peek('S'))
+        return parseSubstitution(c) && !c.isFunction;
+      return parseType(c.type);
+    }
+    if (!parseType(c.type))
+      return false;
+    m_substitutions.push_back(c);
+    return true;
+  }
+
+  bool parseType(RefParamType& type) {
+    if (m_pos >= m_str.size())
+      return false;
+    TypePrimitiveEnum prim;
+    char c = m_str[m_pos];
+    if (getBuiltinPrimitive(c, prim)) {
+      ++m_pos;
+      type = RefParamType(new PrimitiveType(prim));
+      return true;
+    }
+    if (consume("Dh")) {
+      type = RefParamType(new PrimitiveType(PRIMITIVE_HALF));
+      return true;
+    }
+    if (c == 'S') {
+      Candidate sub;
+      if (!parseSubstitution(sub) || sub.isQualified || sub.isFunction)
+        return false;
+      type = sub.type;
+      return true;
+    }
+    if (consume("Dv")) {
+      size_t len;
+      RefParamType scalar;
+      if (!parseNumber(len) || !consume("_") || !parseType(scalar))
+        return false;
+      type = RefParamType(new VectorType(scalar, (int)len));
+    } else if (consume("P")) {
+      Candidate pointee;
+      if (!parseQualifiedType(pointee))
+        return false;
+      PointerType* p = new PointerType(pointee.type);
+      p->setAddressSpace(pointee.addrSpace);
+      for (unsigned int i = ATTR_QUALIFIER_FIRST; i <= ATTR_QUALIFIER_LAST; i++)
+        p->setQualifier((TypeAttributeEnum)i, pointee.qualifiers[i]);
+      type = RefParamType(p);
+    } else if (consume("U7_Atomic")) {
+      RefParamType base;
+      if (!parseType(base))
+        return false;
+      type = RefParamType(new AtomicType(base));
+    } else if (consume("U13block_pointer")) {
+      // The function type and the block pointer are both substitutable, in
+      // this order. The block pointer is recorded below.
+      Candidate fn;
+      if (peek('S')) {
+        if (!parseSubstitution(fn) || !fn.isFunction)
+          return false;
+        type = fn.type;
+      } else {
+        RefParamType ret;
+        if (!consume("F") || !parseType(ret))
+          return false;
+        BlockType* block = new BlockType;
+        type = RefParamType(block);
+        for (unsigned int i = 0; !consume("E"); ++i) {
+          RefParamType param;
+          if (!parseType(param))
+            return false;
+          if (i == 0 && peek('E') && isVoid(param))
+            continue;
+          block->setParam(i, param);
+        }
+        fn.type = type;
+        fn.isFunction = true;
+        m_substitutions.push_back(fn);
+      }
+    } else if (isdigit(c)) {
+      // Types clang treats as builtins, i.e. the "ocl_" ones, are not
+      // substitutable. Other names, including OpenCL enumerations and
+      // ndrange_t, are.
+      std::string name;
+      if (!parseSourceName(name))
+        return false;
+      if (getPrimitive(name, prim))
+        type = RefParamType(new PrimitiveType(prim));
+      else
+        type = RefParamType(new UserDefinedType(name));
+      if (name.compare(0, 4, "ocl_") == 0)
+        return true;
+    } else
+      return false;
+    addSubstitution(type);
+    return true;
+  }
+
+  static bool isVoid(const RefParamType& type) {
+    const PrimitiveType* p = SPIR::dyn_cast<PrimitiveType>(&*type);
+    return p && p->getPrimitive() == PRIMITIVE_VOID;
+  }
+
+  void addSubstitution(const RefParamType& type) {
+    Candidate c;
+    c.type = type;
+    m_substitutions.push_back(c);
+  }
+
+  const std::string& m_str;
+  size_t m_pos;
+  std::vector<Candidate> m_substitutions;
+};
+
+  MangleError demangle(const std::string& mangledName, FunctionDescriptor& fd) {
+    fd = FunctionDescriptor();
+    DemangleParser parser(mangledName);
+    if (!parser.parse(fd)) {
+      fd = FunctionDescriptor::null();
+      return MANGLE_TYPE_NOT_SUPPORTED;
+    }
+    return MANGLE_SUCCESS;
+  }
+
+} // End SPIR namespace
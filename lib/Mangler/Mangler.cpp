@@ -16,8 +16,8 @@
 #include "ParameterType.h"
 #include "SPIRVInternal.h"
 #include <algorithm>
+#include <cstring>
 #include <string>
-#include <sstream>
 #include <map>
 
 // According to IA64 name mangling spec,
@@ -30,7 +30,7 @@ namespace SPIR {
 class MangleVisitor: public TypeVisitor {
 public:
 
-  MangleVisitor(SPIRversion ver, std::stringstream& s) : TypeVisitor(ver), m_stream(s), seqId(0) {
+  MangleVisitor(SPIRversion ver, std::string& s) : TypeVisitor(ver), m_buffer(s), seqId(0) {
   }
 
 //
@@ -38,109 +38,170 @@ public:
 //
   void mangleSequenceID(unsigned SeqID) {
     if (SeqID == 1)
-      m_stream << '0';
+      m_buffer += '0';
     else if (SeqID > 1) {
-      std::string bstr;
-      std::string charset = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+      static const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+      size_t start = m_buffer.size();
       SeqID--;
-      bstr.reserve(7);
       for (; SeqID != 0; SeqID /= 36)
-        bstr += charset.substr(SeqID % 36, 1);
-      std::reverse(bstr.begin(), bstr.end());
-      m_stream << bstr;
+        m_buffer += charset[SeqID % 36];
+      std::reverse(m_buffer.begin() + start, m_buffer.end());
     }
-    m_stream << '_';
+    m_buffer += '_';
   }
 
-  bool mangleSubstitution(const ParamType* type, std::string typeStr) {
-    size_t fpos;
-    std::stringstream thistypeStr;
-    thistypeStr << typeStr;
-    if ((fpos = m_stream.str().find(typeStr)) != std::string::npos) {
-      const char* nType;
-      if (const PointerType* p = SPIR::dyn_cast<PointerType>(type)) {
-        if ((nType = mangledPrimitiveStringfromName(p->getPointee()->toString())))
-          thistypeStr << nType;
-      }
+  // The only candidates which can ever be found again are pointers to and
+  // vectors of primitive types, since the primitive is spelled the same way
+  // each time it is mangled. A candidate is therefore identified by its kind,
+  // its qualifiers, address space or length, and its primitive, which packs
+  // into a single integer. Primitives sharing a mangled spelling share a key.
+  typedef unsigned long long SubstKey;
+
+  static unsigned canonicalPrimitive(unsigned t) {
+    static unsigned canon[PRIMITIVE_NUM];
+    static bool init = initCanonicalPrimitives(canon);
+    (void)init;
+    return canon[t];
+  }
+
+  static bool initCanonicalPrimitives(unsigned* canon) {
+    for (unsigned i = PRIMITIVE_FIRST; i < PRIMITIVE_NUM; ++i) {
+      canon[i] = i;
+      for (unsigned j = PRIMITIVE_FIRST; j < i; ++j)
+        if (!strcmp(mangledPrimitiveString((TypePrimitiveEnum)i),
+                    mangledPrimitiveString((TypePrimitiveEnum)j))) {
+          canon[i] = canon[j];
+          break;
+        }
+    }
+    return true;
+  }
+
+  // Returns the canonical primitive a pointee or vector element stands for,
+  // or PRIMITIVE_NONE. A user type is looked up by the readable name of a
+  // primitive but recorded by its mangled spelling, e.g. a user type named
+  // "ndrange_t" matches the primitive ndrange_t both ways.
+  static unsigned getSubstPrimitive(const ParamType* type, bool lookup) {
+    if (const PrimitiveType* prim = SPIR::dyn_cast<PrimitiveType>(type))
+      return canonicalPrimitive(prim->getPrimitive());
+    if (const UserDefinedType* user = SPIR::dyn_cast<UserDefinedType>(type)) {
+      std::string name = user->toString();
+      if (!lookup)
+        name = std::to_string(name.size()) + name;
+      for (unsigned i = PRIMITIVE_FIRST; i < PRIMITIVE_NUM; ++i)
+        if (name == (lookup ? readablePrimitiveString((TypePrimitiveEnum)i) :
+                              mangledPrimitiveString((TypePrimitiveEnum)i)))
+          return canonicalPrimitive(i);
+    }
+    return PRIMITIVE_NONE;
+  }
+
+  // Returns false if the type can not be substituted.
+  static bool getSubstKey(const ParamType* type, bool lookup, SubstKey& key) {
+    unsigned prim = PRIMITIVE_NONE;
+    SubstKey attrs = 0;
+    if (const PointerType* p = SPIR::dyn_cast<PointerType>(type)) {
+      prim = getSubstPrimitive(&*p->getPointee(), lookup);
+      for (unsigned int i = ATTR_QUALIFIER_FIRST; i <= ATTR_QUALIFIER_LAST; i++)
+        if (p->hasQualifier((TypeAttributeEnum)i))
+          attrs |= 1ULL << i;
+      attrs |= (SubstKey)p->getAddressSpace() << 8;
+    }
 #if defined(ENABLE_MANGLER_VECTOR_SUBSTITUTION)
-      else if (const VectorType* pVec = SPIR::dyn_cast<VectorType>(type)) {
-        if ((nType = mangledPrimitiveStringfromName(pVec->getScalarType()->toString())))
-          thistypeStr << nType;
-      }
-#endif
-      std::map<std::string, unsigned>::iterator I = substitutions.find(thistypeStr.str());
-      if (I == substitutions.end())
-        return false;
-
-      unsigned SeqID = I->second;
-      m_stream << 'S';
-      mangleSequenceID(SeqID);
-      return true;
+    else if (const VectorType* pVec = SPIR::dyn_cast<VectorType>(type)) {
+      prim = getSubstPrimitive(&*pVec->getScalarType(), lookup);
+      attrs = (SubstKey)(unsigned)pVec->getLength();
     }
-    return false;
+#endif
+    if (prim == PRIMITIVE_NONE)
+      return false;
+    key = ((SubstKey)type->getTypeId() << 56) | (attrs << 8) | prim;
+    return true;
+  }
+
+  bool mangleSubstitution(const ParamType* type) {
+    SubstKey key;
+    if (!getSubstKey(type, true, key))
+      return false;
+    std::map<SubstKey, unsigned>::iterator I = substitutions.find(key);
+    if (I == substitutions.end())
+      return false;
+
+    unsigned SeqID = I->second;
+    m_buffer += 'S';
+    mangleSequenceID(SeqID);
+    return true;
+  }
+
+  // Every substitutable entity takes a sequence number, even if it can never
+  // be referred to again.
+  void addSubstitution(const ParamType* type) {
+    SubstKey key;
+    if (getSubstKey(type, false, key))
+      substitutions[key] = seqId;
+    seqId++;
   }
 
 //
 // Visit methods
 //
   MangleError visit(const PrimitiveType* t) {
-    m_stream << mangledPrimitiveString(t->getPrimitive());
+    m_buffer += mangledPrimitiveString(t->getPrimitive());
     return MANGLE_SUCCESS;
   }
 
   MangleError visit(const PointerType* p) {
-    size_t fpos = m_stream.str().size();
-    std::string qualStr;
     MangleError me = MANGLE_SUCCESS;
-    for (unsigned int i = ATTR_QUALIFIER_FIRST; i <= ATTR_QUALIFIER_LAST; i++) {
-      TypeAttributeEnum qualifier = (TypeAttributeEnum)i;
-      if (p->hasQualifier(qualifier)) {
-        qualStr += getMangledAttribute(qualifier);
-      }
-    }
-    qualStr += getMangledAttribute((p->getAddressSpace()));
-    if (!mangleSubstitution(p, "P" + qualStr)) {
+    if (!mangleSubstitution(p)) {
       // A pointee type is substituted when it is a user type, a vector type
       // (but see a comment in the beginning of this file), a pointer type,
       // or a primitive type with qualifiers (addr. space and/or CV qualifiers).
       // So, stream "P", type qualifiers
-      m_stream << "P" << qualStr;
+      m_buffer += 'P';
+      size_t qualLen = m_buffer.size();
+      for (unsigned int i = ATTR_QUALIFIER_FIRST; i <= ATTR_QUALIFIER_LAST; i++) {
+        TypeAttributeEnum qualifier = (TypeAttributeEnum)i;
+        if (p->hasQualifier(qualifier)) {
+          m_buffer += getMangledAttribute(qualifier);
+        }
+      }
+      m_buffer += getMangledAttribute((p->getAddressSpace()));
+      qualLen = m_buffer.size() - qualLen;
       // and the pointee type itself.
       me = p->getPointee()->accept(this);
       // The type qualifiers plus a pointee type is a substitutable entity
-      if(qualStr.length() > 0)
-        substitutions[m_stream.str().substr(fpos + 1)] = seqId++;
+      if (qualLen > 0)
+        seqId++;
       // The complete pointer type is substitutable as well
-      substitutions[m_stream.str().substr(fpos)] = seqId++;
+      addSubstitution(p);
     }
     return me;
   }
 
   MangleError visit(const VectorType* v) {
-    size_t index = m_stream.str().size();
-    std::stringstream typeStr;
-    typeStr << "Dv" << v->getLength() << "_";
     MangleError me = MANGLE_SUCCESS;
 #if defined(ENABLE_MANGLER_VECTOR_SUBSTITUTION)
-    if (!mangleSubstitution(v, typeStr.str()))
+    if (!mangleSubstitution(v))
 #endif
     {
-      m_stream << typeStr.str();
+      m_buffer += "Dv";
+      m_buffer += std::to_string(v->getLength());
+      m_buffer += '_';
       me = v->getScalarType()->accept(this);
-      substitutions[m_stream.str().substr(index)] = seqId++;
+      addSubstitution(v);
     }
     return me;
   }
 
   MangleError visit(const AtomicType* p) {
-    m_stream << "U" << "7_Atomic";
+    m_buffer += "U7_Atomic";
     return p->getBaseType()->accept(this);
   }
 
   MangleError visit(const BlockType* p) {
-    m_stream << "U" << "13block_pointerFv";
+    m_buffer += "U13block_pointerFv";
     if (p->getNumOfParams() == 0)
-      m_stream << "v";
+      m_buffer += 'v';
     else
       for (unsigned int i=0; i < p->getNumOfParams(); ++i) {
         MangleError err = p->getParam(i)->accept(this);
@@ -148,22 +209,24 @@ public:
           return err;
         }
       }
-    m_stream << "E";
+    m_buffer += 'E';
     return MANGLE_SUCCESS;
   }
 
   MangleError visit(const UserDefinedType* pTy) {
     std::string name = pTy->toString();
-    m_stream << name.size() << name;
+    m_buffer += std::to_string(name.size());
+    m_buffer += name;
     return MANGLE_SUCCESS;
   }
 
 private:
 
   // Holds the mangled string representing the prototype of the function.
-  std::stringstream& m_stream;
+  // It is only ever appended to.
+  std::string& m_buffer;
   unsigned seqId;
-  std::map<std::string, unsigned> substitutions;
+  std::map<SubstKey, unsigned> substitutions;
 };
 
 //
@@ -176,8 +239,11 @@ private:
       mangledName.assign(FunctionDescriptor::nullString());
       return MANGLE_NULL_FUNC_DESCRIPTOR;
     }
-    std::stringstream ret;
-    ret << "_Z" << fd.name.length() << fd.name;
+    std::string ret;
+    ret.reserve(fd.name.length() + 8 * fd.parameters.size() + 8);
+    ret += "_Z";
+    ret += std::to_string(fd.name.length());
+    ret += fd.name;
     MangleVisitor visitor(m_spir_version, ret);
     for (unsigned int i=0; i < fd.parameters.size(); ++i) {
       MangleError err = fd.parameters[i]->accept(&visitor);
@@ -190,7 +256,7 @@ private:
         return err;
       }
     }
-    mangledName.assign(ret.str());
+    mangledName.swap(ret);
     return MANGLE_SUCCESS;
   }
 
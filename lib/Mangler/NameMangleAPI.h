@@ -35,6 +35,32 @@ namespace SPIR {
   private:
     SPIRversion m_spir_version;
   };
+
+  /// @brief Parses the mangled name of an OpenCL builtin back into a function
+  ///        descriptor. Only the subset of the Itanium grammar used by OpenCL
+  ///        C builtins is supported, and substitutions are resolved the way
+  ///        clang emits them.
+  ///
+  ///        NameMangler does not mangle everything the way clang does, so
+  ///        demangling and mangling again is not always the identity:
+  ///        - image access qualifiers are dropped and image names lose their
+  ///          underscores, e.g. ocl_image2d_msaa_ro becomes ocl_image2dmsaa;
+  ///        - CV qualifiers are emitted before the address space, e.g.
+  ///          PU3AS1Kf becomes PKU3AS1f;
+  ///        - user types and OpenCL enumerations such as memory_order are
+  ///          never substituted, e.g. 12memory_orderS4_ becomes
+  ///          12memory_order12memory_order;
+  ///        - atomic types take no substitution index, so any substitution
+  ///          after an atomic type is numbered one lower than clang does.
+  ///        Because of the last one, a name mangled by NameMangler with a
+  ///        substitution after an atomic type does not demangle to the
+  ///        descriptor it was mangled from. Names emitted by clang for the
+  ///        OpenCL builtins do demangle correctly.
+  /// @param std::string the mangled name.
+  /// @param FunctionDescriptor the demangled function, or the null descriptor
+  ///        if the name can not be parsed.
+  /// @return MangleError enum representing the status - success or the error.
+  MangleError demangle(const std::string &, FunctionDescriptor &);
 } // End SPIR namespace
 
 #endif //__NAME_MANGLE_API_H__
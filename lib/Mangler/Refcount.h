@@ -45,6 +45,18 @@ public:
     return *this;
   }
 
+  /// Wraps a pointer whose lifetime is managed elsewhere, e.g. an interned
+  /// type. No counter is allocated and the pointee is never deleted.
+  static RefCount unmanaged(T* ptr) {
+    RefCount ref;
+    ref.m_ptr = ptr;
+    return ref;
+  }
+
+  bool isUnmanaged() const {
+    return m_ptr && !m_refCount;
+  }
+
   void init(T* ptr) {
     assert(!m_ptr && "overrunning non NULL pointer");
     assert(!m_refCount && "overrunning non NULL pointer");
@@ -85,8 +97,7 @@ public:
 private:
   void sanity() const{
     assert(m_ptr && "NULL pointer");
-    assert(m_refCount && "NULL ref counter");
-    assert(*m_refCount && "zero ref counter");
+    assert((!m_refCount || *m_refCount) && "zero ref counter");
   }
 
   void cpy(const RefCount<T>& other) {
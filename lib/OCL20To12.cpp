@@ -58,7 +58,8 @@ namespace SPIRV {
 class OCL20To12: public ModulePass,
   public InstVisitor<OCL20To12> {
 public:
-  OCL20To12():ModulePass(ID), M(nullptr), Ctx(nullptr) {
+  OCL20To12(const TranslatorOptions &TheOpts = getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), Opts(TheOpts) {
     initializeOCL20To12Pass(*PassRegistry::getPassRegistry());
   }
   virtual bool runOnModule(Module &M);
@@ -73,6 +74,7 @@ public:
 private:
   Module *M;
   LLVMContext *Ctx;
+  TranslatorOptions Opts;
 };
 
 char OCL20To12::ID = 0;
@@ -88,11 +90,7 @@ OCL20To12::runOnModule(Module& Module) {
 
   DEBUG(dbgs() << "After OCL20To12:\n" << *M);
 
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "OCL20To12");
   return true;
 }
 
@@ -135,6 +133,6 @@ void OCL20To12::visitCallAtomicWorkItemFence(CallInst* CI) {
 INITIALIZE_PASS(OCL20To12, "ocl20to12",
     "Translate OCL 2.0 builtins to OCL 1.2 builtins", false, false)
 
-ModulePass *llvm::createOCL20To12() {
-  return new OCL20To12();
+ModulePass *llvm::createOCL20To12(const TranslatorOptions &Opts) {
+  return new OCL20To12(Opts);
 }
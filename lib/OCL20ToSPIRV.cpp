@@ -72,7 +72,9 @@ getOCLCpp11AtomicMaxNumOps(StringRef Name) {
 class OCL20ToSPIRV: public ModulePass,
   public InstVisitor<OCL20ToSPIRV> {
 public:
-  OCL20ToSPIRV():ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0) {
+  OCL20ToSPIRV(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0), Opts(TheOpts) {
     initializeOCL20ToSPIRVPass(*PassRegistry::getPassRegistry());
   }
   virtual bool runOnModule(Module &M);
@@ -158,13 +160,17 @@ public:
   ///   cl_khr_int64_base_atomics
   ///   cl_khr_int64_extended_atomics
   /// Do nothing if the called function is not a legacy atomic builtin.
+  /// \param Desc is the demangled builtin, or nullptr if \p MangledName can
+  /// not be demangled, in which case the mangled name is inspected instead.
   void visitCallAtomicLegacy(CallInst *CI, StringRef MangledName,
-    const std::string &DemangledName);
+    const SPIR::FunctionDescriptor *Desc, const std::string &DemangledName);
 
   /// Transform OCL 2.0 C++11 atomic builtins to SPIR-V builtins.
   /// Do nothing if the called function is not a C++11 atomic builtin.
+  /// \param Desc is the demangled builtin, or nullptr if \p MangledName can
+  /// not be demangled, in which case the mangled name is inspected instead.
   void visitCallAtomicCpp11(CallInst *CI, StringRef MangledName,
-    const std::string &DemangledName);
+    const SPIR::FunctionDescriptor *Desc, const std::string &DemangledName);
 
   /// Transform OCL builtin function to SPIR-V builtin function.
   /// Assuming there is a simple name mapping without argument changes.
@@ -278,6 +284,8 @@ private:
   LLVMContext *Ctx;
   unsigned CLVer;                   /// OpenCL version as major*10+minor
   std::set<Value *> ValuesToDelete;
+  OCLBuiltinDescCache BuiltinDescs; /// Demangled parameter types of builtins
+  TranslatorOptions Opts;
 
   ConstantInt *addInt32(int I) {
     return getInt32(M, I);
@@ -356,14 +364,11 @@ OCL20ToSPIRV::runOnModule(Module& Module) {
   for (auto &I:ValuesToDelete)
     if (auto GV = dyn_cast<GlobalValue>(I))
       GV->eraseFromParent();
+  BuiltinDescs.clear();
 
   DEBUG(dbgs() << "After OCL20ToSPIRV:\n" << *M);
 
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "OCL20ToSPIRV");
   return true;
 }
 
@@ -418,8 +423,9 @@ OCL20ToSPIRV::visitCallInst(CallInst& CI) {
       assert(CLVer == kOCLVer::CL20 && "Wrong version of OpenCL");
       PCI = visitCallAtomicCmpXchg(PCI, DemangledName);
     }
-    visitCallAtomicLegacy(PCI, MangledName, DemangledName);
-    visitCallAtomicCpp11(PCI, MangledName, DemangledName);
+    auto Desc = BuiltinDescs.get(F);
+    visitCallAtomicLegacy(PCI, MangledName, Desc, DemangledName);
+    visitCallAtomicCpp11(PCI, MangledName, Desc, DemangledName);
     return;
   }
   if (DemangledName.find(kOCLBuiltinName::ConvertPrefix) == 0) {
@@ -451,11 +457,20 @@ OCL20ToSPIRV::visitCallInst(CallInst& CI) {
     return;
   }
   if (DemangledName.find(kOCLBuiltinName::ReadImage) == 0) {
-    if (MangledName.find(kMangledName::Sampler) != StringRef::npos) {
+    // Fall back to searching the mangled name if it can not be demangled.
+    auto Desc = BuiltinDescs.get(F);
+    if (Desc ? hasParamOfPrimitive(*Desc, [](SPIR::TypePrimitiveEnum P) {
+          return P == SPIR::PRIMITIVE_SAMPLER_T;
+        }) : MangledName.find(kMangledName::Sampler) != StringRef::npos) {
       visitCallReadImageWithSampler(&CI, MangledName, DemangledName);
       return;
     }
-    if (MangledName.find("msaa") != StringRef::npos) {
+    if (Desc ? hasParamOfPrimitive(*Desc, [](SPIR::TypePrimitiveEnum P) {
+          return P == SPIR::PRIMITIVE_IMAGE_2D_MSAA_T ||
+                 P == SPIR::PRIMITIVE_IMAGE_2D_ARRAY_MSAA_T ||
+                 P == SPIR::PRIMITIVE_IMAGE_2D_MSAA_DEPTH_T ||
+                 P == SPIR::PRIMITIVE_IMAGE_2D_ARRAY_MSAA_DEPTH_T;
+        }) : MangledName.find("msaa") != StringRef::npos) {
       visitCallReadImageMSAA(&CI, MangledName, DemangledName);
       return;
     }
@@ -687,8 +702,8 @@ void OCL20ToSPIRV::transMemoryBarrier(CallInst* CI,
 }
 
 void
-OCL20ToSPIRV::visitCallAtomicLegacy(CallInst* CI,
-    StringRef MangledName, const std::string& DemangledName) {
+OCL20ToSPIRV::visitCallAtomicLegacy(CallInst* CI, StringRef MangledName,
+    const SPIR::FunctionDescriptor *Desc, const std::string& DemangledName) {
   StringRef Stem = DemangledName;
   if (Stem.startswith("atom_"))
     Stem = Stem.drop_front(strlen("atom_"));
@@ -708,7 +723,8 @@ OCL20ToSPIRV::visitCallAtomicLegacy(CallInst* CI,
       Stem == "min" ||
       Stem == "max") {
     if ((Stem == "min" || Stem == "max") &&
-         isMangledTypeUnsigned(MangledName.back()))
+        (Desc ? isDescTypeUnsigned(&*Desc->parameters.back()) :
+                isMangledTypeUnsigned(MangledName.back())))
       Sign = 'u';
     Prefix = "fetch_";
     Postfix = "_explicit";
@@ -743,8 +759,8 @@ OCL20ToSPIRV::visitCallAtomicLegacy(CallInst* CI,
 }
 
 void
-OCL20ToSPIRV::visitCallAtomicCpp11(CallInst* CI,
-    StringRef MangledName, const std::string& DemangledName) {
+OCL20ToSPIRV::visitCallAtomicCpp11(CallInst* CI, StringRef MangledName,
+    const SPIR::FunctionDescriptor *Desc, const std::string& DemangledName) {
   StringRef Stem = DemangledName;
   if (Stem.startswith("atomic_"))
     Stem = Stem.drop_front(strlen("atomic_"));
@@ -761,7 +777,8 @@ OCL20ToSPIRV::visitCallAtomicCpp11(CallInst* CI,
       Stem.startswith("flag")) {
     if ((Stem.startswith("fetch_min") ||
         Stem.startswith("fetch_max")) &&
-        containsUnsignedAtomicType(MangledName))
+        (Desc ? hasUnsignedAtomicParam(*Desc) :
+                containsUnsignedAtomicType(MangledName)))
       NewStem.insert(NewStem.begin() + strlen("fetch_"), 'u');
 
     if (!Stem.endswith("_explicit")) {
@@ -1023,7 +1040,6 @@ OCL20ToSPIRV::visitCallPipeBuiltin(CallInst* CI,
 
 void OCL20ToSPIRV::visitCallReadImageMSAA(CallInst *CI, StringRef MangledName,
                                           const std::string &DemangledName) {
-  assert(MangledName.find("msaa") != StringRef::npos);
   auto Attrs = CI->getCalledFunction()->getAttributes();
   mutateCallInstSPIRV(
       M, CI,
@@ -1038,7 +1054,6 @@ void OCL20ToSPIRV::visitCallReadImageMSAA(CallInst *CI, StringRef MangledName,
 
 void OCL20ToSPIRV::visitCallReadImageWithSampler(
     CallInst *CI, StringRef MangledName, const std::string &DemangledName) {
-  assert (MangledName.find(kMangledName::Sampler) != StringRef::npos);
   auto Attrs = CI->getCalledFunction()->getAttributes();
   bool isRetScalar = !CI->getType()->isVectorTy();
   mutateCallInstSPIRV(
@@ -1540,6 +1555,6 @@ INITIALIZE_PASS_DEPENDENCY(OCLTypeToSPIRV)
 INITIALIZE_PASS_END(OCL20ToSPIRV, "cl20tospv", "Transform OCL 2.0 to SPIR-V",
     false, false)
 
-ModulePass *llvm::createOCL20ToSPIRV() {
-  return new OCL20ToSPIRV();
+ModulePass *llvm::createOCL20ToSPIRV(const TranslatorOptions &Opts) {
+  return new OCL20ToSPIRV(Opts);
 }
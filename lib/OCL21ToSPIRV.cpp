@@ -60,7 +60,9 @@ namespace SPIRV {
 class OCL21ToSPIRV: public ModulePass,
   public InstVisitor<OCL21ToSPIRV> {
 public:
-  OCL21ToSPIRV():ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0) {
+  OCL21ToSPIRV(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0), Opts(TheOpts) {
     initializeOCL21ToSPIRVPass(*PassRegistry::getPassRegistry());
   }
   virtual bool runOnModule(Module &M);
@@ -99,6 +101,7 @@ private:
   LLVMContext *Ctx;
   unsigned CLVer;                   /// OpenCL version as major*10+minor
   std::set<Value *> ValuesToDelete;
+  TranslatorOptions Opts;
 };
 
 char OCL21ToSPIRV::ID = 0;
@@ -127,11 +130,7 @@ OCL21ToSPIRV::runOnModule(Module& Module) {
       GV->eraseFromParent();
 
   DEBUG(dbgs() << "After OCL21ToSPIRV:\n" << *M);
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "OCL21ToSPIRV");
   return true;
 }
 
@@ -235,6 +234,6 @@ OCL21ToSPIRV::transBuiltin(CallInst* CI, Op OC) {
 INITIALIZE_PASS(OCL21ToSPIRV, "cl21tospv", "Transform OCL 2.1 to SPIR-V",
     false, false)
 
-ModulePass *llvm::createOCL21ToSPIRV() {
-  return new OCL21ToSPIRV();
+ModulePass *llvm::createOCL21ToSPIRV(const TranslatorOptions &Opts) {
+  return new OCL21ToSPIRV(Opts);
 }
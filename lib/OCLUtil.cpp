@@ -596,3 +596,14 @@ llvm::MangleOpenCLBuiltin(const std::string &UniqName,
   OCLUtil::OCLBuiltinFuncMangleInfo BtnInfo(nullptr);
   MangledName = SPIRV::mangleBuiltin(UniqName, ArgTypes, &BtnInfo);
 }
+
+bool
+llvm::DemangleOpenCLBuiltin(const std::string &MangledName,
+    std::string &Signature, std::string &Remangled) {
+  SPIR::FunctionDescriptor FD;
+  if (SPIR::demangle(MangledName, FD) != SPIR::MANGLE_SUCCESS)
+    return false;
+  Signature = FD.toString();
+  return SPIR::NameMangler(SPIR::SPIR20).mangle(FD, Remangled) ==
+      SPIR::MANGLE_SUCCESS;
+}
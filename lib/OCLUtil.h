@@ -36,6 +36,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "SPIRVInternal.h"
+#include "libSPIRV/SPIRVExtInst.h"
 
 #include <utility>
 #include <tuple>
@@ -114,6 +115,13 @@ class OCLOpaqueType;
 typedef SPIRVMap<std::string, Op, OCLOpaqueType>
   OCLOpaqueTypeOpCodeMap;
 
+/// LLVM intrinsics translated to OpenCL.std extended instructions. The
+/// intrinsics are overloaded on their return type only and take the same
+/// operands as the extended instructions, except for the is_zero_undef flag
+/// of llvm.ctlz and llvm.cttz.
+typedef SPIRVMap<Intrinsic::ID, OCLExtOpKind>
+  LLVMIntrinsicOCLExtOpMap;
+
 /// Information for translating OCL builtin.
 struct OCLBuiltinTransInfo {
   std::string UniqName;
@@ -618,6 +626,32 @@ _SPIRV_OP(intel_sub_group_shuffle_xor, SubgroupShuffleXorINTEL)
 #undef _SPIRV_OP
 }
 
+template<> inline void
+SPIRVMap<Intrinsic::ID, OCLExtOpKind>::init() {
+  add(Intrinsic::ceil, OpenCLLIB::Ceil);
+  add(Intrinsic::copysign, OpenCLLIB::Copysign);
+  add(Intrinsic::cos, OpenCLLIB::Cos);
+  add(Intrinsic::ctlz, OpenCLLIB::Clz);
+  add(Intrinsic::ctpop, OpenCLLIB::Popcount);
+  add(Intrinsic::cttz, OpenCLLIB::Ctz);
+  add(Intrinsic::exp, OpenCLLIB::Exp);
+  add(Intrinsic::exp2, OpenCLLIB::Exp2);
+  add(Intrinsic::fabs, OpenCLLIB::Fabs);
+  add(Intrinsic::floor, OpenCLLIB::Floor);
+  add(Intrinsic::fma, OpenCLLIB::Fma);
+  add(Intrinsic::log, OpenCLLIB::Log);
+  add(Intrinsic::log10, OpenCLLIB::Log10);
+  add(Intrinsic::log2, OpenCLLIB::Log2);
+  add(Intrinsic::maxnum, OpenCLLIB::Fmax);
+  add(Intrinsic::minnum, OpenCLLIB::Fmin);
+  add(Intrinsic::pow, OpenCLLIB::Pow);
+  add(Intrinsic::rint, OpenCLLIB::Rint);
+  add(Intrinsic::round, OpenCLLIB::Round);
+  add(Intrinsic::sin, OpenCLLIB::Sin);
+  add(Intrinsic::sqrt, OpenCLLIB::Sqrt);
+  add(Intrinsic::trunc, OpenCLLIB::Trunc);
+}
+
 template<> inline void
 SPIRVMap<std::string, Op, OCLOpaqueType>::init() {
   add("opencl.event_t", OpTypeEvent);
@@ -0,0 +1,557 @@
+//===- SPIRVFunctionCache.cpp - Cached function bodies --------------------===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file implements the encoding of the translated function bodies which
+// the LLVM to SPIR-V writer stores in the translation cache, and the keys by
+// which they refer to the module scope entities.
+//
+//===----------------------------------------------------------------------===//
+#include "SPIRVFunctionCache.h"
+
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstring>
+
+using namespace llvm;
+
+namespace SPIRV {
+
+// The SPIR-V of a function body is stored in the translation cache with
+// the ids it references replaced by symbols. The symbols are numbered from
+// the ids defined by the function, followed by keys of the module scope
+// entities, which are used to find them again in the module the function
+// is reused in. A key is one of
+//   t<type>          the translation of a type
+//   <value>          the translation of a constant or a global value
+//   a<n>.            the parameter number n of the function
+//   l<hex>.          a 32-bit integer constant created by SPIRVModule
+//   x                the OpenCL.std extended instruction set
+//   m                the zero pool copied from by llvm.memset
+// with the types and values written by writeFunctionCacheKey.
+static const SPIRVWord FunctionCacheMagic = 0x43465053;
+
+
+bool
+writeFunctionCacheKey(raw_ostream &OS, Type *T) {
+  switch (T->getTypeID()) {
+  case Type::VoidTyID:
+    OS << 'v';
+    return true;
+  case Type::HalfTyID:
+    OS << 'h';
+    return true;
+  case Type::FloatTyID:
+    OS << 'f';
+    return true;
+  case Type::DoubleTyID:
+    OS << 'd';
+    return true;
+  case Type::IntegerTyID:
+    OS << 'i' << T->getIntegerBitWidth() << '.';
+    return true;
+  case Type::VectorTyID:
+    OS << 'V' << T->getVectorNumElements() << '.';
+    return writeFunctionCacheKey(OS, T->getVectorElementType());
+  case Type::ArrayTyID:
+    OS << 'A' << T->getArrayNumElements() << '.';
+    return writeFunctionCacheKey(OS, T->getArrayElementType());
+  case Type::PointerTyID:
+    OS << 'P' << T->getPointerAddressSpace() << '.';
+    return writeFunctionCacheKey(OS, T->getPointerElementType());
+  case Type::FunctionTyID: {
+    auto FT = cast<FunctionType>(T);
+    OS << 'F' << FT->getNumParams() << '.' << FT->isVarArg();
+    if (!writeFunctionCacheKey(OS, FT->getReturnType()))
+      return false;
+    for (auto PT : FT->params())
+      if (!writeFunctionCacheKey(OS, PT))
+        return false;
+    return true;
+  }
+  case Type::StructTyID: {
+    auto ST = cast<StructType>(T);
+    if (ST->hasName()) {
+      OS << 'S' << ST->getName().size() << '.' << ST->getName();
+      return true;
+    }
+    if (ST->isOpaque())
+      return false;
+    OS << 'L' << ST->getNumElements() << '.' << ST->isPacked();
+    for (auto ET : ST->elements())
+      if (!writeFunctionCacheKey(OS, ET))
+        return false;
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+bool
+writeFunctionCacheKey(raw_ostream &OS, Value *V) {
+  if (auto GV = dyn_cast<GlobalValue>(V)) {
+    if (!GV->hasName())
+      return false;
+    OS << 'g' << GV->getName().size() << '.' << GV->getName();
+    return writeFunctionCacheKey(OS, GV->getType());
+  }
+  if (isa<UndefValue>(V) || isa<ConstantPointerNull>(V) ||
+      isa<ConstantAggregateZero>(V)) {
+    OS << (isa<UndefValue>(V) ? 'u' : isa<ConstantPointerNull>(V) ? 'n' : 'z');
+    return writeFunctionCacheKey(OS, V->getType());
+  }
+  if (auto CI = dyn_cast<ConstantInt>(V)) {
+    OS << 'k';
+    if (!writeFunctionCacheKey(OS, V->getType()))
+      return false;
+    OS << CI->getValue().toString(16, false) << '.';
+    return true;
+  }
+  if (auto CF = dyn_cast<ConstantFP>(V)) {
+    OS << 'q';
+    if (!writeFunctionCacheKey(OS, V->getType()))
+      return false;
+    OS << CF->getValueAPF().bitcastToAPInt().toString(16, false) << '.';
+    return true;
+  }
+  if (isa<ConstantAggregate>(V) || isa<ConstantDataSequential>(V)) {
+    auto C = cast<Constant>(V);
+    unsigned N = isa<ConstantDataSequential>(C) ?
+        cast<ConstantDataSequential>(C)->getNumElements() :
+        C->getNumOperands();
+    OS << 'e' << N << '.';
+    if (!writeFunctionCacheKey(OS, V->getType()))
+      return false;
+    for (unsigned I = 0; I < N; ++I)
+      if (!writeFunctionCacheKey(OS, C->getAggregateElement(I)))
+        return false;
+    return true;
+  }
+  return false;
+}
+
+namespace {
+/// Parser of the keys of the module scope entities. It finds the types and
+/// values in the module without translating them.
+class FunctionCacheKeyParser {
+public:
+  FunctionCacheKeyParser(Function *F, StringRef Key)
+    :F(F), M(F->getParent()), Ctx(F->getContext()), Key(Key) {}
+
+  bool parse(FunctionCacheSymbol &Sym) {
+    if (Key.empty())
+      return false;
+    Sym.Kind = Key.front();
+    switch (Sym.Kind) {
+    case 'x':
+    case 'm':
+      Key = Key.drop_front();
+      break;
+    case 't':
+      Key = Key.drop_front();
+      Sym.Ty = parseType();
+      if (!Sym.Ty)
+        return false;
+      break;
+    case 'a':
+      Key = Key.drop_front();
+      if (!parseNumber(Sym.Literal) || Sym.Literal >= F->arg_size())
+        return false;
+      break;
+    case 'l': {
+      Key = Key.drop_front();
+      APInt Val;
+      if (!parseHex(32, Val))
+        return false;
+      Sym.Literal = Val.getZExtValue();
+      break;
+    }
+    default:
+      Sym.Kind = 'v';
+      Sym.V = parseValue();
+      if (!Sym.V)
+        return false;
+    }
+    return Key.empty();
+  }
+
+private:
+  Function *F;
+  Module *M;
+  LLVMContext &Ctx;
+  StringRef Key;
+
+  bool consume(char C) {
+    if (Key.empty() || Key.front() != C)
+      return false;
+    Key = Key.drop_front();
+    return true;
+  }
+
+  // <decimal>.
+  bool parseNumber(uint64_t &N) {
+    size_t Pos = Key.find('.');
+    if (Pos == StringRef::npos || Key.substr(0, Pos).getAsInteger(10, N))
+      return false;
+    Key = Key.drop_front(Pos + 1);
+    return true;
+  }
+
+  // <hex>.
+  bool parseHex(unsigned BitWidth, APInt &Val) {
+    size_t Pos = Key.find('.');
+    if (Pos == StringRef::npos || Key.substr(0, Pos).getAsInteger(16, Val) ||
+        Val.getActiveBits() > BitWidth)
+      return false;
+    Val = Val.zextOrTrunc(BitWidth);
+    Key = Key.drop_front(Pos + 1);
+    return true;
+  }
+
+  // <length>.<name>
+  bool parseName(StringRef &Name) {
+    uint64_t Len;
+    if (!parseNumber(Len) || Len > Key.size())
+      return false;
+    Name = Key.take_front(Len);
+    Key = Key.drop_front(Len);
+    return true;
+  }
+
+  Type *parseType() {
+    if (Key.empty())
+      return nullptr;
+    char C = Key.front();
+    Key = Key.drop_front();
+    uint64_t N;
+    switch (C) {
+    case 'v':
+      return Type::getVoidTy(Ctx);
+    case 'h':
+      return Type::getHalfTy(Ctx);
+    case 'f':
+      return Type::getFloatTy(Ctx);
+    case 'd':
+      return Type::getDoubleTy(Ctx);
+    case 'i':
+      if (!parseNumber(N) || N < IntegerType::MIN_INT_BITS ||
+          N > IntegerType::MAX_INT_BITS)
+        return nullptr;
+      return IntegerType::get(Ctx, N);
+    case 'V': {
+      if (!parseNumber(N) || N == 0 || N > ~0U)
+        return nullptr;
+      Type *ET = parseType();
+      if (!ET || !VectorType::isValidElementType(ET))
+        return nullptr;
+      return VectorType::get(ET, N);
+    }
+    case 'A': {
+      if (!parseNumber(N))
+        return nullptr;
+      Type *ET = parseType();
+      if (!ET || !ArrayType::isValidElementType(ET))
+        return nullptr;
+      return ArrayType::get(ET, N);
+    }
+    case 'P': {
+      if (!parseNumber(N) || N > ~0U)
+        return nullptr;
+      Type *ET = parseType();
+      if (!ET || !PointerType::isValidElementType(ET))
+        return nullptr;
+      return PointerType::get(ET, N);
+    }
+    case 'F': {
+      if (!parseNumber(N))
+        return nullptr;
+      bool VarArg = consume('1');
+      if (!VarArg && !consume('0'))
+        return nullptr;
+      Type *RT = parseType();
+      if (!RT || !FunctionType::isValidReturnType(RT))
+        return nullptr;
+      std::vector<Type *> Params;
+      for (uint64_t I = 0; I < N; ++I) {
+        Type *PT = parseType();
+        if (!PT || !FunctionType::isValidArgumentType(PT))
+          return nullptr;
+        Params.push_back(PT);
+      }
+      return FunctionType::get(RT, Params, VarArg);
+    }
+    case 'S': {
+      StringRef Name;
+      if (!parseName(Name))
+        return nullptr;
+      return M->getTypeByName(Name);
+    }
+    case 'L': {
+      if (!parseNumber(N))
+        return nullptr;
+      bool Packed = consume('1');
+      if (!Packed && !consume('0'))
+        return nullptr;
+      std::vector<Type *> Elems;
+      for (uint64_t I = 0; I < N; ++I) {
+        Type *ET = parseType();
+        if (!ET || !StructType::isValidElementType(ET))
+          return nullptr;
+        Elems.push_back(ET);
+      }
+      return StructType::get(Ctx, Elems, Packed);
+    }
+    default:
+      return nullptr;
+    }
+  }
+
+  Constant *parseValue() {
+    if (Key.empty())
+      return nullptr;
+    char C = Key.front();
+    Key = Key.drop_front();
+    switch (C) {
+    case 'g': {
+      StringRef Name;
+      if (!parseName(Name))
+        return nullptr;
+      Type *T = parseType();
+      GlobalValue *GV = M->getNamedValue(Name);
+      if (!T || !GV || GV->getType() != T)
+        return nullptr;
+      return GV;
+    }
+    case 'u':
+    case 'n':
+    case 'z': {
+      Type *T = parseType();
+      if (!T)
+        return nullptr;
+      if (C == 'u')
+        return T->isFirstClassType() && !T->isVoidTy() ?
+            UndefValue::get(T) : nullptr;
+      if (C == 'n')
+        return T->isPointerTy() ?
+            ConstantPointerNull::get(cast<PointerType>(T)) : nullptr;
+      return T->isAggregateType() || T->isVectorTy() ?
+          ConstantAggregateZero::get(T) : nullptr;
+    }
+    case 'k': {
+      auto T = dyn_cast_or_null<IntegerType>(parseType());
+      APInt Val;
+      if (!T || !parseHex(T->getBitWidth(), Val))
+        return nullptr;
+      return ConstantInt::get(Ctx, Val);
+    }
+    case 'q': {
+      Type *T = parseType();
+      APInt Bits;
+      if (!T || !T->isFloatingPointTy() ||
+          !parseHex(T->getPrimitiveSizeInBits(), Bits))
+        return nullptr;
+      return ConstantFP::get(Ctx, APFloat(T->getFltSemantics(), Bits));
+    }
+    case 'e': {
+      uint64_t N;
+      if (!parseNumber(N))
+        return nullptr;
+      Type *T = parseType();
+      if (!T || !(T->isAggregateType() || T->isVectorTy()))
+        return nullptr;
+      std::vector<Constant *> Elems;
+      for (uint64_t I = 0; I < N; ++I) {
+        Constant *E = parseValue();
+        Type *ET = T->isStructTy() ?
+            (I < T->getStructNumElements() ?
+             T->getStructElementType(I) : nullptr) :
+            T->getSequentialElementType();
+        if (!E || E->getType() != ET)
+          return nullptr;
+        Elems.push_back(E);
+      }
+      if (auto ST = dyn_cast<StructType>(T))
+        return N == ST->getNumElements() ? ConstantStruct::get(ST, Elems) :
+            nullptr;
+      if (auto AT = dyn_cast<ArrayType>(T))
+        return N == AT->getNumElements() ? ConstantArray::get(AT, Elems) :
+            nullptr;
+      return N == T->getVectorNumElements() ? ConstantVector::get(Elems) :
+          nullptr;
+    }
+    default:
+      return nullptr;
+    }
+  }
+};
+
+/// Reader of a function in the translation cache, which is a sequence of
+/// words written by LLVMToSPIRV::encodeCachedFunction.
+class FunctionCacheEntryReader {
+public:
+  FunctionCacheEntryReader(ArrayRef<SPIRVWord> Words)
+    :Words(Words), Pos(0) {}
+  bool atEnd() const { return Pos == Words.size();}
+  bool read(SPIRVWord &W) {
+    if (Pos == Words.size())
+      return false;
+    W = Words[Pos++];
+    return true;
+  }
+  bool read(ArrayRef<SPIRVWord> &Array) {
+    SPIRVWord N;
+    if (!read(N) || N > Words.size() - Pos)
+      return false;
+    Array = Words.slice(Pos, N);
+    Pos += N;
+    return true;
+  }
+  bool read(std::string &S) {
+    SPIRVWord Len;
+    if (!read(Len) || (uint64_t(Len) + sizeof(SPIRVWord) - 1) /
+        sizeof(SPIRVWord) > Words.size() - Pos)
+      return false;
+    S.assign(reinterpret_cast<const char *>(Words.data() + Pos), Len);
+    Pos += (Len + sizeof(SPIRVWord) - 1) / sizeof(SPIRVWord);
+    return true;
+  }
+
+private:
+  ArrayRef<SPIRVWord> Words;
+  size_t Pos;
+};
+} // anonymous namespace
+
+static void
+appendFunctionCacheString(std::vector<SPIRVWord> &Words, StringRef S) {
+  Words.push_back(S.size());
+  size_t Begin = Words.size();
+  Words.resize(Begin + (S.size() + sizeof(SPIRVWord) - 1) /
+      sizeof(SPIRVWord));
+  if (!S.empty())
+    memcpy(&Words[Begin], S.data(), S.size());
+}
+
+bool
+parseFunctionCacheKey(Function *F, StringRef Key, FunctionCacheSymbol &Sym) {
+  return FunctionCacheKeyParser(F, Key).parse(Sym);
+}
+
+void
+FunctionCacheEntry::encode(std::string &Entry) const {
+  std::vector<SPIRVWord> Words;
+  Words.push_back(FunctionCacheMagic);
+  Words.push_back(NumLocals);
+  Words.push_back(Externs.size());
+  for (auto &Key : Externs)
+    appendFunctionCacheString(Words, Key);
+  Words.push_back(Code.size());
+  Words.insert(Words.end(), Code.begin(), Code.end());
+  Words.push_back(IdWords.size());
+  Words.insert(Words.end(), IdWords.begin(), IdWords.end());
+  Words.push_back(Names.size());
+  for (auto &I : Names) {
+    Words.push_back(I.first);
+    appendFunctionCacheString(Words, I.second);
+  }
+  Words.push_back(Decorates.size());
+  for (auto &I : Decorates) {
+    Words.push_back(I.first);
+    Words.push_back(I.second.size());
+    Words.insert(Words.end(), I.second.begin(), I.second.end());
+  }
+  Entry.assign(reinterpret_cast<const char *>(Words.data()),
+      Words.size() * sizeof(SPIRVWord));
+}
+
+bool
+FunctionCacheEntry::decode(StringRef Entry) {
+  if (Entry.size() % sizeof(SPIRVWord))
+    return false;
+  std::vector<SPIRVWord> Data(Entry.size() / sizeof(SPIRVWord));
+  if (!Data.empty())
+    memcpy(Data.data(), Entry.data(), Entry.size());
+  FunctionCacheEntryReader R(Data);
+  SPIRVWord Magic, NumExterns;
+  if (!R.read(Magic) || Magic != FunctionCacheMagic ||
+      !R.read(NumLocals) || NumLocals == 0 || !R.read(NumExterns) ||
+      NumExterns > Data.size())
+    return false;
+  Externs.resize(NumExterns);
+  for (auto &Key : Externs)
+    if (!R.read(Key))
+      return false;
+  uint64_t NumSymbols = uint64_t(NumLocals) + NumExterns;
+  ArrayRef<SPIRVWord> CodeWords, Positions;
+  if (!R.read(CodeWords) || NumLocals > CodeWords.size() ||
+      !R.read(Positions))
+    return false;
+  for (auto Pos : Positions)
+    if (Pos >= CodeWords.size() || CodeWords[Pos] >= NumSymbols)
+      return false;
+  Code = CodeWords.vec();
+  IdWords = Positions.vec();
+  SPIRVWord NumNames, NumDecorates;
+  Names.clear();
+  if (!R.read(NumNames))
+    return false;
+  for (SPIRVWord I = 0; I < NumNames; ++I) {
+    SPIRVWord Sym;
+    std::string Name;
+    if (!R.read(Sym) || Sym >= NumLocals || !R.read(Name))
+      return false;
+    Names.push_back(std::make_pair(Sym, Name));
+  }
+  Decorates.clear();
+  if (!R.read(NumDecorates))
+    return false;
+  for (SPIRVWord I = 0; I < NumDecorates; ++I) {
+    SPIRVWord Sym;
+    ArrayRef<SPIRVWord> Dec;
+    if (!R.read(Sym) || Sym >= NumLocals || !R.read(Dec) || Dec.empty() ||
+        Dec.size() > 2)
+      return false;
+    Decorates.push_back(std::make_pair(Sym, Dec.vec()));
+  }
+  return R.atEnd();
+}
+
+} // namespace SPIRV
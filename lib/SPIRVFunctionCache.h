@@ -0,0 +1,114 @@
+//===- SPIRVFunctionCache.h - Cached function bodies ------------*- C++ -*-===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file declares the encoding of the translated function bodies which
+// the LLVM to SPIR-V writer stores in the translation cache.
+//
+//===----------------------------------------------------------------------===//
+#ifndef LIB_SPIRV_SPIRVFUNCTIONCACHE_H_
+#define LIB_SPIRV_SPIRVFUNCTIONCACHE_H_
+
+#include "libSPIRV/SPIRVEnum.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class Function;
+class Type;
+class Value;
+class raw_ostream;
+}
+
+namespace SPIRV {
+
+/// Write the key by which a function in the translation cache refers to the
+/// translation of \p T.
+/// \returns false if \p T has no key.
+bool
+writeFunctionCacheKey(llvm::raw_ostream &OS, llvm::Type *T);
+
+/// Write the key by which a function in the translation cache refers to the
+/// translation of the constant or global value \p V.
+/// \returns false if \p V has no key.
+bool
+writeFunctionCacheKey(llvm::raw_ostream &OS, llvm::Value *V);
+
+/// Module scope entity referenced by the SPIR-V of a function in the
+/// translation cache.
+struct FunctionCacheSymbol {
+  char Kind;
+  llvm::Type *Ty;
+  llvm::Value *V;
+  uint64_t Literal;
+  FunctionCacheSymbol()
+    :Kind(0), Ty(nullptr), V(nullptr), Literal(0) {}
+};
+
+/// Find the entity with the key \p Key in the module of \p F, without
+/// translating it.
+/// \returns false if the key is malformed or the entity does not exist.
+bool
+parseFunctionCacheKey(llvm::Function *F, llvm::StringRef Key,
+    FunctionCacheSymbol &Sym);
+
+/// The SPIR-V of a function body as stored in the translation cache. The ids
+/// are replaced by symbols, numbered from the ids defined by the function
+/// followed by the module scope entities it references.
+struct FunctionCacheEntry {
+  /// Number of ids defined by the function.
+  SPIRVWord NumLocals;
+  /// Keys of the referenced module scope entities.
+  std::vector<std::string> Externs;
+  /// Basic blocks encoded by SPIRVFunction::encodeBasicBlocks.
+  std::vector<SPIRVWord> Code;
+  /// Positions of the symbols in Code.
+  std::vector<SPIRVWord> IdWords;
+  /// Names of the symbols of the function.
+  std::vector<std::pair<SPIRVWord, std::string>> Names;
+  /// Decorations of the symbols of the function: the decoration kind
+  /// followed by at most one literal.
+  std::vector<std::pair<SPIRVWord, std::vector<SPIRVWord>>> Decorates;
+
+  FunctionCacheEntry():NumLocals(0) {}
+
+  void encode(std::string &Entry) const;
+  /// \returns false if \p Entry is malformed.
+  bool decode(llvm::StringRef Entry);
+};
+
+} // namespace SPIRV
+
+#endif /* LIB_SPIRV_SPIRVFUNCTIONCACHE_H_ */
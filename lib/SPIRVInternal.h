@@ -49,8 +49,12 @@
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/IRBuilder.h"
 #include "SPIRV.h"
 
+#include <list>
+#include <map>
 #include <utility>
 #include <functional>
 
@@ -62,7 +66,46 @@ namespace SPIRV{
   /// The LLVM/SPIR-V translator version used to fill the lower 16 bits of the
   /// generator's magic number in the generated SPIR-V module.
   /// This number should be bumped up whenever the generated SPIR-V changes.
-  const static unsigned short kTranslatorVer = 14;
+  const static unsigned short kTranslatorVer = 16;
+
+/// Get the default translator options for updating by command line options.
+TranslatorOptions &getMutableDefaultTranslatorOptions();
+
+/// Verify module \p M after \p Stage if the verification policy of \p Opts
+/// is \p When or a later stage. Failures are reported in \p ErrMsg, or are
+/// fatal errors if \p ErrMsg is null, as passes can not return an error.
+/// The time spent is reported in the SPIR-V translator timer group if
+/// -time-passes is on.
+/// \returns false if the module is verified and found broken.
+bool verifyTranslatedModule(Module &M, const TranslatorOptions &Opts,
+    VerifyPolicyKind When, StringRef Stage, std::string *ErrMsg = nullptr);
+
+/// On-disk cache of translation results shared by processes. An entry is
+/// keyed on a SHA-1 hash of the kind of translation, the translator version,
+/// the options affecting the result and the input bytes. Entries are written
+/// to a temporary file which is then renamed, and the least recently used
+/// ones are removed when the cache grows larger than the size limit.
+class SPIRVTranslationCache {
+public:
+  /// The cache is disabled if the cache directory of \p Opts is empty.
+  SPIRVTranslationCache(const TranslatorOptions &Opts, StringRef Kind,
+      StringRef Input);
+  bool isEnabled() const { return !Dir.empty();}
+  /// Look up the entry and pass it to \p Use, which returns false if it can
+  /// not use the entry. Only an entry which is used counts as a hit.
+  /// \returns true if the entry is found and used.
+  bool lookup(std::function<bool(StringRef Entry)> Use);
+  /// Store \p Result, then prune the cache if \p Prune is set.
+  void store(StringRef Result, bool Prune = true);
+  /// Remove the least recently used entries while the cache is larger than
+  /// its size limit.
+  void prune();
+
+private:
+  std::string Dir;
+  uint64_t MaxSize;
+  std::string Path;
+};
 
 #define SPCV_TARGET_LLVM_IMAGE_TYPE_ENCODE_ACCESS_QUAL 0
 // Workaround for SPIR 2 producer bug about kernel function calling convention.
@@ -231,6 +274,8 @@ SPIRVMap<Attribute::AttrKind, SPIRVFuncParamAttrKind>::init() {
   add(Attribute::StructRet, FunctionParameterAttributeSret);
   add(Attribute::NoAlias, FunctionParameterAttributeNoAlias);
   add(Attribute::NoCapture, FunctionParameterAttributeNoCapture);
+  add(Attribute::ReadOnly, FunctionParameterAttributeNoWrite);
+  add(Attribute::ReadNone, FunctionParameterAttributeNoReadWrite);
 }
 typedef SPIRVMap<Attribute::AttrKind, SPIRVFuncParamAttrKind>
   SPIRSPIRVFuncParamAttrMap;
@@ -901,10 +946,51 @@ ParamType LastFuncParamType(const std::string& MangledName);
 bool
 isLastFuncParamSigned(const std::string& MangledName);
 
-// Check if a mangled function name contains unsigned atomic type
+/// Get the primitive type of a demangled parameter type, looking through
+/// pointers, vectors and atomics.
+/// \returns PRIMITIVE_NONE for other types.
+SPIR::TypePrimitiveEnum
+getDescBasePrimitive(const SPIR::ParamType *T);
+
+// Check if a demangled parameter type is unsigned, or a pointer to or vector
+// of an unsigned type
+bool
+isDescTypeUnsigned(const SPIR::ParamType *T);
+
+// Check if a demangled builtin has a parameter whose base primitive type
+// satisfies \param Pred
+bool
+hasParamOfPrimitive(const SPIR::FunctionDescriptor &Desc,
+    std::function<bool(SPIR::TypePrimitiveEnum)> Pred);
+
+// Check if a demangled builtin has an unsigned atomic parameter, or a pointer
+// to one
+bool
+hasUnsignedAtomicParam(const SPIR::FunctionDescriptor &Desc);
+
+// Check if a mangled function name contains unsigned atomic type. Used for
+// the names SPIR::demangle can not parse.
 bool
 containsUnsignedAtomicType(StringRef Name);
 
+/// Demangled OpenCL builtin functions, cached per function so that the
+/// parameter types of a builtin are parsed once however many calls to it are
+/// translated. An entry is parsed again if the function has been renamed.
+class OCLBuiltinDescCache {
+public:
+  /// \returns the descriptor of \param F, or nullptr if its name can not be
+  /// demangled.
+  const SPIR::FunctionDescriptor *get(Function *F);
+  void clear() { Descs.clear();}
+private:
+  struct Entry {
+    std::string MangledName;
+    bool IsValid = false;
+    SPIR::FunctionDescriptor Desc;
+  };
+  std::map<Function *, Entry> Descs;
+};
+
 /// Mangle builtin function name.
 /// \return \param UniqName if \param BtnInfo is null pointer, otherwise
 ///    return IA64 mangled name.
@@ -927,6 +1013,43 @@ PointerType *getInt8PtrTy(PointerType *T);
 Value *
 castToInt8Ptr(Value *V, Instruction *Pos);
 
+/// Lower constant expressions used by \p I to instructions placed at the
+/// beginning of the entry block of its function, replacing all uses of them
+/// in that function. The new instructions are pushed to the front of
+/// \p WorkList so that their own operands are lowered as well.
+void
+lowerConstantExprOperands(Instruction *I, std::list<Instruction *> &WorkList);
+
+/// Lower trunc to i1 and zext/sext from i1 to icmp/select instructions.
+/// \returns true if \p I is replaced and erased.
+bool
+lowerBoolCast(Instruction *I);
+
+/// Lower llvm.memmove to llvm.memcpy if its source and destination do not
+/// overlap, otherwise to a copy loop running forward or backward depending on
+/// which of them comes first.
+void
+lowerMemMove(MemMoveInst *I);
+
+/// Emit a loop running \p Body for each index in [\p Begin, \p End) at the
+/// insertion point of \p Builder, which is moved past the loop. The indices
+/// are visited in increasing order, or in decreasing order if \p Reverse.
+/// The blocks of the loop are named after \p Name.
+void
+createIndexLoop(IRBuilder<> &Builder, Value *Begin, Value *End, bool Reverse,
+    StringRef Name, std::function<void(Value *)> Body);
+
+/// Check if llvm.memset \p I sets a constant number of bytes, at most
+/// \p MaxSize, to zero. Such a memset is not lowered but translated to a copy
+/// from a zero-initialized constant.
+bool
+isZeroPoolMemSet(MemSetInst *I, uint64_t MaxSize);
+
+/// Lower llvm.memset to stores, in a loop unless its length is a small
+/// constant.
+void
+lowerMemSet(MemSetInst *I);
+
 template<> inline void
 SPIRVMap<std::string, Op, SPIRVOpaqueType>::init() {
   add(kSPIRVTypeName::DeviceEvent, OpTypeDeviceEvent);
@@ -52,61 +52,32 @@ using namespace llvm;
 using namespace SPIRV;
 
 namespace SPIRV {
-cl::opt<bool> SPIRVLowerBoolValidate("spvbool-validate",
-    cl::desc("Validate module after lowering boolean instructions for SPIR-V"));
+cl::opt<bool, true> SPIRVLowerBoolValidate("spvbool-validate",
+    cl::desc("Validate module after lowering boolean instructions for SPIR-V"),
+    cl::location(getMutableDefaultTranslatorOptions().LowerBoolValidate));
 
 class SPIRVLowerBool: public ModulePass,
   public InstVisitor<SPIRVLowerBool> {
 public:
-  SPIRVLowerBool():ModulePass(ID), Context(nullptr) {
+  SPIRVLowerBool(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), Context(nullptr), Opts(TheOpts) {
     initializeSPIRVLowerBoolPass(*PassRegistry::getPassRegistry());
   }
-  void replace(Instruction *I, Instruction *NewI) {
-    NewI->takeName(I);
-    I->replaceAllUsesWith(NewI);
-    I->dropAllReferences();
-    I->eraseFromParent();
-  }
-  bool isBoolType(Type *Ty) {
-    if (Ty->isIntegerTy(1))
-      return true;
-    if (auto VT = dyn_cast<VectorType>(Ty))
-      return isBoolType(VT->getElementType());
-    return false;
-  }
   virtual void visitTruncInst(TruncInst &I) {
-    if (isBoolType(I.getType())) {
-      auto Op = I.getOperand(0);
-      auto Zero = getScalarOrVectorConstantInt(Op->getType(), 0, false);
-      auto Cmp = new ICmpInst(&I, CmpInst::ICMP_NE, Op, Zero);
-      replace(&I, Cmp);
-    }
+    lowerBoolCast(&I);
   }
   virtual void visitZExtInst(ZExtInst &I) {
-    auto Op = I.getOperand(0);
-    if (isBoolType(Op->getType())) {
-      auto Ty = I.getType();
-      auto Zero = getScalarOrVectorConstantInt(Ty, 0, false);
-      auto One = getScalarOrVectorConstantInt(Ty, 1, false);
-      auto Sel = SelectInst::Create(Op, One, Zero, "", &I);
-      replace(&I, Sel);
-    }
+    lowerBoolCast(&I);
   }
   virtual void visitSExtInst(SExtInst &I) {
-    auto Op = I.getOperand(0);
-    if (isBoolType(Op->getType())) {
-      auto Ty = I.getType();
-      auto Zero = getScalarOrVectorConstantInt(Ty, 0, false);
-      auto One = getScalarOrVectorConstantInt(Ty, ~0, false);
-      auto Sel = SelectInst::Create(Op, One, Zero, "", &I);
-      replace(&I, Sel);
-    }
+    lowerBoolCast(&I);
   }
   virtual bool runOnModule(Module &M) {
     Context = &M.getContext();
     visit(M);
 
-    if (SPIRVLowerBoolValidate) {
+    if (Opts.LowerBoolValidate) {
       DEBUG(dbgs() << "After SPIRVLowerBool:\n" << M);
       std::string Err;
       raw_string_ostream ErrorOS(Err);
@@ -121,14 +92,58 @@ public:
   static char ID;
 private:
   LLVMContext *Context;
+  TranslatorOptions Opts;
 };
 
 char SPIRVLowerBool::ID = 0;
+
+static bool
+isBoolType(Type *Ty) {
+  if (Ty->isIntegerTy(1))
+    return true;
+  if (auto VT = dyn_cast<VectorType>(Ty))
+    return isBoolType(VT->getElementType());
+  return false;
+}
+
+static void
+replace(Instruction *I, Instruction *NewI) {
+  NewI->takeName(I);
+  I->replaceAllUsesWith(NewI);
+  I->dropAllReferences();
+  I->eraseFromParent();
+}
+
+bool
+lowerBoolCast(Instruction *I) {
+  if (isa<TruncInst>(I)) {
+    if (!isBoolType(I->getType()))
+      return false;
+    auto Op = I->getOperand(0);
+    auto Zero = getScalarOrVectorConstantInt(Op->getType(), 0, false);
+    auto Cmp = new ICmpInst(I, CmpInst::ICMP_NE, Op, Zero);
+    replace(I, Cmp);
+    return true;
+  }
+  if (isa<ZExtInst>(I) || isa<SExtInst>(I)) {
+    auto Op = I->getOperand(0);
+    if (!isBoolType(Op->getType()))
+      return false;
+    auto Ty = I->getType();
+    auto Zero = getScalarOrVectorConstantInt(Ty, 0, false);
+    auto One = getScalarOrVectorConstantInt(Ty, isa<ZExtInst>(I) ? 1 : ~0,
+        false);
+    auto Sel = SelectInst::Create(Op, One, Zero, "", I);
+    replace(I, Sel);
+    return true;
+  }
+  return false;
+}
 }
 
 INITIALIZE_PASS(SPIRVLowerBool, "spvbool",
     "Lower instructions with bool operands", false, false)
 
-ModulePass *llvm::createSPIRVLowerBool() {
-  return new SPIRVLowerBool();
+ModulePass *llvm::createSPIRVLowerBool(const TranslatorOptions &Opts) {
+  return new SPIRVLowerBool(Opts);
 }
@@ -63,12 +63,15 @@ using namespace OCLUtil;
 
 namespace SPIRV {
 
-cl::opt<bool> SPIRVLowerConst("spirv-lower-const-expr", cl::init(true),
-    cl::desc("LLVM/SPIR-V translation enalbe lowering constant expression"));
+cl::opt<bool, true> SPIRVLowerConst("spirv-lower-const-expr",
+    cl::desc("LLVM/SPIR-V translation enalbe lowering constant expression"),
+    cl::location(getMutableDefaultTranslatorOptions().LowerConstExpr));
 
 class SPIRVLowerConstExpr: public ModulePass {
 public:
-  SPIRVLowerConstExpr():ModulePass(ID), M(nullptr), Ctx(nullptr) {
+  SPIRVLowerConstExpr(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), Opts(TheOpts) {
     initializeSPIRVLowerConstExprPass(*PassRegistry::getPassRegistry());
   }
 
@@ -79,13 +82,14 @@ public:
 private:
   Module *M;
   LLVMContext *Ctx;
+  TranslatorOptions Opts;
 };
 
 char SPIRVLowerConstExpr::ID = 0;
 
 bool
 SPIRVLowerConstExpr::runOnModule(Module& Module) {
-  if (!SPIRVLowerConst)
+  if (!Opts.LowerConstExpr)
     return false;
 
   M = &Module;
@@ -95,11 +99,7 @@ SPIRVLowerConstExpr::runOnModule(Module& Module) {
   visit(M);
 
   DEBUG(dbgs() << "After SPIRVLowerConstExpr:\n" << *M);
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "SPIRVLowerConstExpr");
   return true;
 }
 
@@ -115,10 +115,8 @@ SPIRVLowerConstExpr::runOnModule(Module& Module) {
 void
 SPIRVLowerConstExpr::visit(Module *M) {
     for (auto I = M->begin(), E = M->end(); I != E; ++I) {
-      std::map<ConstantExpr*, Instruction *> CMap;
       std::list<Instruction *> WorkList;
-      auto FBegin = I->begin();
-      for (auto BI = FBegin, BE = I->end(); BI != BE; ++BI) {
+      for (auto BI = I->begin(), BE = I->end(); BI != BE; ++BI) {
         for (auto II = BI->begin(), IE = BI->end(); II != IE; ++II) {
           WorkList.push_back(&*II);
         }
@@ -126,32 +124,40 @@ SPIRVLowerConstExpr::visit(Module *M) {
       while (!WorkList.empty()) {
         auto II = WorkList.front();
         WorkList.pop_front();
-        for (unsigned OI = 0, OE = II->getNumOperands(); OI != OE; ++OI) {
-          auto Op = II->getOperand(OI);
-
-          if (auto CE = dyn_cast<ConstantExpr>(Op)) {
-            SPIRVDBG(dbgs() << "[lowerConstantExpressions] " << *CE;)
-            auto ReplInst = CE->getAsInstruction();
-            ReplInst->insertBefore(&*FBegin->begin());
-            SPIRVDBG(dbgs() << " -> " << *ReplInst << '\n';)
-            WorkList.push_front(ReplInst);
-            std::vector<Instruction *> Users;
-            // Do not replace use during iteration of use. Do it in another loop
-            for (auto U:CE->users()) {
-              SPIRVDBG(dbgs() << "[lowerConstantExpressions] Use: " <<
-                  *U << '\n';)
-              if (auto InstUser = dyn_cast<Instruction>(U)) {
-                // Only replace users in scope of current function
-                if (InstUser->getParent()->getParent() == &*I)
-                  Users.push_back(InstUser);
-              }
-            }
-            for (auto &User:Users)
-              User->replaceUsesOfWith(CE, ReplInst);
-          }
+        lowerConstantExprOperands(II, WorkList);
+      }
+    }
+}
+
+void
+lowerConstantExprOperands(Instruction *II,
+    std::list<Instruction *> &WorkList) {
+  auto F = II->getParent()->getParent();
+  auto FBegin = F->begin();
+  for (unsigned OI = 0, OE = II->getNumOperands(); OI != OE; ++OI) {
+    auto Op = II->getOperand(OI);
+
+    if (auto CE = dyn_cast<ConstantExpr>(Op)) {
+      SPIRVDBG(dbgs() << "[lowerConstantExpressions] " << *CE;)
+      auto ReplInst = CE->getAsInstruction();
+      ReplInst->insertBefore(&*FBegin->begin());
+      SPIRVDBG(dbgs() << " -> " << *ReplInst << '\n';)
+      WorkList.push_front(ReplInst);
+      std::vector<Instruction *> Users;
+      // Do not replace use during iteration of use. Do it in another loop
+      for (auto U:CE->users()) {
+        SPIRVDBG(dbgs() << "[lowerConstantExpressions] Use: " <<
+            *U << '\n';)
+        if (auto InstUser = dyn_cast<Instruction>(U)) {
+          // Only replace users in scope of current function
+          if (InstUser->getParent()->getParent() == F)
+            Users.push_back(InstUser);
         }
       }
+      for (auto &User:Users)
+        User->replaceUsesOfWith(CE, ReplInst);
     }
+  }
 }
 
 }
@@ -159,6 +165,6 @@ SPIRVLowerConstExpr::visit(Module *M) {
 INITIALIZE_PASS(SPIRVLowerConstExpr, "spv-lower-const-expr",
     "Regularize LLVM for SPIR-V", false, false)
 
-ModulePass *llvm::createSPIRVLowerConstExpr() {
-  return new SPIRVLowerConstExpr();
+ModulePass *llvm::createSPIRVLowerConstExpr(const TranslatorOptions &Opts) {
+  return new SPIRVLowerConstExpr(Opts);
 }
@@ -0,0 +1,137 @@
+//===- SPIRVLowerInst.cpp - Lower instructions for SPIR-V in one walk -----===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass which performs the instruction-local lowerings
+// needed before translating LLVM to SPIR-V in a single walk over each
+// function:
+//   - constant expressions are lowered to instructions (SPIRVLowerConstExpr)
+//   - casts from/to i1 are lowered to icmp/select (SPIRVLowerBool)
+//   - llvm.memmove is lowered to llvm.memcpy's (SPIRVLowerMemmove)
+//   - llvm.memset is lowered to stores unless it sets a short constant
+//     length to zero (SPIRVLowerMemset.cpp)
+//
+// It produces the same result as running the three passes one after another
+// but visits every instruction only once.
+//
+//===----------------------------------------------------------------------===//
+#define DEBUG_TYPE "spv-lower-inst"
+
+#include "SPIRVInternal.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Pass.h"
+#include "llvm/PassSupport.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <list>
+
+using namespace llvm;
+using namespace SPIRV;
+
+namespace SPIRV {
+
+class SPIRVLowerInst: public ModulePass {
+public:
+  SPIRVLowerInst(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), Opts(TheOpts) {
+    initializeSPIRVLowerInstPass(*PassRegistry::getPassRegistry());
+  }
+
+  virtual bool runOnModule(Module &M);
+
+  /// Lower all instructions of \p F, including the instructions created by
+  /// lowering constant expressions.
+  void lowerFunction(Function &F);
+
+  static char ID;
+private:
+  TranslatorOptions Opts;
+};
+
+char SPIRVLowerInst::ID = 0;
+
+bool
+SPIRVLowerInst::runOnModule(Module &M) {
+  DEBUG(dbgs() << "Enter SPIRVLowerInst:\n");
+  for (auto &F : M)
+    lowerFunction(F);
+
+  DEBUG(dbgs() << "After SPIRVLowerInst:\n" << M);
+  if (Opts.LowerBoolValidate || Opts.LowerMemmoveValidate) {
+    std::string Err;
+    raw_string_ostream ErrorOS(Err);
+    if (verifyModule(M, &ErrorOS)){
+      Err = std::string("Fails to verify module: ") + Err;
+      report_fatal_error(Err.c_str(), false);
+    }
+  } else
+    verifyTranslatedModule(M, Opts, VerifyAfterEachPass, "SPIRVLowerInst");
+  return true;
+}
+
+void
+SPIRVLowerInst::lowerFunction(Function &F) {
+  std::list<Instruction *> WorkList;
+  for (auto &BB : F)
+    for (auto &I : BB)
+      WorkList.push_back(&I);
+
+  while (!WorkList.empty()) {
+    auto I = WorkList.front();
+    WorkList.pop_front();
+    // Instructions created for the constant expression operands of I are
+    // pushed to the front of the work list and visited next.
+    if (Opts.LowerConstExpr)
+      lowerConstantExprOperands(I, WorkList);
+    if (lowerBoolCast(I))
+      continue;
+    if (auto MI = dyn_cast<MemMoveInst>(I))
+      lowerMemMove(MI);
+    else if (auto MI = dyn_cast<MemSetInst>(I))
+      if (!isZeroPoolMemSet(MI, Opts.MemsetZeroPoolMaxSize))
+        lowerMemSet(MI);
+  }
+}
+
+}
+
+INITIALIZE_PASS(SPIRVLowerInst, "spv-lower-inst",
+    "Lower instructions for SPIR-V", false, false)
+
+ModulePass *llvm::createSPIRVLowerInst(const TranslatorOptions &Opts) {
+  return new SPIRVLowerInst(Opts);
+}
@@ -32,12 +32,18 @@
 //
 //===----------------------------------------------------------------------===//
 //
-// This file implements lowering llvm.memmove into several llvm.memcpys.
+// This file implements lowering llvm.memmove.
+//
+// A memmove whose source and destination are known not to overlap is lowered
+// to llvm.memcpy. Otherwise the bytes are copied in a loop, in chunks of the
+// widest vector of i8 allowed by the alignment, without a temporary buffer.
+// The loop runs forward if the destination comes before the source and
+// backward otherwise, so that no byte is overwritten before it is read.
 //
 //===----------------------------------------------------------------------===//
-#define DEBUG_TYPE "spvmemmove"
-
 #include "SPIRVInternal.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/InstVisitor.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/IRBuilder.h"
@@ -47,70 +53,43 @@
 #include "llvm/PassSupport.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#include <algorithm>
+
+#define DEBUG_TYPE "spvmemmove"
 
 using namespace llvm;
 using namespace SPIRV;
 
 namespace SPIRV {
-cl::opt<bool> SPIRVLowerMemmoveValidate("spvmemmove-validate",
+cl::opt<bool, true> SPIRVLowerMemmoveValidate("spvmemmove-validate",
     cl::desc("Validate module after lowering llvm.memmove instructions into " 
-        "llvm.memcpy"));
+        "llvm.memcpy"),
+    cl::location(getMutableDefaultTranslatorOptions().LowerMemmoveValidate));
 
 class SPIRVLowerMemmove: public ModulePass,
   public InstVisitor<SPIRVLowerMemmove> {
 public:
-  SPIRVLowerMemmove():ModulePass(ID), Context(nullptr) {
+  SPIRVLowerMemmove(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), Context(nullptr), Opts(TheOpts) {
     initializeSPIRVLowerMemmovePass(*PassRegistry::getPassRegistry());
   }
   virtual void visitMemMoveInst(MemMoveInst &I) {
-    IRBuilder<> Builder(I.getParent());
-    Builder.SetInsertPoint(&I);
-    auto *Dest = I.getRawDest();
-    auto *Src = I.getRawSource();
-    auto *SrcTy = Src->getType();
-    if (!isa<ConstantInt>(I.getLength())) 
-        // ToDo: for non-constant length, could use a loop to copy a 
-        // fixed length chunk at a time. For now simply fail
-        report_fatal_error("llvm.memmove of non-constant length not supported", 
-            false);
-    auto *Length = cast<ConstantInt>(I.getLength());
-    if (isa<BitCastInst>(Src)) 
-        // The source could be bit-cast from another type,
-        // need the original type for the allocation of the temporary variable
-        SrcTy = cast<BitCastInst>(Src)->getOperand(0)->getType();
-    auto Align = I.getAlignment();
-    auto Volatile = I.isVolatile();
-    Value *NumElements = nullptr;
-    uint64_t ElementsCount = 1;
-    if (SrcTy->isArrayTy()) {
-        NumElements = Builder.getInt32(SrcTy->getArrayNumElements());
-        ElementsCount = SrcTy->getArrayNumElements();
-    }
-    if (Mod->getDataLayout().getTypeSizeInBits(SrcTy->getPointerElementType()) 
-        * ElementsCount !=  Length->getZExtValue() * 8)
-        report_fatal_error("Size of the memcpy should match the allocated memory", 
-            false);
-
-    auto *Alloca = Builder.CreateAlloca(SrcTy->getPointerElementType(), 
-        NumElements);
-    auto *LifetimeStart = Builder.CreateLifetimeStart(Alloca);
-    auto *FirstCpy = Builder.CreateMemCpy(Alloca, Src, Length, Align, Volatile);
-    auto *SecondCpy = Builder.CreateMemCpy(Dest, Alloca, Length, Align, 
-        Volatile);
-    auto *LifetimeEnd = Builder.CreateLifetimeEnd(Alloca);
-
-    SecondCpy->takeName(&I);
-    I.replaceAllUsesWith(SecondCpy);
-    I.dropAllReferences();
-    I.eraseFromParent();
+    MemMoves.push_back(&I);
   }
   virtual bool runOnModule(Module &M) {
     Context = &M.getContext();
-    Mod = &M;
+    // Lowering splits basic blocks, so it is done after the visit.
     visit(M);
+    for (auto I : MemMoves)
+      lowerMemMove(I);
+    MemMoves.clear();
 
-    if (SPIRVLowerMemmoveValidate) {
+    if (Opts.LowerMemmoveValidate) {
       DEBUG(dbgs() << "After SPIRVLowerMemmove:\n" << M);
       std::string Err;
       raw_string_ostream ErrorOS(Err);
@@ -125,15 +104,157 @@ public:
   static char ID;
 private:
   LLVMContext *Context;
-  Module *Mod;
+  TranslatorOptions Opts;
+  std::vector<MemMoveInst *> MemMoves;
 };
 
 char SPIRVLowerMemmove::ID = 0;
+
+// Widest vector of i8 copied at a time.
+static const unsigned MaxMemMoveCopyWidth = 16;
+// Constant length memmoves of at most this many chunks are done by loading
+// all the chunks before storing any of them, without a loop.
+static const uint64_t MaxMemMoveUnrolledChunks = 4;
+
+/// Check if the source and destination of \p I are known not to overlap.
+static bool
+isMemMoveWithoutOverlap(MemMoveInst *I) {
+  auto Dest = I->getRawDest();
+  auto Src = I->getRawSource();
+  auto DestAS = Dest->getType()->getPointerAddressSpace();
+  auto SrcAS = Src->getType()->getPointerAddressSpace();
+  // Named address spaces are disjoint.
+  if (DestAS != SrcAS && DestAS != SPIRAS_Generic && SrcAS != SPIRAS_Generic)
+    return true;
+
+  auto &DL = I->getModule()->getDataLayout();
+  int64_t DestOffset = 0, SrcOffset = 0;
+  auto DestBase = GetPointerBaseWithConstantOffset(Dest, DestOffset, DL);
+  auto SrcBase = GetPointerBaseWithConstantOffset(Src, SrcOffset, DL);
+  if (DestBase == SrcBase) {
+    auto Len = dyn_cast<ConstantInt>(I->getLength());
+    uint64_t Distance = DestOffset > SrcOffset ? DestOffset - SrcOffset :
+        SrcOffset - DestOffset;
+    return Len && Distance >= Len->getZExtValue();
+  }
+  DestBase = GetUnderlyingObject(DestBase, DL);
+  SrcBase = GetUnderlyingObject(SrcBase, DL);
+  return DestBase != SrcBase && isIdentifiedObject(DestBase) &&
+      isIdentifiedObject(SrcBase);
+}
+
+void
+lowerMemMove(MemMoveInst *I) {
+  auto *Dest = I->getRawDest();
+  auto *Src = I->getRawSource();
+  auto *Len = I->getLength();
+  auto Align = std::max(I->getAlignment(), 1u);
+  auto Volatile = I->isVolatile();
+  IRBuilder<> Builder(I);
+
+  if (isMemMoveWithoutOverlap(I)) {
+    auto *Cpy = Builder.CreateMemCpy(Dest, Src, Len, Align, Volatile);
+    Cpy->takeName(I);
+    I->eraseFromParent();
+    return;
+  }
+
+  auto *LenTy = Len->getType();
+  auto *ConstLen = dyn_cast<ConstantInt>(Len);
+  if (ConstLen && ConstLen->isZero()) {
+    I->eraseFromParent();
+    return;
+  }
+
+  // The alignment is a power of two, so is the chunk width. A constant
+  // length memmove shorter than it is done with narrower chunks.
+  unsigned Width = std::min(Align, MaxMemMoveCopyWidth);
+  if (ConstLen)
+    Width = std::min<uint64_t>(Width, PowerOf2Floor(ConstLen->getZExtValue()));
+  Value *WideDest = Dest;
+  Value *WideSrc = Src;
+  if (Width > 1) {
+    auto *WideTy = VectorType::get(Builder.getInt8Ty(), Width);
+    WideDest = Builder.CreateBitCast(Dest, PointerType::get(WideTy,
+        Dest->getType()->getPointerAddressSpace()));
+    WideSrc = Builder.CreateBitCast(Src, PointerType::get(WideTy,
+        Src->getType()->getPointerAddressSpace()));
+  }
+  auto LoadChunk = [&](Value *Index) {
+    return Builder.CreateAlignedLoad(Builder.CreateGEP(WideSrc, Index), Width,
+        Volatile);
+  };
+  auto StoreChunk = [&](Value *V, Value *Index) {
+    Builder.CreateAlignedStore(V, Builder.CreateGEP(WideDest, Index), Width,
+        Volatile);
+  };
+  auto CopyChunk = [&](Value *Index) {
+    StoreChunk(LoadChunk(Index), Index);
+  };
+  auto CopyByte = [&](Value *Index) {
+    Builder.CreateAlignedStore(
+        Builder.CreateAlignedLoad(Builder.CreateGEP(Src, Index), 1, Volatile),
+        Builder.CreateGEP(Dest, Index), 1, Volatile);
+  };
+
+  if (ConstLen && ConstLen->getZExtValue() % Width == 0 &&
+      ConstLen->getZExtValue() / Width <= MaxMemMoveUnrolledChunks) {
+    std::vector<std::pair<Value *, Value *>> Chunks;
+    for (uint64_t J = 0, E = ConstLen->getZExtValue() / Width; J < E; ++J) {
+      auto Index = ConstantInt::get(LenTy, J);
+      Chunks.push_back(std::make_pair(LoadChunk(Index), Index));
+    }
+    for (auto &Chunk : Chunks)
+      StoreChunk(Chunk.first, Chunk.second);
+    I->eraseFromParent();
+    return;
+  }
+
+  // Compare the addresses as integers, in the generic address space if the
+  // address spaces of the source and destination differ.
+  auto &DL = I->getModule()->getDataLayout();
+  Value *DestAddr = Dest;
+  Value *SrcAddr = Src;
+  if (Dest->getType()->getPointerAddressSpace() !=
+      Src->getType()->getPointerAddressSpace()) {
+    auto GenericTy = Builder.getInt8PtrTy(SPIRAS_Generic);
+    DestAddr = Builder.CreatePointerBitCastOrAddrSpaceCast(Dest, GenericTy);
+    SrcAddr = Builder.CreatePointerBitCastOrAddrSpaceCast(Src, GenericTy);
+  }
+  auto IntPtrTy = DL.getIntPtrType(DestAddr->getType());
+  auto Forward = Builder.CreateICmpULE(
+      Builder.CreatePtrToInt(DestAddr, IntPtrTy),
+      Builder.CreatePtrToInt(SrcAddr, IntPtrTy), "memmove.fwd");
+  auto NumChunks = Width > 1 ? Builder.CreateLShr(Len, Log2_32(Width)) : Len;
+  auto TailBegin = Width > 1 ? Builder.CreateAnd(Len,
+      ConstantInt::get(LenTy, ~uint64_t(Width - 1))) : Len;
+  auto Zero = ConstantInt::get(LenTy, 0);
+
+  TerminatorInst *ForwardTerm = nullptr;
+  TerminatorInst *BackwardTerm = nullptr;
+  SplitBlockAndInsertIfThenElse(Forward, I, &ForwardTerm, &BackwardTerm);
+
+  // Forward, the chunks are copied before the tail bytes which follow them.
+  Builder.SetInsertPoint(ForwardTerm);
+  createIndexLoop(Builder, Zero, NumChunks, false, "memmove.fwd", CopyChunk);
+  if (Width > 1)
+    createIndexLoop(Builder, TailBegin, Len, false, "memmove.fwd.tail",
+        CopyByte);
+
+  // Backward, the tail bytes go first.
+  Builder.SetInsertPoint(BackwardTerm);
+  if (Width > 1)
+    createIndexLoop(Builder, TailBegin, Len, true, "memmove.bwd.tail",
+        CopyByte);
+  createIndexLoop(Builder, Zero, NumChunks, true, "memmove.bwd", CopyChunk);
+
+  I->eraseFromParent();
+}
 }
 
 INITIALIZE_PASS(SPIRVLowerMemmove, "spvmemmove",
     "Lower llvm.memmove into llvm.memcpy", false, false)
 
-ModulePass *llvm::createSPIRVLowerMemmove() {
-  return new SPIRVLowerMemmove();
+ModulePass *llvm::createSPIRVLowerMemmove(const TranslatorOptions &Opts) {
+  return new SPIRVLowerMemmove(Opts);
 }
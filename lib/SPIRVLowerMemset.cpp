@@ -0,0 +1,138 @@
+//===- SPIRVLowerMemset.cpp - Lower llvm.memset to stores ------------------===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file implements lowering llvm.memset into stores.
+//
+// SPIR-V has no instruction to fill memory with a value. Setting a small
+// constant number of bytes to zero is translated by the writer to a copy from
+// a zero-initialized constant shared by the module. The other memsets are
+// lowered here to stores of the widest vector of i8 allowed by the alignment
+// of the destination, in a loop unless there are only a few of them.
+//
+//===----------------------------------------------------------------------===//
+#define DEBUG_TYPE "spvmemset"
+
+#include "SPIRVInternal.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+
+using namespace llvm;
+using namespace SPIRV;
+
+namespace SPIRV {
+cl::opt<unsigned, true> SPIRVMemsetZeroPoolMaxSize(
+    "spirv-memset-zero-pool-max-size",
+    cl::desc("Maximum length in bytes of llvm.memset of zero translated to a "
+        "copy from a shared zero-initialized constant"),
+    cl::location(getMutableDefaultTranslatorOptions().MemsetZeroPoolMaxSize));
+
+// Widest vector of i8 stored at a time.
+static const unsigned MaxMemsetStoreWidth = 16;
+// Constant length memsets needing at most this many stores are not lowered
+// to a loop.
+static const uint64_t MaxMemsetUnrolledStores = 4;
+
+bool
+isZeroPoolMemSet(MemSetInst *I, uint64_t MaxSize) {
+  auto Val = dyn_cast<Constant>(I->getValue());
+  auto Len = dyn_cast<ConstantInt>(I->getLength());
+  return Val && Val->isZeroValue() && Len && !Len->isZero() &&
+      Len->getZExtValue() <= MaxSize;
+}
+
+void
+lowerMemSet(MemSetInst *I) {
+  IRBuilder<> Builder(I);
+  auto Dest = I->getRawDest();
+  auto Val = I->getValue();
+  auto Len = I->getLength();
+  auto LenTy = Len->getType();
+  auto AddrSpace = Dest->getType()->getPointerAddressSpace();
+  auto Align = std::max(I->getAlignment(), 1u);
+  auto Volatile = I->isVolatile();
+
+  auto ConstLen = dyn_cast<ConstantInt>(Len);
+  if (ConstLen && ConstLen->isZero()) {
+    I->eraseFromParent();
+    return;
+  }
+
+  // The destination alignment is a power of two, so is the store width.
+  // A constant length memset shorter than it is done with narrower stores.
+  unsigned Width = std::min(Align, MaxMemsetStoreWidth);
+  if (ConstLen)
+    Width = std::min<uint64_t>(Width, PowerOf2Floor(ConstLen->getZExtValue()));
+  Value *WideDest = Dest;
+  Value *WideVal = Val;
+  if (Width > 1) {
+    WideVal = Builder.CreateVectorSplat(Width, Val);
+    WideDest = Builder.CreateBitCast(Dest,
+        PointerType::get(WideVal->getType(), AddrSpace));
+  }
+  auto StoreWide = [&](Value *Index) {
+    Builder.CreateAlignedStore(WideVal,
+        Builder.CreateGEP(WideDest, Index), Width, Volatile);
+  };
+  auto StoreByte = [&](Value *Index) {
+    Builder.CreateAlignedStore(Val, Builder.CreateGEP(Dest, Index), 1,
+        Volatile);
+  };
+
+  if (ConstLen) {
+    uint64_t Size = ConstLen->getZExtValue();
+    uint64_t NumWide = Size / Width;
+    if (NumWide <= MaxMemsetUnrolledStores) {
+      for (uint64_t J = 0; J < NumWide; ++J)
+        StoreWide(ConstantInt::get(LenTy, J));
+    } else
+      createIndexLoop(Builder, ConstantInt::get(LenTy, 0),
+          ConstantInt::get(LenTy, NumWide), false, "memset", StoreWide);
+    for (uint64_t J = NumWide * Width; J < Size; ++J)
+      StoreByte(ConstantInt::get(LenTy, J));
+  } else if (Width > 1) {
+    createIndexLoop(Builder, ConstantInt::get(LenTy, 0),
+        Builder.CreateLShr(Len, Log2_32(Width)), false, "memset", StoreWide);
+    auto TailBegin = Builder.CreateAnd(Len,
+        ConstantInt::get(LenTy, ~uint64_t(Width - 1)));
+    createIndexLoop(Builder, TailBegin, Len, false, "memset", StoreByte);
+  } else
+    createIndexLoop(Builder, ConstantInt::get(LenTy, 0), Len, false, "memset",
+        StoreByte);
+
+  I->eraseFromParent();
+}
+}
@@ -43,28 +43,39 @@
 #include "SPIRVFunction.h"
 #include "SPIRVBasicBlock.h"
 #include "SPIRVInstruction.h"
+#include "SPIRVStream.h"
 #include "SPIRVExtInst.h"
 #include "SPIRVInternal.h"
 #include "SPIRVMDBuilder.h"
 #include "OCLUtil.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/DIBuilder.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/ValueHandle.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/CommandLine.h"
 
@@ -81,6 +92,10 @@
 
 #define DEBUG_TYPE "spirv"
 
+STATISTIC(NumBuiltinDeclLookups, "Number of builtin declaration lookups");
+STATISTIC(NumBuiltinDeclCacheHits,
+    "Number of builtin declarations found in the cache");
+
 using namespace std;
 using namespace llvm;
 using namespace SPIRV;
@@ -88,19 +103,36 @@ using namespace OCLUtil;
 
 namespace SPIRV{
 
-cl::opt<bool> SPIRVEnableStepExpansion("spirv-expand-step", cl::init(true),
-  cl::desc("Enable expansion of OpenCL step and smoothstep function"));
-
-cl::opt<bool> SPIRVGenKernelArgNameMD("spirv-gen-kernel-arg-name-md",
-    cl::init(false), cl::desc("Enable generating OpenCL kernel argument name "
-    "metadata"));
-
-cl::opt<bool> SPIRVGenImgTypeAccQualPostfix("spirv-gen-image-type-acc-postfix",
-    cl::init(false), cl::desc("Enable generating access qualifier postfix"
-        " in OpenCL image type names"));
-
-// Prefix for placeholder global variable name.
-const char* kPlaceholderPrefix = "placeholder.";
+cl::opt<bool, true> SPIRVEnableStepExpansion("spirv-expand-step",
+  cl::desc("Enable expansion of OpenCL step and smoothstep function"),
+  cl::location(getMutableDefaultTranslatorOptions().EnableStepExpansion));
+
+cl::opt<bool, true> SPIRVGenKernelArgNameMD("spirv-gen-kernel-arg-name-md",
+    cl::desc("Enable generating OpenCL kernel argument name "
+    "metadata"),
+    cl::location(getMutableDefaultTranslatorOptions().GenKernelArgNameMD));
+
+cl::opt<bool, true> SPIRVGenImgTypeAccQualPostfix(
+    "spirv-gen-image-type-acc-postfix",
+    cl::desc("Enable generating access qualifier postfix"
+        " in OpenCL image type names"),
+    cl::location(
+        getMutableDefaultTranslatorOptions().GenImgTypeAccQualPostfix));
+
+cl::opt<bool, true> SPIRVReleaseFunctionBodies(
+    "spirv-release-function-bodies",
+    cl::desc("Release each SPIR-V function body once it is translated"),
+    cl::location(getMutableDefaultTranslatorOptions().ReleaseFunctionBodies));
+
+cl::opt<bool, true> SPIRVFriendlyIR("spirv-friendly-ir",
+    cl::desc("Translate SPIR-V to LLVM IR with SPIR-V builtin functions and "
+    "variables instead of OpenCL builtins"),
+    cl::location(getMutableDefaultTranslatorOptions().SPIRVFriendlyIR));
+
+cl::opt<bool, true> SPIRVExtInstToIntrinsics("spirv-ext-inst-to-intrinsics",
+    cl::desc("Translate OpenCL.std extended instructions to LLVM intrinsics "
+    "where possible"),
+    cl::location(getMutableDefaultTranslatorOptions().ExtInstToIntrinsics));
 
 // Save the translated LLVM before validation for debugging purpose.
 static bool DbgSaveTmpLLVM = true;
@@ -275,8 +307,9 @@ private:
 
 class SPIRVToLLVM {
 public:
-  SPIRVToLLVM(Module *LLVMModule, SPIRVModule *TheSPIRVModule)
-    :M(LLVMModule), BM(TheSPIRVModule), DbgTran(BM, M){
+  SPIRVToLLVM(Module *LLVMModule, SPIRVModule *TheSPIRVModule,
+      const TranslatorOptions &TheOpts = getDefaultTranslatorOptions())
+    :M(LLVMModule), BM(TheSPIRVModule), Opts(TheOpts), DbgTran(BM, M){
     assert(M);
     Context = &M->getContext();
   }
@@ -298,20 +331,29 @@ public:
   bool transDecoration(SPIRVValue *, Value *);
   bool transAlign(SPIRVValue *, Value *);
   Instruction *transOCLBuiltinFromExtInst(SPIRVExtInst *BC, BasicBlock *BB);
+  Instruction *transIntrinsicFromExtInst(SPIRVExtInst *BC, BasicBlock *BB);
   std::vector<Value *> transValue(const std::vector<SPIRVValue *>&, Function *F,
       BasicBlock *);
   Function *transFunction(SPIRVFunction *F);
   bool transFPContractMetadata();
   bool transKernelMetadata();
   bool transNonTemporalMetadata(Instruction *I);
+  void transLoopMetadata(Function *F);
+  void transRestrictMetadata(SPIRVFunction *BF, Function *F);
   bool transSourceLanguage();
   bool transSourceExtension();
   void transGeneratorMD();
   Value *transConvertInst(SPIRVValue* BV, Function* F, BasicBlock* BB);
   Instruction *transBuiltinFromInst(const std::string& FuncName,
       SPIRVInstruction* BI, BasicBlock* BB);
+  Instruction *transBuiltinCall(Function *Func, SPIRVInstruction *BI,
+      const std::vector<SPIRVValue *> &Ops, BasicBlock *BB,
+      const std::string &FuncName);
   Instruction *transOCLBuiltinFromInst(SPIRVInstruction *BI, BasicBlock *BB);
   Instruction *transSPIRVBuiltinFromInst(SPIRVInstruction *BI, BasicBlock *BB);
+  /// Get the postfixes of the SPIR-V builtin function name of an instruction
+  /// in SPIR-V friendly IR, e.g. _R{ReturnType}_sat_rte for conversions.
+  std::string getSPIRVBuiltinPostfix(SPIRVInstruction *BI);
   Instruction *transOCLBarrierFence(SPIRVInstruction* BI, BasicBlock *BB);
   void transOCLVectorLoadStore(std::string& UnmangledName,
       std::vector<SPIRVWord> &BArgs);
@@ -388,10 +430,34 @@ public:
   typedef DenseMap<SPIRVFunction *, Function *> SPIRVToLLVMFunctionMap;
   typedef DenseMap<GlobalVariable *, SPIRVBuiltinVariableKind> BuiltinVarMap;
 
-  // A SPIRV value may be translated to a load instruction of a placeholder
-  // global variable. This map records load instruction of these placeholders
-  // which are supposed to be replaced by the real values later.
-  typedef std::map<SPIRVValue *, LoadInst*> SPIRVToLLVMPlaceholderMap;
+  // A SPIRV instruction used before it is translated (e.g. a phi operand
+  // reached through a back edge) is translated to a free-standing placeholder
+  // value which is never inserted into the module. This map records the
+  // placeholders which have not been replaced by the real values yet.
+  typedef DenseMap<SPIRVValue *, Argument *> SPIRVToLLVMPlaceholderMap;
+  typedef std::vector<std::pair<Argument *, Value *>> SPIRVToLLVMResolvedMap;
+
+  // Declarations of builtin functions created by transBuiltinFromInst, keyed
+  // by the unmangled name and the function type, so that each distinct
+  // builtin is mangled only once per module. The mangled name is kept to
+  // detect declarations renamed or erased by later call mutation.
+  struct BuiltinDecl {
+    WeakVH Func;
+    std::string MangledName;
+  };
+  typedef std::map<std::pair<std::string, FunctionType *>, BuiltinDecl>
+      SPIRVToLLVMBuiltinDeclMap;
+
+  // Loops declared by OpLoopMerge in the function being translated. The
+  // llvm.loop node is attached to the branch of the header block first; the
+  // latches and the memory accesses of the loop are annotated once the
+  // whole function body is available.
+  struct LoopMergeInfo {
+    BasicBlock *Header;
+    MDNode *LoopID;
+    bool IsParallel;
+  };
+  typedef std::vector<LoopMergeInfo> SPIRVToLLVMLoopMergeVec;
 private:
   Module *M;
   BuiltinVarMap BuiltinGVMap;
@@ -401,6 +467,10 @@ private:
   SPIRVToLLVMValueMap ValueMap;
   SPIRVToLLVMFunctionMap FuncMap;
   SPIRVToLLVMPlaceholderMap PlaceholderMap;
+  SPIRVToLLVMResolvedMap ResolvedPlaceholders;
+  SPIRVToLLVMBuiltinDeclMap BuiltinDeclMap;
+  SPIRVToLLVMLoopMergeVec LoopMerges;
+  TranslatorOptions Opts;
   SPIRVToLLVMDbgTran DbgTran;
 
   Type *mapType(SPIRVType *BT, Type *T) {
@@ -409,30 +479,53 @@ private:
     return T;
   }
 
-  // If a value is mapped twice, the existing mapped value is a placeholder,
-  // which must be a load instruction of a global variable whose name starts
-  // with kPlaceholderPrefix.
+  // If a value is mapped twice, the existing mapped value is a placeholder.
+  // Its uses are redirected to the real value by resolvePlaceholders() once
+  // the enclosing function has been translated.
   Value *mapValue(SPIRVValue *BV, Value *V) {
     auto Loc = ValueMap.find(BV);
     if (Loc != ValueMap.end()) {
       if (Loc->second == V)
         return V;
-      auto LD = dyn_cast<LoadInst>(Loc->second);
-      auto Placeholder = dyn_cast<GlobalVariable>(LD->getPointerOperand());
-      assert (LD && Placeholder &&
-          Placeholder->getName().startswith(kPlaceholderPrefix) &&
+      auto PH = PlaceholderMap.find(BV);
+      assert (PH != PlaceholderMap.end() && PH->second == Loc->second &&
           "A value is translated twice");
-      // Replaces placeholders for PHI nodes
-      LD->replaceAllUsesWith(V);
-      LD->dropAllReferences();
-      LD->removeFromParent();
-      Placeholder->dropAllReferences();
-      Placeholder->removeFromParent();
+      ResolvedPlaceholders.push_back(std::make_pair(PH->second, V));
+      PlaceholderMap.erase(PH);
     }
     ValueMap[BV] = V;
     return V;
   }
 
+  // Replaces all placeholders created for the current function by the real
+  // values in one pass. Placeholders which are never defined can only come
+  // from invalid input; their uses are replaced by undef.
+  void resolvePlaceholders() {
+    for (auto &I : PlaceholderMap) {
+      ResolvedPlaceholders.push_back(std::make_pair(I.second,
+          UndefValue::get(I.second->getType())));
+      ValueMap.erase(I.first);
+    }
+    PlaceholderMap.clear();
+    for (auto &I : ResolvedPlaceholders) {
+      I.first->replaceAllUsesWith(I.second);
+      delete I.first;
+    }
+    ResolvedPlaceholders.clear();
+  }
+
+  // Forgets the translated values of the body of a translated function and
+  // releases the body from the SPIR-V module.
+  void releaseFunctionBody(SPIRVFunction *BF) {
+    for (size_t I = 0, E = BF->getNumBasicBlock(); I != E; ++I) {
+      SPIRVBasicBlock *BBB = BF->getBasicBlock(I);
+      for (size_t BI = 0, BE = BBB->getNumInst(); BI != BE; ++BI)
+        ValueMap.erase(BBB->getInst(BI));
+      ValueMap.erase(BBB);
+    }
+    BM->releaseFunctionBody(BF);
+  }
+
   bool isSPIRVBuiltinVariable(GlobalVariable *GV,
       SPIRVBuiltinVariableKind *Kind = nullptr) {
     auto Loc = BuiltinGVMap.find(GV);
@@ -655,7 +748,7 @@ std::string
 SPIRVToLLVM::transOCLImageTypeName(SPIRV::SPIRVTypeImage* ST) {
   std::string Name = std::string(kSPR2TypeName::OCLPrefix)
     + rmap<std::string>(ST->getDescriptor());
-  if (SPIRVGenImgTypeAccQualPostfix)
+  if (Opts.GenImgTypeAccQualPostfix)
     SPIRVToLLVM::insertImageNameAccessQualifier(ST, Name);
   return std::move(Name);
 }
@@ -847,7 +940,7 @@ SPIRVToLLVM::transTypeToOCLTypeName(SPIRVType *T, bool IsSigned) {
   case OpTypeImage: {
     std::string Name;
     Name = rmap<std::string>(static_cast<SPIRVTypeImage *>(T)->getDescriptor());
-    if (SPIRVGenImgTypeAccQualPostfix) {
+    if (Opts.GenImgTypeAccQualPostfix) {
       auto ST = static_cast<SPIRVTypeImage *>(T);
       insertImageNameAccessQualifier(ST, Name);
     }
@@ -906,33 +999,140 @@ SPIRVToLLVM::setName(llvm::Value* V, SPIRVValue* BV) {
 
 void
 SPIRVToLLVM::setLLVMLoopMetadata(SPIRVLoopMerge* LM, BranchInst* BI) {
-  if (!LM)
+  // The instruction preceding a branch may also be OpSelectionMerge or any
+  // ordinary instruction.
+  if (!LM || LM->getOpCode() != OpLoopMerge)
     return;
-  llvm::MDString *Name = nullptr;
   auto Temp = MDNode::getTemporary(*Context, None);
   auto Self = MDNode::get(*Context, Temp.get());
   Self->replaceOperandWith(0, Self);
   MDNode::deleteTemporary(Temp.get());
 
-  if (LM->getLoopControl() == LoopControlMaskNone) {
+  SPIRVWord LoopControl = LM->getLoopControl();
+  bool IsParallel = LoopControl & LoopControlDependencyInfiniteMask;
+  if (LoopControl == LoopControlMaskNone) {
     BI->setMetadata("llvm.loop", Self);
+    LoopMerges.push_back({BI->getParent(), Self, IsParallel});
     return;
   }
-  else if(LM->getLoopControl() == LoopControlUnrollMask)
-    Name = llvm::MDString::get(*Context, "llvm.loop.unroll.full");
-  else if (LM->getLoopControl() == LoopControlDontUnrollMask)
-    Name = llvm::MDString::get(*Context, "llvm.loop.unroll.disable");
-  else
-    return;
 
-  std::vector<llvm::Metadata *> OpValues(1, Name);
-  SmallVector<llvm::Metadata *, 2> Metadata;
+  SmallVector<llvm::Metadata *, 4> Metadata;
   Metadata.push_back(llvm::MDNode::get(*Context, Self));
-  Metadata.push_back(llvm::MDNode::get(*Context, OpValues));
+  if (LoopControl & LoopControlUnrollMask)
+    Metadata.push_back(llvm::MDNode::get(*Context,
+        llvm::MDString::get(*Context, "llvm.loop.unroll.full")));
+  else if (LoopControl & LoopControlDontUnrollMask)
+    Metadata.push_back(llvm::MDNode::get(*Context,
+        llvm::MDString::get(*Context, "llvm.loop.unroll.disable")));
+
+  // Without loop carried dependencies the loop is also annotated as parallel
+  // by transLoopMetadata. With a dependency distance of N, at most N
+  // consecutive iterations can be executed simultaneously.
+  auto &Parameters = LM->getLoopControlParameters();
+  if (IsParallel)
+    Metadata.push_back(llvm::MDNode::get(*Context, {
+        llvm::MDString::get(*Context, "llvm.loop.vectorize.enable"),
+        ConstantAsMetadata::get(ConstantInt::getTrue(*Context))}));
+  else if ((LoopControl & LoopControlDependencyLengthMask) &&
+      !Parameters.empty() && Parameters[0] > 0)
+    Metadata.push_back(llvm::MDNode::get(*Context, {
+        llvm::MDString::get(*Context, "llvm.loop.vectorize.width"),
+        ConstantAsMetadata::get(ConstantInt::get(
+            Type::getInt32Ty(*Context), Parameters[0]))}));
 
   llvm::MDNode *Node = llvm::MDNode::get(*Context, Metadata);
   Node->replaceOperandWith(0, Node);
   BI->setMetadata("llvm.loop", Node);
+  LoopMerges.push_back({BI->getParent(), Node, IsParallel});
+}
+
+/// LLVM looks for the llvm.loop node on the terminators of the latches,
+/// whereas SPIR-V declares the loop in its header, so the node is copied to
+/// the back edges of the loop. The memory accesses of a loop without loop
+/// carried dependencies are annotated with llvm.mem.parallel_loop_access.
+void
+SPIRVToLLVM::transLoopMetadata(Function *F) {
+  if (LoopMerges.empty())
+    return;
+  DominatorTree DT(*F);
+  LoopInfo LI(DT);
+  for (auto &LM : LoopMerges) {
+    Loop *L = LI.getLoopFor(LM.Header);
+    if (!L || L->getHeader() != LM.Header)
+      continue;
+    SmallVector<BasicBlock *, 2> Latches;
+    L->getLoopLatches(Latches);
+    for (auto Latch : Latches)
+      if (!Latch->getTerminator()->getMetadata(LLVMContext::MD_loop))
+        Latch->getTerminator()->setMetadata(LLVMContext::MD_loop, LM.LoopID);
+    if (!LM.IsParallel)
+      continue;
+    for (auto BB : L->blocks())
+      for (auto &I : *BB) {
+        if (!I.mayReadOrWriteMemory())
+          continue;
+        // Accesses in nested parallel loops belong to all of them.
+        SmallVector<llvm::Metadata *, 2> LoopIDs;
+        if (auto MD = I.getMetadata(LLVMContext::MD_mem_parallel_loop_access))
+          LoopIDs.append(MD->op_begin(), MD->op_end());
+        LoopIDs.push_back(LM.LoopID);
+        I.setMetadata(LLVMContext::MD_mem_parallel_loop_access,
+            MDNode::get(*Context, LoopIDs));
+      }
+  }
+  LoopMerges.clear();
+}
+
+/// Pointer arguments decorated with Restrict get the noalias attribute and
+/// an alias scope of their own. Loads and stores based on such an argument
+/// are put in its scope, and the ones based on any other identified object
+/// are marked as not aliasing it. Aliased arguments keep the default
+/// may-alias semantics.
+void
+SPIRVToLLVM::transRestrictMetadata(SPIRVFunction *BF, Function *F) {
+  SmallVector<Argument *, 4> RestrictArgs;
+  for (auto &Arg : F->args()) {
+    if (!Arg.getType()->isPointerTy() ||
+        !BF->getArgument(Arg.getArgNo())->hasDecorate(DecorationRestrict))
+      continue;
+    if (!Arg.hasNoAliasAttr())
+      F->addAttribute(Arg.getArgNo() + 1, Attribute::NoAlias);
+    RestrictArgs.push_back(&Arg);
+  }
+  if (RestrictArgs.empty())
+    return;
+
+  MDBuilder MDB(*Context);
+  MDNode *Domain = MDB.createAnonymousAliasScopeDomain(F->getName());
+  SmallVector<MDNode *, 4> Scopes;
+  for (auto Arg : RestrictArgs)
+    Scopes.push_back(MDB.createAnonymousAliasScope(Domain, Arg->getName()));
+
+  const DataLayout &DL = M->getDataLayout();
+  for (auto &BB : *F)
+    for (auto &I : BB) {
+      Value *Ptr = nullptr;
+      if (auto LI = dyn_cast<LoadInst>(&I))
+        Ptr = LI->getPointerOperand();
+      else if (auto SI = dyn_cast<StoreInst>(&I))
+        Ptr = SI->getPointerOperand();
+      else
+        continue;
+      Value *Obj = GetUnderlyingObject(Ptr, DL);
+      if (!isIdentifiedObject(Obj))
+        continue;
+      SmallVector<llvm::Metadata *, 4> NoAliasScopes;
+      for (size_t J = 0, E = RestrictArgs.size(); J != E; ++J) {
+        if (Obj == RestrictArgs[J])
+          I.setMetadata(LLVMContext::MD_alias_scope,
+              MDNode::get(*Context, Scopes[J]));
+        else
+          NoAliasScopes.push_back(Scopes[J]);
+      }
+      if (!NoAliasScopes.empty())
+        I.setMetadata(LLVMContext::MD_noalias,
+            MDNode::get(*Context, NoAliasScopes));
+    }
 }
 
 void SPIRVToLLVM::insertImageNameAccessQualifier(SPIRV::SPIRVTypeImage* ST, std::string &Name) {
@@ -1048,35 +1248,62 @@ SPIRVToLLVM::postProcessOCL() {
   SPIRVWord SrcLangVer = 0;
   BM->getSourceLanguage(&SrcLangVer);
   bool isCPP = SrcLangVer == kOCLVer::CL21;
-  for (auto I = M->begin(), E = M->end(); I != E;) {
-    auto F = I++;
-    if (F->hasName() && F->isDeclaration()) {
-      DEBUG(dbgs() << "[postProcessOCL sret] " << *F << '\n');
-      if (F->getReturnType()->isStructTy() &&
-          oclIsBuiltin(F->getName(), &DemangledName, isCPP)) {
-        if (!postProcessOCLBuiltinReturnStruct(&*F))
-          return false;
-      }
-    }
-  }
-  for (auto I = M->begin(), E = M->end(); I != E;) {
-    auto F = I++;
-    if (F->hasName() && F->isDeclaration()) {
-      DEBUG(dbgs() << "[postProcessOCL func ptr] " << *F << '\n');
-      auto AI = F->arg_begin();
-      if (hasFunctionPointerArg(&*F, AI) && isDecoratedSPIRVFunc(&*F))
-        if (!postProcessOCLBuiltinWithFuncPointer(&*F, AI))
-          return false;
+
+  // Collect the declarations needing each fix-up in one scan of the module.
+  // Only the function type is checked here, which rules out almost all
+  // functions before any name is demangled. A fix-up may erase or replace
+  // declarations collected for a later one, hence the value handles.
+  std::vector<Function *> RetStructFuncs;
+  std::vector<WeakVH> FuncPtrArgFuncs;
+  std::vector<WeakVH> ArrayArgFuncs;
+  for (auto &F : *M) {
+    if (!F.hasName() || !F.isDeclaration())
+      continue;
+    auto AI = F.arg_begin();
+    if (F.getReturnType()->isStructTy())
+      RetStructFuncs.push_back(&F);
+    if (hasFunctionPointerArg(&F, AI))
+      FuncPtrArgFuncs.push_back(&F);
+    if (hasArrayArg(&F))
+      ArrayArgFuncs.push_back(&F);
+  }
+
+  for (auto F : RetStructFuncs) {
+    DEBUG(dbgs() << "[postProcessOCL sret] " << *F << '\n');
+    if (!oclIsBuiltin(F->getName(), &DemangledName, isCPP))
+      continue;
+    std::string Name = F->getName();
+    if (!postProcessOCLBuiltinReturnStruct(F))
+      return false;
+    // The replacement takes the name of the original function and may still
+    // need the other fix-ups.
+    if (auto NewF = M->getFunction(Name)) {
+      auto AI = NewF->arg_begin();
+      if (hasFunctionPointerArg(NewF, AI))
+        FuncPtrArgFuncs.push_back(NewF);
+      if (hasArrayArg(NewF))
+        ArrayArgFuncs.push_back(NewF);
     }
   }
-  for (auto I = M->begin(), E = M->end(); I != E;) {
-    auto F = I++;
-    if (F->hasName() && F->isDeclaration()) {
-      DEBUG(dbgs() << "[postProcessOCL array arg] " << *F << '\n');
-      if (hasArrayArg(&*F) && oclIsBuiltin(F->getName(), &DemangledName, isCPP))
-        if (!postProcessOCLBuiltinWithArrayArguments(&*F, DemangledName))
-          return false;
-    }
+  for (auto &V : FuncPtrArgFuncs) {
+    // Skip functions erased or replaced by a previous fix-up.
+    auto F = cast_or_null<Function>(V);
+    if (!F || F->getParent() != M)
+      continue;
+    DEBUG(dbgs() << "[postProcessOCL func ptr] " << *F << '\n');
+    auto AI = F->arg_begin();
+    if (hasFunctionPointerArg(F, AI) && isDecoratedSPIRVFunc(F))
+      if (!postProcessOCLBuiltinWithFuncPointer(F, AI))
+        return false;
+  }
+  for (auto &V : ArrayArgFuncs) {
+    auto F = cast_or_null<Function>(V);
+    if (!F || F->getParent() != M)
+      continue;
+    DEBUG(dbgs() << "[postProcessOCL array arg] " << *F << '\n');
+    if (oclIsBuiltin(F->getName(), &DemangledName, isCPP))
+      if (!postProcessOCLBuiltinWithArrayArguments(F, DemangledName))
+        return false;
   }
   return true;
 }
@@ -1376,9 +1603,10 @@ const llvm::fltSemantics & fltSemOf(int width)
 /// of first use, then replaced by real instructions when they are
 /// created.
 ///
-/// When CreatePlaceHolder is true, create a load instruction of a
-/// global variable as placeholder for SPIRV instruction. Otherwise,
-/// create instruction and replace placeholder if there is one.
+/// When CreatePlaceHolder is true, create a placeholder value which is not
+/// part of the module for SPIRV instruction. Otherwise, create instruction
+/// and record the placeholder, if there is one, for replacement at the end
+/// of the function.
 Value *
 SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
     BasicBlock *BB, bool CreatePlaceHolder){
@@ -1541,16 +1769,9 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
 
   // Creation of place holder
   if (CreatePlaceHolder) {
-    auto GV = new GlobalVariable(*M,
-        transType(BV->getType()),
-        false,
-        GlobalValue::PrivateLinkage,
-        nullptr,
-        std::string(kPlaceholderPrefix) + BV->getName(),
-        0, GlobalVariable::NotThreadLocal, 0);
-    auto LD = new LoadInst(GV, BV->getName(), BB);
-    PlaceholderMap[BV] = LD;
-    return mapValue(BV, LD);
+    auto Placeholder = new Argument(transType(BV->getType()));
+    PlaceholderMap[BV] = Placeholder;
+    return mapValue(BV, Placeholder);
   }
 
   // Translation of instructions
@@ -1630,10 +1851,16 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
 
   case OpStore: {
     SPIRVStore *BS = static_cast<SPIRVStore*>(BV);
+    // Without an explicit memory operand the alignment and volatility are
+    // taken from the decorations of the pointer.
+    SPIRVWord Align = BS->SPIRVMemoryAccess::getAlignment();
+    if (!Align)
+      BS->getDst()->hasAlignment(&Align);
     StoreInst *SI = new StoreInst(transValue(BS->getSrc(), F, BB),
                                   transValue(BS->getDst(), F, BB),
-                                  BS->SPIRVMemoryAccess::isVolatile(),
-                                  BS->SPIRVMemoryAccess::getAlignment(), BB);
+                                  BS->SPIRVMemoryAccess::isVolatile() ||
+                                      BS->getDst()->isVolatile(),
+                                  Align, BB);
     if (BS->SPIRVMemoryAccess::isNonTemporal())
       transNonTemporalMetadata(SI);
     return mapValue(BV, SI);
@@ -1641,9 +1868,13 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
 
   case OpLoad: {
     SPIRVLoad *BL = static_cast<SPIRVLoad*>(BV);
+    SPIRVWord Align = BL->SPIRVMemoryAccess::getAlignment();
+    if (!Align)
+      BL->getSrc()->hasAlignment(&Align);
     LoadInst *LI = new LoadInst(transValue(BL->getSrc(), F, BB), BV->getName(),
-                                BL->SPIRVMemoryAccess::isVolatile(),
-                                BL->SPIRVMemoryAccess::getAlignment(), BB);
+                                BL->SPIRVMemoryAccess::isVolatile() ||
+                                    BL->getSrc()->isVolatile(),
+                                Align, BB);
     if (BL->SPIRVMemoryAccess::isNonTemporal())
       transNonTemporalMetadata(LI);
     return mapValue(BV, LI);
@@ -1892,11 +2123,18 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
   }
 
   case OpExtInst:
+    if (Opts.ExtInstToIntrinsics)
+      if (auto I = transIntrinsicFromExtInst(static_cast<SPIRVExtInst *>(BV),
+          BB))
+        return mapValue(BV, I);
     return mapValue(
         BV, transOCLBuiltinFromExtInst(static_cast<SPIRVExtInst *>(BV), BB));
 
   case OpControlBarrier:
   case OpMemoryBarrier:
+    if (Opts.SPIRVFriendlyIR)
+      return mapValue(BV, transSPIRVBuiltinFromInst(
+          static_cast<SPIRVInstruction *>(BV), BB));
     return mapValue(
         BV, transOCLBarrierFence(static_cast<SPIRVInstruction *>(BV), BB));
 
@@ -1968,7 +2206,8 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
     auto OC = BV->getOpCode();
     if (isSPIRVCmpInstTransToLLVMInst(static_cast<SPIRVInstruction*>(BV))) {
       return mapValue(BV, transCmpInst(BV, BB, F));
-    } else if ((OCLSPIRVBuiltinMap::rfind(OC, nullptr) ||
+    } else if (!Opts.SPIRVFriendlyIR &&
+               (OCLSPIRVBuiltinMap::rfind(OC, nullptr) ||
                 isIntelSubgroupOpCode(OC)) &&
                !isAtomicOpCode(OC) &&
                !isGroupOpCode(OC) &&
@@ -1981,10 +2220,12 @@ SPIRVToLLVM::transValueWithoutDecoration(SPIRVValue *BV, Function *F,
     } else if (isCvtOpCode(OC)) {
         auto BI = static_cast<SPIRVInstruction *>(BV);
         Value *Inst = nullptr;
-        if (BI->hasFPRoundingMode() || BI->isSaturatedConversion())
-          Inst = transOCLBuiltinFromInst(BI, BB);
-        else
+        if (!BI->hasFPRoundingMode() && !BI->isSaturatedConversion())
           Inst = transConvertInst(BV, F, BB);
+        else if (Opts.SPIRVFriendlyIR)
+          Inst = transSPIRVBuiltinFromInst(BI, BB);
+        else
+          Inst = transOCLBuiltinFromInst(BI, BB);
         return mapValue(BV, Inst);
     }
     return mapValue(BV, transSPIRVBuiltinFromInst(
@@ -2038,6 +2279,8 @@ SPIRVToLLVM::transFunction(SPIRVFunction *BF) {
     mapValue(BA, I);
     setName(I, BA);
     BA->foreachAttr([&](SPIRVFuncParamAttrKind Kind){
+      // NoWrite also represents the const qualifier of a kernel argument,
+      // which does not make the pointed memory read-only.
       if (Kind == FunctionParameterAttributeNoWrite)
         return;
       F->addAttribute(I->getArgNo() + 1, SPIRSPIRVFuncParamAttrMap::rmap(Kind));
@@ -2049,6 +2292,12 @@ SPIRVToLLVM::transFunction(SPIRVFunction *BF) {
       Builder.addDereferenceableAttr(MaxOffset);
       F->addAttributes(I->getArgNo() + 1, Builder);
     }
+    SPIRVWord Align = 0;
+    if (I->getType()->isPointerTy() && BA->hasAlignment(&Align) && Align) {
+      AttrBuilder Builder;
+      Builder.addAlignmentAttr(Align);
+      F->addAttributes(I->getArgNo() + 1, Builder);
+    }
   }
   BF->foreachReturnValueAttr([&](SPIRVFuncParamAttrKind Kind){
     if (Kind == FunctionParameterAttributeNoWrite)
@@ -2057,6 +2306,15 @@ SPIRVToLLVM::transFunction(SPIRVFunction *BF) {
         SPIRSPIRVFuncParamAttrMap::rmap(Kind));
   });
 
+  // Callees are translated on demand in the middle of their caller, so keep
+  // the placeholders of the caller apart from the ones of this function.
+  SPIRVToLLVMPlaceholderMap CallerPlaceholders;
+  SPIRVToLLVMResolvedMap CallerResolvedPlaceholders;
+  SPIRVToLLVMLoopMergeVec CallerLoopMerges;
+  std::swap(PlaceholderMap, CallerPlaceholders);
+  std::swap(ResolvedPlaceholders, CallerResolvedPlaceholders);
+  std::swap(LoopMerges, CallerLoopMerges);
+
   // Creating all basic blocks before creating instructions.
   for (size_t I = 0, E = BF->getNumBasicBlock(); I != E; ++I) {
     transValue(BF->getBasicBlock(I), F, nullptr);
@@ -2070,6 +2328,14 @@ SPIRVToLLVM::transFunction(SPIRVFunction *BF) {
       transValue(BInst, F, BB, false);
     }
   }
+  resolvePlaceholders();
+  transLoopMetadata(F);
+  transRestrictMetadata(BF, F);
+  std::swap(PlaceholderMap, CallerPlaceholders);
+  std::swap(ResolvedPlaceholders, CallerResolvedPlaceholders);
+  std::swap(LoopMerges, CallerLoopMerges);
+  if (Opts.ReleaseFunctionBodies)
+    releaseFunctionBody(BF);
   return F;
 }
 
@@ -2130,7 +2396,7 @@ SPIRVToLLVM::transOCLBuiltinPostproc(SPIRVInstruction* BI,
     return postProcessOCLBuildNDRange(BI, CI, DemangledName);
   if (OC == OpGroupAll || OC == OpGroupAny)
     return postProcessGroupAllAny(CI, DemangledName);
-  if (SPIRVEnableStepExpansion &&
+  if (Opts.EnableStepExpansion &&
       (DemangledName == "smoothstep" ||
        DemangledName == "step"))
     return expandOCLBuiltinWithScalarArg(CI, DemangledName);
@@ -2144,7 +2410,8 @@ SPIRVToLLVM::transBuiltinFromInst(const std::string& FuncName,
   auto Ops = BI->getOperands();
   Type* RetTy = BI->hasType() ? transType(BI->getType()) :
       Type::getVoidTy(*Context);
-  transOCLBuiltinFromInstPreproc(BI, RetTy, Ops);
+  if (!Opts.SPIRVFriendlyIR)
+    transOCLBuiltinFromInstPreproc(BI, RetTy, Ops);
   std::vector<Type*> ArgTys = transTypeVector(
       SPIRVInstruction::getOperandTypes(Ops));
   bool HasFuncPtrArg = false;
@@ -2154,12 +2421,19 @@ SPIRVToLLVM::transBuiltinFromInst(const std::string& FuncName,
       HasFuncPtrArg = true;
     }
   }
+  FunctionType* FT = FunctionType::get(RetTy, ArgTys, false);
+  ++NumBuiltinDeclLookups;
+  auto &Decl = BuiltinDeclMap[std::make_pair(FuncName, FT)];
+  Function* Func = cast_or_null<Function>(Decl.Func);
+  if (Func && Func->getName() == Decl.MangledName) {
+    ++NumBuiltinDeclCacheHits;
+    return transBuiltinCall(Func, BI, Ops, BB, FuncName);
+  }
   if (!HasFuncPtrArg)
     MangleOpenCLBuiltin(FuncName, ArgTys, MangledName);
   else
     MangledName = decorateSPIRVFunction(FuncName);
-  Function* Func = M->getFunction(MangledName);
-  FunctionType* FT = FunctionType::get(RetTy, ArgTys, false);
+  Func = M->getFunction(MangledName);
   // ToDo: Some intermediate functions have duplicate names with
   // different function types. This is OK if the function name
   // is used internally and finally translated to unique function
@@ -2182,15 +2456,24 @@ SPIRVToLLVM::transBuiltinFromInst(const std::string& FuncName,
     if (isFuncNoUnwind())
       Func->addFnAttr(Attribute::NoUnwind);
   }
+  Decl.Func = Func;
+  Decl.MangledName = Func->getName();
+  return transBuiltinCall(Func, BI, Ops, BB, FuncName);
+}
+
+Instruction *
+SPIRVToLLVM::transBuiltinCall(Function *Func, SPIRVInstruction *BI,
+    const std::vector<SPIRVValue *> &Ops, BasicBlock *BB,
+    const std::string &FuncName) {
   auto Call = CallInst::Create(Func,
       transValue(Ops, BB->getParent(), BB), "", BB);
   setName(Call, BI);
   setAttrByCalledFunc(Call);
   SPIRVDBG(spvdbgs() << "[transInstToBuiltinCall] " << *BI << " -> "; dbgs() <<
       *Call << '\n';)
-  Instruction *Inst = Call;
-  Inst = transOCLBuiltinPostproc(BI, Call, BB, FuncName);
-  return Inst;
+  if (Opts.SPIRVFriendlyIR)
+    return Call;
+  return transOCLBuiltinPostproc(BI, Call, BB, FuncName);
 }
 
 std::string
@@ -2268,6 +2551,31 @@ SPIRVToLLVM::transOCLBuiltinFromInst(SPIRVInstruction *BI, BasicBlock *BB) {
   return transBuiltinFromInst(FuncName, BI, BB);
 }
 
+std::string
+SPIRVToLLVM::getSPIRVBuiltinPostfix(SPIRVInstruction *BI) {
+  auto OC = BI->getOpCode();
+  std::string Postfix;
+  if (OC == OpGenericCastToPtrExplicit) {
+    auto AddrSpace = SPIRSPIRVAddrSpaceMap::rmap(
+        BI->getType()->getPointerStorageClass());
+    return std::string(kSPIRVPostfix::Divider) + "To" +
+        SPIRAddrSpaceCapitalizedNameMap::map(AddrSpace);
+  }
+  if (!isCvtOpCode(OC) && OC != OpImageSampleExplicitLod && OC != OpImageRead)
+    return Postfix;
+  bool IsSigned = OC == OpConvertFToS || OC == OpSConvert ||
+      OC == OpSatConvertUToS;
+  Postfix = std::string(kSPIRVPostfix::Divider) +
+      getPostfixForReturnType(transType(BI->getType()), IsSigned);
+  if (BI->isSaturatedConversion())
+    Postfix += std::string(kSPIRVPostfix::Divider) + kSPIRVPostfix::Sat;
+  SPIRVFPRoundingModeKind Kind;
+  if (BI->hasFPRoundingMode(&Kind))
+    Postfix += kSPIRVPostfix::Divider + getPostfix(DecorationFPRoundingMode,
+        Kind);
+  return Postfix;
+}
+
 Instruction *
 SPIRVToLLVM::transSPIRVBuiltinFromInst(SPIRVInstruction *BI, BasicBlock *BB) {
   assert(BB && "Invalid BB");
@@ -2283,6 +2591,8 @@ SPIRVToLLVM::transSPIRVBuiltinFromInst(SPIRVInstruction *BI, BasicBlock *BB) {
     case AccessQualifierReadWrite: Suffix = "_read_write"; break;
     }
   }
+  if (Opts.SPIRVFriendlyIR)
+    Suffix += getSPIRVBuiltinPostfix(BI);
 
   return transBuiltinFromInst(getSPIRVFuncName(BI->getOpCode(), Suffix), BI, BB);
 }
@@ -2295,14 +2605,28 @@ SPIRVToLLVM::translate() {
   DbgTran.createCompileUnit();
   DbgTran.addDbgInfoVersion();
 
-  for (unsigned I = 0, E = BM->getNumVariables(); I != E; ++I) {
-    auto BV = BM->getVariable(I);
-    if (BV->getStorageClass() != StorageClassFunction)
-      transValue(BV, nullptr, nullptr);
-  }
+  if (!Opts.KernelName.empty()) {
+    // Callees and global variables are translated on demand when they are
+    // referenced, so translating the kernel pulls in exactly what it uses.
+    SPIRVFunction *Kernel = nullptr;
+    for (unsigned I = 0, E = BM->getNumEntryPoints(ExecutionModelKernel);
+        I != E && !Kernel; ++I) {
+      auto BF = BM->getEntryPoint(ExecutionModelKernel, I);
+      if (BF->getName() == Opts.KernelName)
+        Kernel = BF;
+    }
+    SPIRVCKRT(Kernel, InvalidKernelName, Opts.KernelName);
+    transFunction(Kernel);
+  } else {
+    for (unsigned I = 0, E = BM->getNumVariables(); I != E; ++I) {
+      auto BV = BM->getVariable(I);
+      if (BV->getStorageClass() != StorageClassFunction)
+        transValue(BV, nullptr, nullptr);
+    }
 
-  for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
-    transFunction(BM->getFunction(I));
+    for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
+      transFunction(BM->getFunction(I));
+    }
   }
   if (!transKernelMetadata())
     return false;
@@ -2313,7 +2637,7 @@ SPIRVToLLVM::translate() {
   if (!transSourceExtension())
     return false;
   transGeneratorMD();
-  if (!transOCLBuiltinsFromVariables())
+  if (!Opts.SPIRVFriendlyIR && !transOCLBuiltinsFromVariables())
     return false;
   if (!postProcessOCL())
     return false;
@@ -2356,7 +2680,7 @@ SPIRVToLLVM::transFPContractMetadata() {
   bool ContractOff = false;
   for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
     SPIRVFunction *BF = BM->getFunction(I);
-    if (!isOpenCLKernel(BF))
+    if (!isOpenCLKernel(BF) || !getTranslatedValue(BF))
       continue;
     if (BF->getExecutionMode(ExecutionModeContractionOff)) {
       ContractOff = true;
@@ -2388,7 +2712,11 @@ SPIRVToLLVM::transKernelMetadata() {
   for (unsigned I = 0, E = BM->getNumFunctions(); I != E; ++I) {
     SPIRVFunction *BF = BM->getFunction(I);
     Function *F = static_cast<Function *>(getTranslatedValue(BF));
-    assert(F && "Invalid translated function");
+    // Only a subset of the functions is translated in kernel extraction mode.
+    if (!F) {
+      assert(!Opts.KernelName.empty() && "Invalid translated function");
+      continue;
+    }
     if (F->getCallingConv() != CallingConv::SPIR_KERNEL)
       continue;
     std::vector<llvm::Metadata*> KernelMD;
@@ -2463,7 +2791,7 @@ SPIRVToLLVM::transKernelMetadata() {
       return transOCLKernelArgTypeName(Arg);
     });
     // Generate metadata for kernel_arg_name
-    if (SPIRVGenKernelArgNameMD) {
+    if (Opts.GenKernelArgNameMD) {
       bool ArgHasName = true;
       BF->foreachArgument([&](SPIRVFunctionParameter *Arg){
         ArgHasName &= !Arg->getName().empty();
@@ -2623,6 +2951,32 @@ SPIRVToLLVM::transOCLBuiltinFromExtInst(SPIRVExtInst *BC, BasicBlock *BB) {
   return transOCLBuiltinPostproc(BC, Call, BB, UnmangledName);
 }
 
+/// Translate an OpenCL.std extended instruction to a call of the LLVM
+/// intrinsic it was translated from, if it has one.
+/// \returns nullptr if the instruction has no intrinsic counterpart, or if
+/// its operands do not all have the type of its result.
+Instruction *
+SPIRVToLLVM::transIntrinsicFromExtInst(SPIRVExtInst *BC, BasicBlock *BB) {
+  Intrinsic::ID IID;
+  if (BM->getBuiltinSet(BC->getExtSetId()) != SPIRVEIS_OpenCL ||
+      !LLVMIntrinsicOCLExtOpMap::rfind(static_cast<OCLExtOpKind>(
+          BC->getExtOp()), &IID))
+    return nullptr;
+  auto BArgs = BC->getArguments();
+  auto BTy = BC->getType();
+  for (auto BArgTy : BC->getValueTypes(BArgs))
+    if (BArgTy != BTy)
+      return nullptr;
+
+  auto Ty = transType(BTy);
+  auto Args = transValue(BC->getValues(BArgs), BB->getParent(), BB);
+  // The result of clz and ctz is defined for zero.
+  if (IID == Intrinsic::ctlz || IID == Intrinsic::cttz)
+    Args.push_back(ConstantInt::getFalse(*Context));
+  auto F = Intrinsic::getDeclaration(M, IID, Ty);
+  return CallInst::Create(F, Args, BC->getName(), BB);
+}
+
 CallInst *
 SPIRVToLLVM::transOCLBarrier(BasicBlock *BB, SPIRVWord ExecScope,
                              SPIRVWord MemSema, SPIRVWord MemScope) {
@@ -2876,6 +3230,8 @@ SPIRVToLLVM::transLinkageType(const SPIRVValue* V) {
 }
 
 Instruction *SPIRVToLLVM::transOCLAllAny(SPIRVInstruction *I, BasicBlock *BB) {
+  if (Opts.SPIRVFriendlyIR)
+    return cast<Instruction>(mapValue(I, transSPIRVBuiltinFromInst(I, BB)));
   CallInst *CI = cast<CallInst>(transSPIRVBuiltinFromInst(I, BB));
   AttributeList Attrs = CI->getCalledFunction()->getAttributes();
   return cast<Instruction>(mapValue(
@@ -2900,6 +3256,8 @@ Instruction *SPIRVToLLVM::transOCLAllAny(SPIRVInstruction *I, BasicBlock *BB) {
 }
 
 Instruction *SPIRVToLLVM::transOCLRelational(SPIRVInstruction *I, BasicBlock *BB) {
+  if (Opts.SPIRVFriendlyIR)
+    return cast<Instruction>(mapValue(I, transSPIRVBuiltinFromInst(I, BB)));
   CallInst *CI = cast<CallInst>(transSPIRVBuiltinFromInst(I, BB));
   AttributeList Attrs = CI->getCalledFunction()->getAttributes();
   return cast<Instruction>(mapValue(
@@ -2938,21 +3296,32 @@ Instruction *SPIRVToLLVM::transOCLRelational(SPIRVInstruction *I, BasicBlock *BB
 bool
 llvm::ReadSPIRV(LLVMContext &C, std::istream &IS, Module *&M,
     std::string &ErrMsg) {
+  return ReadSPIRV(C, IS, getDefaultTranslatorOptions(), M, ErrMsg);
+}
+
+static bool
+readSPIRV(LLVMContext &C, std::istream &IS, const TranslatorOptions &Opts,
+    Module *&M, std::string &ErrMsg) {
   M = new Module("", C);
   std::unique_ptr<SPIRVModule> BM(SPIRVModule::createSPIRVModule());
 
   IS >> *BM;
 
-  SPIRVToLLVM BTL(M, BM.get());
+  SPIRVToLLVM BTL(M, BM.get(), Opts);
   bool Succeed = true;
   if (!BTL.translate()) {
     BM->getError(ErrMsg);
     Succeed = false;
   }
-  legacy::PassManager PassMgr;
-  PassMgr.add(createSPIRVToOCL20());
-  PassMgr.add(createOCL20To12());
-  PassMgr.run(*M);
+  if (!Opts.SPIRVFriendlyIR) {
+    legacy::PassManager PassMgr;
+    PassMgr.add(createSPIRVToOCL20(Opts));
+    PassMgr.add(createOCL20To12(Opts));
+    PassMgr.run(*M);
+  }
+  if (Succeed && !verifyTranslatedModule(*M, Opts, VerifyEndOfPipeline,
+      "SPIR-V to LLVM translation", &ErrMsg))
+    Succeed = false;
 
   if (DbgSaveTmpLLVM)
     dumpLLVM(M, DbgTmpLLVMFileName);
@@ -2962,3 +3331,60 @@ llvm::ReadSPIRV(LLVMContext &C, std::istream &IS, Module *&M,
   }
   return Succeed;
 }
+
+/// Translate the SPIR-V binary \p Input, looking up and storing the bitcode
+/// of the resulting module in the translation cache.
+static bool
+readSPIRVCached(LLVMContext &C, StringRef Input, const TranslatorOptions &Opts,
+    Module *&M, std::string &ErrMsg) {
+  SPIRVTranslationCache Cache(Opts, "spirv-to-llvm", Input);
+  // Translate again if the entry can not be parsed.
+  if (Cache.lookup([&](StringRef Entry) -> bool {
+        auto ModOrErr = parseBitcodeFile(MemoryBufferRef(Entry, ""), C);
+        if (!ModOrErr) {
+          consumeError(ModOrErr.takeError());
+          return false;
+        }
+        M = ModOrErr->release();
+        return true;
+      }))
+    return true;
+
+  SPIRVMemoryStreamBuf Buf(Input.data(), Input.size());
+  std::istream IS(&Buf);
+  if (!readSPIRV(C, IS, Opts, M, ErrMsg))
+    return false;
+  std::string Bitcode;
+  raw_string_ostream BitcodeOS(Bitcode);
+  WriteBitcodeToFile(M, BitcodeOS);
+  Cache.store(BitcodeOS.str());
+  return true;
+}
+
+bool
+llvm::ReadSPIRV(LLVMContext &C, std::istream &IS,
+    const TranslatorOptions &Opts, Module *&M, std::string &ErrMsg) {
+  if (Opts.CacheDir.empty())
+    return readSPIRV(C, IS, Opts, M, ErrMsg);
+  std::string Input((std::istreambuf_iterator<char>(IS)),
+      std::istreambuf_iterator<char>());
+  return readSPIRVCached(C, Input, Opts, M, ErrMsg);
+}
+
+bool
+llvm::ReadSPIRV(LLVMContext &C, ArrayRef<uint32_t> Words, Module *&M,
+    std::string &ErrMsg) {
+  return ReadSPIRV(C, Words, getDefaultTranslatorOptions(), M, ErrMsg);
+}
+
+bool
+llvm::ReadSPIRV(LLVMContext &C, ArrayRef<uint32_t> Words,
+    const TranslatorOptions &Opts, Module *&M, std::string &ErrMsg) {
+  StringRef Input(reinterpret_cast<const char *>(Words.data()),
+      Words.size() * sizeof(uint32_t));
+  if (!Opts.CacheDir.empty())
+    return readSPIRVCached(C, Input, Opts, M, ErrMsg);
+  SPIRVMemoryStreamBuf Buf(Input.data(), Input.size());
+  std::istream IS(&Buf);
+  return readSPIRV(C, IS, Opts, M, ErrMsg);
+}
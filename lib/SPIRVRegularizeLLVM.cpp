@@ -67,7 +67,9 @@ static std::string RegularizedModuleTmpFile = "regularized.bc";
 
 class SPIRVRegularizeLLVM: public ModulePass {
 public:
-  SPIRVRegularizeLLVM():ModulePass(ID), M(nullptr), Ctx(nullptr) {
+  SPIRVRegularizeLLVM(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), Opts(TheOpts) {
     initializeSPIRVRegularizeLLVMPass(*PassRegistry::getPassRegistry());
   }
 
@@ -85,6 +87,7 @@ public:
 private:
   Module *M;
   LLVMContext *Ctx;
+  TranslatorOptions Opts;
 };
 
 char SPIRVRegularizeLLVM::ID = 0;
@@ -98,11 +101,7 @@ SPIRVRegularizeLLVM::runOnModule(Module& Module) {
   regularize();
 
   DEBUG(dbgs() << "After SPIRVRegularizeLLVM:\n" << *M);
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "SPIRVRegularizeLLVM");
   return true;
 }
 
@@ -156,13 +155,6 @@ SPIRVRegularizeLLVM::regularize() {
     }
   }
 
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    SPIRVDBG(errs() << "Fails to verify module: " << ErrorOS.str();)
-    return false;
-  }
-
   if (SPIRVDbgSaveRegularizedModule)
     saveLLVMModule(M, RegularizedModuleTmpFile);
   return true;
@@ -211,6 +203,6 @@ SPIRVRegularizeLLVM::lowerFuncPtr(Module* M) {
 INITIALIZE_PASS(SPIRVRegularizeLLVM, "spvregular",
     "Regularize LLVM for SPIR-V", false, false)
 
-ModulePass *llvm::createSPIRVRegularizeLLVM() {
-  return new SPIRVRegularizeLLVM();
+ModulePass *llvm::createSPIRVRegularizeLLVM(const TranslatorOptions &Opts) {
+  return new SPIRVRegularizeLLVM(Opts);
 }
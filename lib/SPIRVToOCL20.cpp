@@ -58,14 +58,18 @@ using namespace OCLUtil;
 
 namespace SPIRV {
 
-static cl::opt<std::string>
+static cl::opt<std::string, true>
 MangledAtomicTypeNamePrefix("spirv-atomic-prefix",
-    cl::desc("Mangled atomic type name prefix"), cl::init("U7_Atomic"));
+    cl::desc("Mangled atomic type name prefix"),
+    cl::location(
+        getMutableDefaultTranslatorOptions().MangledAtomicTypeNamePrefix));
 
 class SPIRVToOCL20: public ModulePass,
   public InstVisitor<SPIRVToOCL20> {
 public:
-  SPIRVToOCL20():ModulePass(ID), M(nullptr), Ctx(nullptr) {
+  SPIRVToOCL20(const TranslatorOptions &TheOpts =
+      getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), Opts(TheOpts) {
     initializeSPIRVToOCL20Pass(*PassRegistry::getPassRegistry());
   }
   virtual bool runOnModule(Module &M);
@@ -119,7 +123,7 @@ public:
   void visitCallSPIRVBuiltin(CallInst *CI, Op OC);
 
   /// Translate mangled atomic type name: "atomic_" =>
-  ///   MangledAtomicTypeNamePrefix
+  ///   Opts.MangledAtomicTypeNamePrefix
   void translateMangledAtomicTypeName();
 
   /// Get prefix work_/sub_ for OCL group builtin functions.
@@ -131,6 +135,7 @@ public:
 private:
   Module *M;
   LLVMContext *Ctx;
+  TranslatorOptions Opts;
 };
 
 char SPIRVToOCL20::ID = 0;
@@ -147,11 +152,7 @@ SPIRVToOCL20::runOnModule(Module& Module) {
 
   DEBUG(dbgs() << "After SPIRVToOCL20:\n" << *M);
 
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "SPIRVToOCL20");
   return true;
 }
 
@@ -485,7 +486,7 @@ void SPIRVToOCL20::translateMangledAtomicTypeName() {
     auto Loc = MangledName.find(kOCLBuiltinName::AtomPrefix);
     Loc = MangledName.find(kMangledName::AtomicPrefixInternal, Loc);
     MangledName.replace(Loc, strlen(kMangledName::AtomicPrefixInternal),
-        MangledAtomicTypeNamePrefix);
+        Opts.MangledAtomicTypeNamePrefix);
     I.setName(MangledName);
   }
 }
@@ -549,6 +550,6 @@ void SPIRVToOCL20::visitCastInst(CastInst &Cast) {
 INITIALIZE_PASS(SPIRVToOCL20, "spvtoocl20",
     "Translate SPIR-V builtins to OCL 2.0 builtins", false, false)
 
-ModulePass *llvm::createSPIRVToOCL20() {
-  return new SPIRVToOCL20();
+ModulePass *llvm::createSPIRVToOCL20(const TranslatorOptions &Opts) {
+  return new SPIRVToOCL20(Opts);
 }
@@ -0,0 +1,231 @@
+//===- SPIRVTranslationCache.cpp - On-disk translation cache ----------------===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file implements the on-disk cache of LLVM/SPIR-V translation results
+// used by WriteSPIRV and ReadSPIRV.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SPIRVInternal.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <tuple>
+#include <vector>
+
+// Defines SPIRV_SOURCE_HASH, the SHA1 of the sources of the translator,
+// which is generated by the build.
+#ifdef SPIRV_HAVE_SOURCE_HASH
+#include "SPIRVSourceHash.inc"
+#else
+#define SPIRV_SOURCE_HASH ""
+#endif
+
+#define DEBUG_TYPE "spirv"
+
+STATISTIC(NumTranslationCacheHits,
+    "Number of translations found in the translation cache");
+STATISTIC(NumTranslationCacheMisses,
+    "Number of translations not found in the translation cache");
+
+// Also counted in release builds, for the timing report of llvm-spirv.
+static std::atomic<uint64_t> TranslationCacheHits(0);
+static std::atomic<uint64_t> TranslationCacheMisses(0);
+
+using namespace llvm;
+
+namespace SPIRV {
+
+cl::opt<std::string, true>
+TranslationCacheDir("spirv-cache-dir",
+    cl::desc("Directory of the on-disk translation cache (the cache is "
+             "disabled if not set)"),
+    cl::value_desc("directory"),
+    cl::location(getMutableDefaultTranslatorOptions().CacheDir));
+
+cl::opt<unsigned, true>
+TranslationCacheMaxSize("spirv-cache-max-size",
+    cl::desc("Size limit of the on-disk translation cache in megabytes "
+             "(0 for no limit)"),
+    cl::location(getMutableDefaultTranslatorOptions().CacheMaxSizeMB));
+
+cl::opt<bool, true>
+TranslationCacheFunctions("spirv-function-cache",
+    cl::desc("Reuse the SPIR-V of unchanged functions from the translation "
+             "cache"),
+    cl::location(getMutableDefaultTranslatorOptions().FunctionCache));
+
+static cl::opt<std::string>
+TranslationCacheVersion("spirv-cache-version", cl::Hidden,
+    cl::desc("Translator version written into the translation cache key "
+             "instead of the actual one (for testing)"),
+    cl::value_desc("version"));
+
+#ifdef _SPIRV_SUPPORT_TEXT_FMT
+extern bool SPIRVUseTextFormat;
+#endif
+
+static const char TmpSuffix[] = ".tmp";
+
+SPIRVTranslationCache::SPIRVTranslationCache(const TranslatorOptions &Opts,
+    StringRef Kind, StringRef Input)
+  :Dir(Opts.CacheDir), MaxSize(uint64_t(Opts.CacheMaxSizeMB) << 20) {
+  if (Dir.empty())
+    return;
+  std::string Key;
+  raw_string_ostream KeyOS(Key);
+  // Results of another version of the translator are not reused. The source
+  // hash catches changes of the generated code which did not bump
+  // kTranslatorVer.
+  KeyOS << Kind << ' ';
+  if (TranslationCacheVersion.empty())
+    KeyOS << kTranslatorVer << ' ' << SPIRV_SOURCE_HASH;
+  else
+    KeyOS << TranslationCacheVersion;
+  KeyOS << ' ';
+  Opts.writeKey(KeyOS);
+#ifdef _SPIRV_SUPPORT_TEXT_FMT
+  KeyOS << SPIRVUseTextFormat;
+#endif
+  KeyOS << ' ' << Input.size() << ':';
+  SHA1 Hash;
+  Hash.update(KeyOS.str());
+  Hash.update(Input);
+  SmallString<128> P(Dir);
+  sys::path::append(P, toHex(Hash.final()));
+  Path = P.str();
+}
+
+void
+getTranslationCacheStats(uint64_t &Hits, uint64_t &Misses) {
+  Hits = TranslationCacheHits;
+  Misses = TranslationCacheMisses;
+}
+
+bool
+SPIRVTranslationCache::lookup(std::function<bool(StringRef Entry)> Use) {
+  NamedRegionTimer T("cache-lookup", "Translation cache lookup", "spirv",
+      "SPIR-V translator", TimePassesIsEnabled);
+  // An entry which can not be used is a miss like a missing one, since the
+  // translation runs anyway.
+  auto Buf = MemoryBuffer::getFile(Path);
+  if (!Buf || !Use((*Buf)->getBuffer())) {
+    ++NumTranslationCacheMisses;
+    ++TranslationCacheMisses;
+    return false;
+  }
+  ++NumTranslationCacheHits;
+  ++TranslationCacheHits;
+  // The modification time of an entry is the time it was last used.
+  int FD;
+  if (!sys::fs::openFileForWrite(Path, FD, sys::fs::F_Append)) {
+    sys::fs::setLastModificationAndAccessTime(FD,
+        sys::TimePoint<>(std::chrono::system_clock::now()));
+    sys::Process::SafelyCloseFileDescriptor(FD);
+  }
+  return true;
+}
+
+void
+SPIRVTranslationCache::store(StringRef Result, bool Prune) {
+  NamedRegionTimer T("cache-store", "Translation cache store", "spirv",
+      "SPIR-V translator", TimePassesIsEnabled);
+  if (sys::fs::create_directories(Dir))
+    return;
+  int FD;
+  SmallString<128> TmpPath;
+  if (sys::fs::createUniqueFile(Path + "-%%%%%%" + TmpSuffix, FD, TmpPath))
+    return;
+  {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Result;
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TmpPath);
+      return;
+    }
+  }
+  // Readers see either no entry or a complete one.
+  if (sys::fs::rename(TmpPath, Path)) {
+    sys::fs::remove(TmpPath);
+    return;
+  }
+  if (Prune)
+    prune();
+}
+
+void
+SPIRVTranslationCache::prune() {
+  if (!MaxSize)
+    return;
+  std::vector<std::tuple<sys::TimePoint<>, uint64_t, std::string>> Entries;
+  uint64_t TotalSize = 0;
+  std::error_code EC;
+  for (sys::fs::directory_iterator I(Dir, EC), E; I != E && !EC;
+      I.increment(EC)) {
+    if (StringRef(I->path()).endswith(TmpSuffix))
+      continue;
+    sys::fs::file_status Status;
+    if (I->status(Status) || !sys::fs::is_regular_file(Status))
+      continue;
+    Entries.push_back(std::make_tuple(Status.getLastModificationTime(),
+        Status.getSize(), I->path()));
+    TotalSize += Status.getSize();
+  }
+  if (TotalSize <= MaxSize)
+    return;
+  std::sort(Entries.begin(), Entries.end());
+  for (auto &Entry : Entries) {
+    if (TotalSize <= MaxSize)
+      break;
+    // Another process may have removed the entry already.
+    sys::fs::remove(std::get<2>(Entry));
+    TotalSize -= std::get<1>(Entry);
+  }
+}
+
+} // namespace SPIRV
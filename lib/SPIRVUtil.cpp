@@ -44,22 +44,37 @@
 #include "SPIRVMDWalker.h"
 #include "OCLUtil.h"
 
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <atomic>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 
 #define DEBUG_TYPE "spirv"
 
+STATISTIC(NumMangleCacheHits,
+    "Number of builtin names found in the mangle cache");
+STATISTIC(NumMangleCacheMisses, "Number of builtin names mangled");
+
 namespace SPIRV{
 
 #ifdef _SPIRV_SUPPORT_TEXT_FMT
@@ -76,6 +91,55 @@ EnableDbgOutput("spirv-debug",
     cl::location(SPIRVDbgEnable));
 #endif
 
+TranslatorOptions &
+getMutableDefaultTranslatorOptions() {
+  static TranslatorOptions Opts;
+  return Opts;
+}
+
+const TranslatorOptions &
+getDefaultTranslatorOptions() {
+  return getMutableDefaultTranslatorOptions();
+}
+
+cl::opt<VerifyPolicyKind, true>
+VerifyPolicy("spirv-verify",
+    cl::desc("Verify LLVM module during LLVM/SPIR-V translation"),
+    cl::values(
+        clEnumValN(VerifyNone, "none", "Do not verify"),
+        clEnumValN(VerifyEndOfPipeline, "end",
+            "Verify after the translation pipeline"),
+        clEnumValN(VerifyAfterEachPass, "each-pass",
+            "Verify after each translator pass")),
+    cl::location(getMutableDefaultTranslatorOptions().Verify));
+
+cl::opt<unsigned>
+MangleCacheSize("spirv-mangle-cache-size",
+    cl::desc("Maximum number of mangled builtin names cached across "
+             "translations (0 disables the cache)"),
+    cl::init(4096));
+
+bool
+verifyTranslatedModule(Module &M, const TranslatorOptions &Opts,
+    VerifyPolicyKind When, StringRef Stage, std::string *ErrMsg) {
+  // Verifying after each pass includes verifying at the end of the pipeline.
+  if (Opts.Verify < When)
+    return true;
+  NamedRegionTimer T("verify", "Verify module", "spirv", "SPIR-V translator",
+      TimePassesIsEnabled);
+  std::string Err;
+  raw_string_ostream ErrorOS(Err);
+  if (verifyModule(M, &ErrorOS)) {
+    std::string Msg = "Fails to verify module after " + Stage.str() + ": " +
+        ErrorOS.str();
+    if (!ErrMsg)
+      report_fatal_error(Msg.c_str(), false);
+    *ErrMsg = Msg;
+    return false;
+  }
+  return true;
+}
+
 void
 addFnAttr(LLVMContext *Context, CallInst *Call, Attribute::AttrKind Attr) {
   Call->addAttribute(AttributeList::FunctionIndex, Attr);
@@ -590,6 +654,45 @@ isLastFuncParamSigned(const std::string& MangledName) {
 }
 
 
+SPIR::TypePrimitiveEnum
+getDescBasePrimitive(const SPIR::ParamType *T) {
+  for (;;) {
+    if (auto PT = SPIR::dyn_cast<SPIR::PointerType>(T))
+      T = &*PT->getPointee();
+    else if (auto VT = SPIR::dyn_cast<SPIR::VectorType>(T))
+      T = &*VT->getScalarType();
+    else if (auto AT = SPIR::dyn_cast<SPIR::AtomicType>(T))
+      T = &*AT->getBaseType();
+    else
+      break;
+  }
+  if (auto Prim = SPIR::dyn_cast<SPIR::PrimitiveType>(T))
+    return Prim->getPrimitive();
+  return SPIR::PRIMITIVE_NONE;
+}
+
+bool
+isDescTypeUnsigned(const SPIR::ParamType *T) {
+  switch (getDescBasePrimitive(T)) {
+  case SPIR::PRIMITIVE_UCHAR:
+  case SPIR::PRIMITIVE_USHORT:
+  case SPIR::PRIMITIVE_UINT:
+  case SPIR::PRIMITIVE_ULONG:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool
+hasParamOfPrimitive(const SPIR::FunctionDescriptor &Desc,
+    std::function<bool(SPIR::TypePrimitiveEnum)> Pred) {
+  for (auto &P : Desc.parameters)
+    if (Pred(getDescBasePrimitive(&*P)))
+      return true;
+  return false;
+}
+
 // Check if a mangled function name contains unsigned atomic type
 bool
 containsUnsignedAtomicType(StringRef Name) {
@@ -600,6 +703,28 @@ containsUnsignedAtomicType(StringRef Name) {
       kMangledName::AtomicPrefixIncoming)]);
 }
 
+bool
+hasUnsignedAtomicParam(const SPIR::FunctionDescriptor &Desc) {
+  for (auto &P : Desc.parameters) {
+    const SPIR::ParamType *T = &*P;
+    while (auto PT = SPIR::dyn_cast<SPIR::PointerType>(T))
+      T = &*PT->getPointee();
+    if (SPIR::dyn_cast<SPIR::AtomicType>(T) && isDescTypeUnsigned(T))
+      return true;
+  }
+  return false;
+}
+
+const SPIR::FunctionDescriptor *
+OCLBuiltinDescCache::get(Function *F) {
+  auto &E = Descs[F];
+  if (E.MangledName != F->getName()) {
+    E.MangledName = F->getName();
+    E.IsValid = SPIR::demangle(E.MangledName, E.Desc) == SPIR::MANGLE_SUCCESS;
+  }
+  return E.IsValid ? &E.Desc : nullptr;
+}
+
 bool
 isFunctionPointerType(Type *T) {
   if (isa<PointerType>(T) &&
@@ -975,57 +1100,156 @@ getOCLTypePrimitiveEnum(StringRef TyName) {
     .Case("struct.ndrange_t",         SPIR::PRIMITIVE_NDRANGE_T)
     .Default(                         SPIR::PRIMITIVE_NONE);
 }
+namespace {
+/// Pool of immutable descriptors for mangler types.
+///
+/// Primitive types, and pointers, vectors and atomics built from pooled types,
+/// are created once per process and handed out as unmanaged references, so
+/// translating argument types which have been seen before allocates nothing.
+/// Types built from user defined structs are not pooled since their names
+/// are unbounded; they are reference counted as before.
+class MangleTypeDescPool {
+public:
+  static MangleTypeDescPool &get() {
+    static MangleTypeDescPool Pool;
+    return Pool;
+  }
+
+  SPIR::RefParamType getPrimitive(SPIR::TypePrimitiveEnum Prim) {
+    return intern(SPIR::TYPE_ID_PRIMITIVE, nullptr, Prim, [=]() {
+      return new SPIR::PrimitiveType(Prim);
+    });
+  }
+
+  SPIR::RefParamType getPointer(const SPIR::RefParamType &Pointee,
+      SPIR::TypeAttributeEnum AddrSpace, unsigned Attr = 0) {
+    auto Create = [&]() {
+      auto PT = new SPIR::PointerType(Pointee);
+      PT->setAddressSpace(AddrSpace);
+      for (unsigned I = SPIR::ATTR_QUALIFIER_FIRST,
+          E = SPIR::ATTR_QUALIFIER_LAST; I <= E; ++I)
+        PT->setQualifier(static_cast<SPIR::TypeAttributeEnum>(I), I & Attr);
+      return PT;
+    };
+    if (!Pointee.isUnmanaged())
+      return SPIR::RefParamType(Create());
+    unsigned Quals = 0;
+    for (unsigned I = SPIR::ATTR_QUALIFIER_FIRST,
+        E = SPIR::ATTR_QUALIFIER_LAST; I <= E; ++I)
+      if (I & Attr)
+        Quals |= 1U << I;
+    return intern(SPIR::TYPE_ID_POINTER, &*Pointee, (Quals << 8) | AddrSpace,
+        Create);
+  }
+
+  SPIR::RefParamType getVector(const SPIR::RefParamType &Elem, unsigned Len) {
+    auto Create = [&]() {
+      return new SPIR::VectorType(Elem, Len);
+    };
+    if (!Elem.isUnmanaged())
+      return SPIR::RefParamType(Create());
+    return intern(SPIR::TYPE_ID_VECTOR, &*Elem, Len, Create);
+  }
+
+  SPIR::RefParamType getAtomic(const SPIR::RefParamType &Base) {
+    auto Create = [&]() {
+      return new SPIR::AtomicType(Base);
+    };
+    if (!Base.isUnmanaged())
+      return SPIR::RefParamType(Create());
+    return intern(SPIR::TYPE_ID_ATOMIC, &*Base, 0, Create);
+  }
+
+  /// \param LocalArgs indicates the block takes local memory arguments, i.e.
+  ///   "void (__local void *, ...)".
+  SPIR::RefParamType getBlock(bool LocalArgs) {
+    return intern(SPIR::TYPE_ID_BLOCK, nullptr, LocalArgs, [&]() {
+      auto BlockTy = new SPIR::BlockType;
+      if (LocalArgs) {
+        BlockTy->setParam(0, getPointer(getPrimitive(SPIR::PRIMITIVE_VOID),
+            SPIR::ATTR_LOCAL));
+        BlockTy->setParam(1, getPrimitive(SPIR::PRIMITIVE_VAR_ARG));
+      }
+      return BlockTy;
+    });
+  }
+
+private:
+  typedef std::tuple<unsigned, const SPIR::ParamType *, unsigned> KeyTy;
+
+  template<class CreateTy>
+  SPIR::RefParamType intern(SPIR::TypeEnum Kind, const SPIR::ParamType *Child,
+      unsigned Extra, CreateTy Create) {
+    KeyTy Key(Kind, Child, Extra);
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      auto Loc = Types.find(Key);
+      if (Loc != Types.end())
+        return SPIR::RefParamType::unmanaged(Loc->second.get());
+    }
+    // Creating a block interns its parameters, so the lock is not held here.
+    std::unique_ptr<SPIR::ParamType> New(Create());
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto &Entry = Types[Key];
+    if (!Entry)
+      Entry = std::move(New);
+    return SPIR::RefParamType::unmanaged(Entry.get());
+  }
+
+  std::mutex Mutex;
+  std::map<KeyTy, std::unique_ptr<SPIR::ParamType>> Types;
+};
+} // anonymous namespace
+
 /// Translates LLVM type to descriptor for mangler.
 /// \param Signed indicates integer type should be translated as signed.
 /// \param VoidPtr indicates i8* should be translated as void*.
 static SPIR::RefParamType
 transTypeDesc(Type *Ty, const BuiltinArgTypeMangleInfo &Info) {
+  auto &Pool = MangleTypeDescPool::get();
   bool Signed = Info.IsSigned;
   unsigned Attr = Info.Attr;
   bool VoidPtr = Info.IsVoidPtr;
   if (Info.IsEnum)
-    return SPIR::RefParamType(new SPIR::PrimitiveType(Info.Enum));
+    return Pool.getPrimitive(Info.Enum);
   if (Info.IsSampler)
-    return SPIR::RefParamType(new SPIR::PrimitiveType(
-        SPIR::PRIMITIVE_SAMPLER_T));
+    return Pool.getPrimitive(SPIR::PRIMITIVE_SAMPLER_T);
   if (Info.IsAtomic && !Ty->isPointerTy()) {
     BuiltinArgTypeMangleInfo DTInfo = Info;
     DTInfo.IsAtomic = false;
-    return SPIR::RefParamType(new SPIR::AtomicType(
-        transTypeDesc(Ty, DTInfo)));
+    return Pool.getAtomic(transTypeDesc(Ty, DTInfo));
   }
   if(auto *IntTy = dyn_cast<IntegerType>(Ty)) {
     switch(IntTy->getBitWidth()) {
     case 1:
-      return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_BOOL));
+      return Pool.getPrimitive(SPIR::PRIMITIVE_BOOL);
     case 8:
-      return SPIR::RefParamType(new SPIR::PrimitiveType(Signed?
-          SPIR::PRIMITIVE_CHAR:SPIR::PRIMITIVE_UCHAR));
+      return Pool.getPrimitive(Signed?
+          SPIR::PRIMITIVE_CHAR:SPIR::PRIMITIVE_UCHAR);
     case 16:
-      return SPIR::RefParamType(new SPIR::PrimitiveType(Signed?
-          SPIR::PRIMITIVE_SHORT:SPIR::PRIMITIVE_USHORT));
+      return Pool.getPrimitive(Signed?
+          SPIR::PRIMITIVE_SHORT:SPIR::PRIMITIVE_USHORT);
     case 32:
-      return SPIR::RefParamType(new SPIR::PrimitiveType(Signed?
-          SPIR::PRIMITIVE_INT:SPIR::PRIMITIVE_UINT));
+      return Pool.getPrimitive(Signed?
+          SPIR::PRIMITIVE_INT:SPIR::PRIMITIVE_UINT);
     case 64:
-      return SPIR::RefParamType(new SPIR::PrimitiveType(Signed?
-          SPIR::PRIMITIVE_LONG:SPIR::PRIMITIVE_ULONG));
+      return Pool.getPrimitive(Signed?
+          SPIR::PRIMITIVE_LONG:SPIR::PRIMITIVE_ULONG);
     default:
       llvm_unreachable("invliad int size");
     }
   }
   if (Ty->isVoidTy())
-    return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_VOID));
+    return Pool.getPrimitive(SPIR::PRIMITIVE_VOID);
   if (Ty->isHalfTy())
-    return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_HALF));
+    return Pool.getPrimitive(SPIR::PRIMITIVE_HALF);
   if (Ty->isFloatTy())
-    return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_FLOAT));
+    return Pool.getPrimitive(SPIR::PRIMITIVE_FLOAT);
   if (Ty->isDoubleTy())
-    return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_DOUBLE));
+    return Pool.getPrimitive(SPIR::PRIMITIVE_DOUBLE);
   if (Ty->isVectorTy()) {
-    return SPIR::RefParamType(new SPIR::VectorType(
-        transTypeDesc(Ty->getVectorElementType(), Info),
-        Ty->getVectorNumElements()));
+    return Pool.getVector(transTypeDesc(Ty->getVectorElementType(), Info),
+        Ty->getVectorNumElements());
   }
   if (Ty->isArrayTy()) {
     return transTypeDesc(PointerType::get(Ty->getArrayElementType(), 0), Info);
@@ -1057,10 +1281,9 @@ transTypeDesc(Type *Ty, const BuiltinArgTypeMangleInfo &Info) {
 
   if (Ty->isPointerTy()) {
     auto ET = Ty->getPointerElementType();
-    SPIR::ParamType *EPT = nullptr;
     if (auto FT = dyn_cast<FunctionType>(ET)) {
       assert(isVoidFuncTy(FT) && "Not supported");
-      EPT = new SPIR::BlockType;
+      return Pool.getBlock(false);
     } else if (auto StructTy = dyn_cast<StructType>(ET)) {
       DEBUG(dbgs() << "ptr to struct: " << *Ty << '\n');
       auto TyName = StructTy->getStructName();
@@ -1076,50 +1299,29 @@ transTypeDesc(Type *Ty, const BuiltinArgTypeMangleInfo &Info) {
       auto Prim = getOCLTypePrimitiveEnum(TyName);
       if (StructTy->isOpaque()) {
         if (TyName == "opencl.block") {
-          auto BlockTy = new SPIR::BlockType;
           // Handle block with local memory arguments according to OpenCL 2.0 spec.
-          if(Info.IsLocalArgBlock) {
-            SPIR::RefParamType VoidTyRef(new SPIR::PrimitiveType(SPIR::PRIMITIVE_VOID));
-            auto VoidPtrTy = new SPIR::PointerType(VoidTyRef);
-            VoidPtrTy->setAddressSpace(SPIR::ATTR_LOCAL);
-            // "__local void *"
-            BlockTy->setParam(0, SPIR::RefParamType(VoidPtrTy));
-            // "..."
-            BlockTy->setParam(1, SPIR::RefParamType(
-              new SPIR::PrimitiveType(SPIR::PRIMITIVE_VAR_ARG)));
-          }
-          EPT = BlockTy;
+          return Pool.getBlock(Info.IsLocalArgBlock);
         } else if (Prim != SPIR::PRIMITIVE_NONE) {
-          if (Prim == SPIR::PRIMITIVE_PIPE_T) {
-            SPIR::RefParamType OpaqueTyRef(new SPIR::PrimitiveType(Prim));
-            auto OpaquePtrTy = new SPIR::PointerType(OpaqueTyRef);
-            OpaquePtrTy->setAddressSpace(getOCLOpaqueTypeAddrSpace(Prim));
-            EPT = OpaquePtrTy;
-          }
-          else {
-            EPT = new SPIR::PrimitiveType(Prim);
-          }
+          if (Prim == SPIR::PRIMITIVE_PIPE_T)
+            return Pool.getPointer(Pool.getPrimitive(Prim),
+                getOCLOpaqueTypeAddrSpace(Prim));
+          return Pool.getPrimitive(Prim);
         }
       } else if (Prim == SPIR::PRIMITIVE_NDRANGE_T)
         // ndrange_t is not opaque type
-        EPT = new SPIR::PrimitiveType(SPIR::PRIMITIVE_NDRANGE_T);
+        return Pool.getPrimitive(SPIR::PRIMITIVE_NDRANGE_T);
     }
-    if (EPT)
-      return SPIR::RefParamType(EPT);
 
     if (VoidPtr && ET->isIntegerTy(8))
       ET = Type::getVoidTy(ET->getContext());
-    auto PT = new SPIR::PointerType(transTypeDesc(ET, Info));
-    PT->setAddressSpace(static_cast<SPIR::TypeAttributeEnum>(
-      Ty->getPointerAddressSpace() + (unsigned)SPIR::ATTR_ADDR_SPACE_FIRST));
-    for (unsigned I = SPIR::ATTR_QUALIFIER_FIRST,
-        E = SPIR::ATTR_QUALIFIER_LAST; I <= E; ++I)
-      PT->setQualifier(static_cast<SPIR::TypeAttributeEnum>(I), I & Attr);
-    return SPIR::RefParamType(PT);
+    return Pool.getPointer(transTypeDesc(ET, Info),
+        static_cast<SPIR::TypeAttributeEnum>(
+          Ty->getPointerAddressSpace() + (unsigned)SPIR::ATTR_ADDR_SPACE_FIRST),
+        Attr);
   }
   DEBUG(dbgs() << "[transTypeDesc] " << *Ty << '\n');
   assert (0 && "not implemented");
-  return SPIR::RefParamType(new SPIR::PrimitiveType(SPIR::PRIMITIVE_INT));
+  return Pool.getPrimitive(SPIR::PRIMITIVE_INT);
 }
 
 Value *
@@ -1376,6 +1578,133 @@ eraseUselessFunctions(Module *M) {
   return changed;
 }
 
+namespace {
+/// Cache of mangled builtin names shared by all translations in a process.
+///
+/// A signature is identified by the unmangled name and the pooled descriptors
+/// of its parameters, which are unique per type structure, so a builtin used
+/// by many modules and LLVM contexts maps to a single entry. Signatures with
+/// descriptors outside the pool are not cached. The cache is split into
+/// shards guarded by their own locks, and a shard is emptied once it holds
+/// its share of the process-wide limit, see setMangleCacheSize.
+class MangledNameCache {
+public:
+  static MangledNameCache &get() {
+    static MangledNameCache Cache;
+    return Cache;
+  }
+
+  void setLimit(unsigned NewLimit) {
+    Limit = NewLimit;
+    for (auto &S : Shards) {
+      std::lock_guard<std::mutex> Lock(S.Mutex);
+      S.Entries.clear();
+    }
+  }
+
+  /// Look up the mangled name of \p FD, counting a hit if it is found and a
+  /// miss otherwise.
+  bool lookup(const SPIR::FunctionDescriptor &FD, std::string &MangledName) {
+    if (find(FD, MangledName)) {
+      ++Hits;
+      return true;
+    }
+    ++Misses;
+    return false;
+  }
+
+  void insert(const SPIR::FunctionDescriptor &FD,
+      const std::string &MangledName) {
+    size_t Hash;
+    if (!getHash(FD, Hash))
+      return;
+    Shard &S = Shards[Hash % NumShards];
+    Entry E;
+    E.Name = FD.name;
+    for (auto &P : FD.parameters)
+      E.Params.push_back(P);
+    E.MangledName = MangledName;
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    if (S.Entries.size() * NumShards >= Limit)
+      S.Entries.clear();
+    S.Entries.emplace(Hash, std::move(E));
+  }
+
+  void getStats(uint64_t &NumHits, uint64_t &NumMisses) const {
+    NumHits = Hits;
+    NumMisses = Misses;
+  }
+
+private:
+  enum { NumShards = 16 };
+
+  struct Entry {
+    std::string Name;
+    std::vector<const SPIR::ParamType *> Params;
+    std::string MangledName;
+
+    bool matches(const SPIR::FunctionDescriptor &FD) const {
+      if (Name != FD.name || Params.size() != FD.parameters.size())
+        return false;
+      for (size_t I = 0, E = Params.size(); I != E; ++I)
+        if (Params[I] != FD.parameters[I])
+          return false;
+      return true;
+    }
+  };
+
+  struct Shard {
+    std::mutex Mutex;
+    std::unordered_multimap<size_t, Entry> Entries;
+  };
+
+  MangledNameCache() :Limit(MangleCacheSize), Hits(0), Misses(0) {}
+
+  bool find(const SPIR::FunctionDescriptor &FD, std::string &MangledName) {
+    size_t Hash;
+    if (!getHash(FD, Hash))
+      return false;
+    Shard &S = Shards[Hash % NumShards];
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    auto Range = S.Entries.equal_range(Hash);
+    for (auto I = Range.first; I != Range.second; ++I)
+      if (I->second.matches(FD)) {
+        MangledName = I->second.MangledName;
+        return true;
+      }
+    return false;
+  }
+
+  bool getHash(const SPIR::FunctionDescriptor &FD, size_t &Hash) const {
+    if (!Limit)
+      return false;
+    hash_code H = hash_value(StringRef(FD.name));
+    for (auto &P : FD.parameters) {
+      if (!P.isUnmanaged())
+        return false;
+      H = hash_combine(H, static_cast<const SPIR::ParamType *>(P));
+    }
+    Hash = H;
+    return true;
+  }
+
+  std::atomic<unsigned> Limit;
+  std::atomic<uint64_t> Hits;
+  std::atomic<uint64_t> Misses;
+  Shard Shards[NumShards];
+};
+} // anonymous namespace
+
+void
+setMangleCacheSize(unsigned Size) {
+  MangledNameCache::get().setLimit(Size);
+}
+
+void
+getMangleCacheStats(uint64_t &Hits, uint64_t &Misses) {
+  MangledNameCache::get().getStats(Hits, Misses);
+}
+
 std::string
 mangleBuiltin(const std::string &UniqName,
     ArrayRef<Type*> ArgTypes, BuiltinFuncMangleInfo* BtnInfo) {
@@ -1393,8 +1722,8 @@ mangleBuiltin(const std::string &UniqName,
     // Function signature cannot be ()(void, ...) so if there is an ellipsis
     // it must be ()(...)
     if(BIVarArgNegative) {
-      FD.parameters.emplace_back(SPIR::RefParamType(new SPIR::PrimitiveType(
-        SPIR::PRIMITIVE_VOID)));
+      FD.parameters.emplace_back(
+        MangleTypeDescPool::get().getPrimitive(SPIR::PRIMITIVE_VOID));
     }
   } else {
     for (unsigned I = 0, 
@@ -1408,10 +1737,18 @@ mangleBuiltin(const std::string &UniqName,
   if(!BIVarArgNegative) {
     assert((unsigned)BtnInfo->getVarArg() <= ArgTypes.size()
            && "invalid index of an ellipsis");
-    FD.parameters.emplace_back(SPIR::RefParamType(new SPIR::PrimitiveType(
-        SPIR::PRIMITIVE_VAR_ARG)));
+    FD.parameters.emplace_back(
+        MangleTypeDescPool::get().getPrimitive(SPIR::PRIMITIVE_VAR_ARG));
+  }
+  auto &Cache = MangledNameCache::get();
+  if (Cache.lookup(FD, MangledName)) {
+    ++NumMangleCacheHits;
+    DEBUG(dbgs() << MangledName << " (cached)\n");
+    return MangledName;
   }
+  ++NumMangleCacheMisses;
   Mangler.mangle(FD, MangledName);
+  Cache.insert(FD, MangledName);
   DEBUG(dbgs() << MangledName << '\n');
   return MangledName;
 }
@@ -1445,4 +1782,35 @@ Type *getSPIRVImageTypeFromOCL(Module *M, Type *ImageTy) {
     Acc = getAccessQualifier(ImageTypeName);
   return getOrCreateOpaquePtrType(M, mapOCLTypeNameToSPIRV(ImageTypeName, Acc));
 }
+
+void
+createIndexLoop(IRBuilder<> &Builder, Value *Begin, Value *End, bool Reverse,
+    StringRef Name, std::function<void(Value *)> Body) {
+  auto Pre = Builder.GetInsertBlock();
+  auto F = Pre->getParent();
+  auto &Ctx = F->getContext();
+  auto Ty = Begin->getType();
+  auto One = ConstantInt::get(Ty, 1);
+  auto Exit = Pre->splitBasicBlock(Builder.GetInsertPoint(), Name + ".end");
+  auto Header = BasicBlock::Create(Ctx, Name + ".cond", F, Exit);
+  auto Latch = BasicBlock::Create(Ctx, Name + ".body", F, Exit);
+  Pre->getTerminator()->setSuccessor(0, Header);
+
+  // A reverse loop counts down from End and visits the index below the
+  // counter, so that the counter never wraps below Begin.
+  Builder.SetInsertPoint(Header);
+  auto Counter = Builder.CreatePHI(Ty, 2, Name + ".idx");
+  Counter->addIncoming(Reverse ? End : Begin, Pre);
+  Builder.CreateCondBr(Reverse ? Builder.CreateICmpUGT(Counter, Begin) :
+      Builder.CreateICmpULT(Counter, End), Latch, Exit);
+
+  Builder.SetInsertPoint(Latch);
+  Value *Index = Reverse ? Builder.CreateSub(Counter, One) : Counter;
+  Body(Index);
+  Counter->addIncoming(Reverse ? Index : Builder.CreateAdd(Counter, One),
+      Builder.GetInsertBlock());
+  Builder.CreateBr(Header);
+
+  Builder.SetInsertPoint(&Exit->front());
+}
 }
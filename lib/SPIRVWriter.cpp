@@ -47,21 +47,29 @@
 #include "libSPIRV/SPIRVBasicBlock.h"
 #include "libSPIRV/SPIRVInstruction.h"
 #include "libSPIRV/SPIRVExtInst.h"
+#include "libSPIRV/SPIRVStream.h"
 #include "OCLTypeToSPIRV.h"
 #include "OCLUtil.h"
+#include "SPIRVFunctionCache.h"
 #include "SPIRVInternal.h"
 #include "SPIRVMDWalker.h"
 #include "SPIRVUtil.h"
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/PostDominators.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instructions.h"
@@ -90,6 +98,9 @@
 
 #define DEBUG_TYPE "spirv"
 
+STATISTIC(NumFunctionCacheReuses,
+    "Number of functions reused from the translation cache");
+
 using namespace llvm;
 using namespace SPIRV;
 using namespace OCLUtil;
@@ -100,8 +111,18 @@ namespace llvm {
 
 namespace SPIRV{
 
-cl::opt<bool> SPIRVMemToReg("spirv-mem2reg", cl::init(true),
-    cl::desc("LLVM/SPIR-V translation enable mem2reg"));
+cl::opt<bool, true> SPIRVMemToReg("spirv-mem2reg",
+    cl::desc("LLVM/SPIR-V translation enable mem2reg"),
+    cl::location(getMutableDefaultTranslatorOptions().MemToReg));
+
+cl::opt<SPIRVMaxVersionKind, true> SPIRVMaxVersion("spirv-max-version",
+    cl::desc("Highest SPIR-V version of the optional features emitted by "
+             "the LLVM to SPIR-V translation"),
+    cl::values(
+        clEnumValN(SPIRVMaxVersion10, "1.0", "SPIR-V 1.0"),
+        clEnumValN(SPIRVMaxVersion11, "1.1",
+            "SPIR-V 1.1, e.g. DependencyInfinite loop controls")),
+    cl::location(getMutableDefaultTranslatorOptions().MaxSPIRVVersion));
 
 
 static void
@@ -156,7 +177,8 @@ private:
 
 class LLVMToSPIRV: public ModulePass {
 public:
-  LLVMToSPIRV(SPIRVModule *SMod = nullptr)
+  LLVMToSPIRV(SPIRVModule *SMod = nullptr,
+      const TranslatorOptions &Opts = getDefaultTranslatorOptions())
       : ModulePass(ID),
         M(nullptr),
         Ctx(nullptr),
@@ -164,7 +186,9 @@ public:
         ExtSetId(SPIRVID_INVALID),
         SrcLang(0),
         SrcLangVer(0),
-        DbgTran(nullptr, SMod){
+        DbgTran(nullptr, SMod),
+        MemSetZeroPool(nullptr),
+        Opts(Opts){
   }
 
   StringRef getPassName() const override {
@@ -201,6 +225,7 @@ public:
   bool transExtension();
   bool transBuiltinSet();
   SPIRVValue *transIntrinsicInst(IntrinsicInst *Intrinsic, SPIRVBasicBlock *BB);
+  SPIRVValue *transByteSwap(IntrinsicInst *II, SPIRVBasicBlock *BB);
   SPIRVValue *transCallInst(CallInst *Call, SPIRVBasicBlock *BB);
   bool transDecoration(Value *V, SPIRVValue *BV);
   SPIRVWord transFunctionControlMask(CallInst *);
@@ -218,6 +243,11 @@ public:
       bool CreateForward = true);
   SPIRVValue *transValueWithoutDecoration(Value *V, SPIRVBasicBlock *BB,
       bool CreateForward = true);
+  void transMergeInst(TerminatorInst *TI, SPIRVBasicBlock *BB);
+  std::vector<SPIRVWord> transMemoryAccess(Instruction *I, unsigned Align,
+      bool IsVolatile);
+  void transRestrictDecoration(Function *F, SPIRVFunction *BF);
+  SPIRVWord transLoopControl(Loop *L);
 
   typedef DenseMap<Type *, SPIRVType *> LLVMToSPIRVTypeMap;
   typedef DenseMap<Value *, SPIRVValue *> LLVMToSPIRVValueMap;
@@ -232,6 +262,29 @@ private:
   SPIRVWord SrcLang;
   SPIRVWord SrcLangVer;
   LLVMToSPIRVDbgTran DbgTran;
+  // Analyses of the function being translated, used to find the constructs
+  // of structured control flow.
+  DominatorTree DT;
+  PostDominatorTree PDT;
+  LoopInfo LI;
+  // Blocks already used as the merge block of a loop or selection construct.
+  std::set<BasicBlock *> MergeBlocks;
+  // Zero-initialized constant which llvm.memset's of zero copy from.
+  SPIRVValue *MemSetZeroPool;
+
+  SPIRVValue *getMemSetZeroPool();
+
+  TranslatorOptions Opts;
+
+  // Functions which are translated and then stored in the translation cache.
+  typedef std::vector<std::pair<Function *, SPIRVTranslationCache>>
+      FunctionCacheMissVec;
+  bool isFunctionCacheEnabled() const;
+  bool getFunctionFingerprint(Function *F, std::string &Fingerprint);
+  bool transCachedFunction(Function *F, StringRef Entry);
+  bool encodeCachedFunction(Function *F,
+      const DenseMap<SPIRVId, std::string> &Keys, std::string &Entry);
+  void storeCachedFunctions(FunctionCacheMissVec &Misses);
 
   SPIRVType *mapType(Type *T, SPIRVType *BT) {
     TypeMap[T] = BT;
@@ -670,6 +723,10 @@ LLVMToSPIRV::transFunctionDecl(Function *F) {
       BA->addAttr(FunctionParameterAttributeNoAlias);
     if (I->hasNoCaptureAttr())
       BA->addAttr(FunctionParameterAttributeNoCapture);
+    if (Attrs.hasAttribute(ArgNo + 1, Attribute::ReadNone))
+      BA->addAttr(FunctionParameterAttributeNoReadWrite);
+    else if (Attrs.hasAttribute(ArgNo + 1, Attribute::ReadOnly))
+      BA->addAttr(FunctionParameterAttributeNoWrite);
     if (I->hasStructRetAttr())
       BA->addAttr(FunctionParameterAttributeSret);
     if (Attrs.hasAttribute(ArgNo + 1, Attribute::ZExt))
@@ -680,6 +737,8 @@ LLVMToSPIRV::transFunctionDecl(Function *F) {
       BA->addDecorate(DecorationMaxByteOffset,
                       Attrs.getAttribute(ArgNo + 1, Attribute::Dereferenceable)
                         .getDereferenceableBytes());
+    if (unsigned Align = I->getParamAlignment())
+      BM->setAlignment(BA, Align);
   }
   if (Attrs.hasAttribute(AttributeList::ReturnIndex, Attribute::ZExt))
     BF->addDecorate(DecorationFuncParamAttr, FunctionParameterAttributeZext);
@@ -966,40 +1025,16 @@ LLVMToSPIRV::transValueWithoutDecoration(Value *V, SPIRVBasicBlock *BB,
   if (CreateForward)
     return mapValue(V, BM->addForward(transType(V->getType())));
 
-  if (StoreInst *ST = dyn_cast<StoreInst>(V)) {
-    std::vector<SPIRVWord> MemoryAccess(1,0);
-    if (ST->isVolatile())
-      MemoryAccess[0] |= MemoryAccessVolatileMask;
-    if (ST->getAlignment()) {
-      MemoryAccess[0] |= MemoryAccessAlignedMask;
-      MemoryAccess.push_back(ST->getAlignment());
-    }
-    if (ST->getMetadata(LLVMContext::MD_nontemporal))
-      MemoryAccess[0] |= MemoryAccessNontemporalMask;
-    if (MemoryAccess.front() == 0)
-      MemoryAccess.clear();
+  if (StoreInst *ST = dyn_cast<StoreInst>(V))
     return mapValue(V, BM->addStoreInst(
         transValue(ST->getPointerOperand(), BB),
         transValue(ST->getValueOperand(), BB),
-        MemoryAccess, BB));
-  }
+        transMemoryAccess(ST, ST->getAlignment(), ST->isVolatile()), BB));
 
-  if (LoadInst *LD = dyn_cast<LoadInst>(V)) {
-    std::vector<SPIRVWord> MemoryAccess(1,0);
-    if (LD->isVolatile())
-      MemoryAccess[0] |= MemoryAccessVolatileMask;
-    if (LD->getAlignment()) {
-      MemoryAccess[0] |= MemoryAccessAlignedMask;
-      MemoryAccess.push_back(LD->getAlignment());
-    }
-    if (LD->getMetadata(LLVMContext::MD_nontemporal))
-      MemoryAccess[0] |= MemoryAccessNontemporalMask;
-    if (MemoryAccess.front() == 0)
-      MemoryAccess.clear();
+  if (LoadInst *LD = dyn_cast<LoadInst>(V))
     return mapValue(V, BM->addLoadInst(
         transValue(LD->getPointerOperand(), BB),
-        MemoryAccess, BB));
-  }
+        transMemoryAccess(LD, LD->getAlignment(), LD->isVolatile()), BB));
 
   if (BinaryOperator *B = dyn_cast<BinaryOperator>(V)) {
     SPIRVInstruction* BI = transBinaryInst(B, BB);
@@ -1037,6 +1072,7 @@ LLVMToSPIRV::transValueWithoutDecoration(Value *V, SPIRVBasicBlock *BB,
   if (auto *Switch = dyn_cast<SwitchInst>(V)) {
     std::vector<SPIRVSwitch::PairTy> Pairs;
     auto Select = transValue(Switch->getCondition(), BB);
+    transMergeInst(Switch, BB);
 
     unsigned BitWidth = Select->getType()->getBitWidth();
 
@@ -1060,12 +1096,15 @@ LLVMToSPIRV::transValueWithoutDecoration(Value *V, SPIRVBasicBlock *BB,
   }
 
   if (auto Branch = dyn_cast<BranchInst>(V)) {
-    if (Branch->isUnconditional())
-      return mapValue(V, BM->addBranchInst(
-          static_cast<SPIRVLabel*>(transValue(Branch->getSuccessor(0), BB)),
-          BB));
-    return mapValue(V, BM->addBranchConditionalInst(
-        transValue(Branch->getCondition(), BB),
+    if (Branch->isUnconditional()) {
+      auto Target = static_cast<SPIRVLabel*>(
+          transValue(Branch->getSuccessor(0), BB));
+      transMergeInst(Branch, BB);
+      return mapValue(V, BM->addBranchInst(Target, BB));
+    }
+    auto Cond = transValue(Branch->getCondition(), BB);
+    transMergeInst(Branch, BB);
+    return mapValue(V, BM->addBranchConditionalInst(Cond,
         static_cast<SPIRVLabel*>(transValue(Branch->getSuccessor(0), BB)),
         static_cast<SPIRVLabel*>(transValue(Branch->getSuccessor(1), BB)),
         BB));
@@ -1191,6 +1230,89 @@ LLVMToSPIRV::transAlign(Value *V, SPIRVValue *BV) {
   return true;
 }
 
+/// Translate the alignment, volatility and the nontemporal hint of a memory
+/// access to the memory access operands of a load, store or memory copy.
+/// No operand is emitted for an access without any of them.
+std::vector<SPIRVWord>
+LLVMToSPIRV::transMemoryAccess(Instruction *I, unsigned Align,
+    bool IsVolatile) {
+  std::vector<SPIRVWord> MemoryAccess(1, MemoryAccessMaskNone);
+  if (IsVolatile)
+    MemoryAccess[0] |= MemoryAccessVolatileMask;
+  if (Align) {
+    MemoryAccess[0] |= MemoryAccessAlignedMask;
+    MemoryAccess.push_back(Align);
+  }
+  if (I->getMetadata(LLVMContext::MD_nontemporal))
+    MemoryAccess[0] |= MemoryAccessNontemporalMask;
+  if (MemoryAccess.front() == MemoryAccessMaskNone)
+    MemoryAccess.clear();
+  return MemoryAccess;
+}
+
+/// Recover the Restrict decoration of pointer arguments from the scoped
+/// alias metadata, e.g. as left by inlining a function with noalias
+/// arguments. An argument is restrict if some scope contains every load and
+/// store based on it and every other memory access is marked as not
+/// aliasing that scope. Arguments with the noalias attribute are already
+/// translated to FuncParamAttr NoAlias.
+void
+LLVMToSPIRV::transRestrictDecoration(Function *F, SPIRVFunction *BF) {
+  std::vector<Instruction *> MemInsts;
+  for (auto &BB : *F)
+    for (auto &I : BB)
+      if (I.mayReadOrWriteMemory())
+        MemInsts.push_back(&I);
+  if (MemInsts.empty())
+    return;
+
+  const DataLayout &DL = M->getDataLayout();
+  auto getBase = [&](Instruction *I) -> Value * {
+    if (auto LD = dyn_cast<LoadInst>(I))
+      return GetUnderlyingObject(LD->getPointerOperand(), DL);
+    if (auto ST = dyn_cast<StoreInst>(I))
+      return GetUnderlyingObject(ST->getPointerOperand(), DL);
+    return nullptr;
+  };
+  // Keep only the scopes listed in the given metadata of an instruction.
+  auto intersect = [](std::vector<Metadata *> &Scopes, MDNode *MD) {
+    Scopes.erase(std::remove_if(Scopes.begin(), Scopes.end(),
+        [=](Metadata *S){
+          return !MD || std::find(MD->op_begin(), MD->op_end(), S) ==
+              MD->op_end();
+        }), Scopes.end());
+  };
+
+  for (auto &Arg : F->args()) {
+    if (!Arg.getType()->isPointerTy() || Arg.hasNoAliasAttr())
+      continue;
+    std::vector<Metadata *> Scopes;
+    bool IsUsed = false;
+    for (auto I : MemInsts) {
+      if (getBase(I) != &Arg)
+        continue;
+      MDNode *MD = I->getMetadata(LLVMContext::MD_alias_scope);
+      if (!IsUsed && MD)
+        Scopes.assign(MD->op_begin(), MD->op_end());
+      else
+        intersect(Scopes, MD);
+      IsUsed = true;
+      if (Scopes.empty())
+        break;
+    }
+    for (auto I : MemInsts) {
+      if (Scopes.empty())
+        break;
+      if (getBase(I) != &Arg)
+        intersect(Scopes, I->getMetadata(LLVMContext::MD_noalias));
+    }
+    if (!Scopes.empty()) {
+      auto BA = BF->getArgument(Arg.getArgNo());
+      BA->addDecorate(new SPIRVDecorate(DecorationRestrict, BA));
+    }
+  }
+}
+
 /// Do this after source language is set.
 bool
 LLVMToSPIRV::transBuiltinSet() {
@@ -1254,15 +1376,8 @@ LLVMToSPIRV::transSpcvCast(CallInst* CI, SPIRVBasicBlock *BB) {
 
 SPIRVValue *
 LLVMToSPIRV::transIntrinsicInst(IntrinsicInst *II, SPIRVBasicBlock *BB) {
-  auto getMemoryAccess = [](MemIntrinsic *MI)->std::vector<SPIRVWord> {
-    std::vector<SPIRVWord> MemoryAccess(1, MemoryAccessMaskNone);
-    if (SPIRVWord AlignVal = MI->getAlignment()) {
-      MemoryAccess[0] |= MemoryAccessAlignedMask;
-      MemoryAccess.push_back(AlignVal);
-    }
-    if (MI->isVolatile())
-      MemoryAccess[0] |= MemoryAccessVolatileMask;
-    return MemoryAccess;
+  auto getMemoryAccess = [=](MemIntrinsic *MI)->std::vector<SPIRVWord> {
+    return transMemoryAccess(MI, MI->getAlignment(), MI->isVolatile());
   };
 
   switch (II->getIntrinsicID()) {
@@ -1282,7 +1397,9 @@ LLVMToSPIRV::transIntrinsicInst(IntrinsicInst *II, SPIRVBasicBlock *BB) {
     // Generally memset can't be translated with current version of SPIRV spec.
     // But in most cases it turns out that memset is emited by Clang to do
     // zero-initializtion in default constructors.
-    // The code below handles only cases with val = 0 and constant len.
+    // The code below handles only cases with val = 0 and constant len, which
+    // are translated to copies from a zero-initialized constant shared by
+    // the module. The other ones are lowered to stores by SPIRVLowerInst.
     MemSetInst *MSI = cast<MemSetInst>(II);
     Value *Val = MSI->getValue();
     if (!isa<Constant>(Val)) {
@@ -1298,19 +1415,12 @@ LLVMToSPIRV::transIntrinsicInst(IntrinsicInst *II, SPIRVBasicBlock *BB) {
       assert(!"Can't translate llvm.memset with non-const `length` argument");
       return nullptr;
     }
-    uint64_t NumElements = static_cast<ConstantInt*>(Len)->getZExtValue();
-    auto *AT = ArrayType::get(Val->getType(), NumElements);
-    SPIRVTypeArray *CompositeTy = static_cast<SPIRVTypeArray*>(transType(AT));
-    SPIRVValue *Init = BM->addNullConstant(CompositeTy);
-    SPIRVType *VarTy = transType(PointerType::get(AT, SPIRV::SPIRAS_Constant));
-    SPIRVValue *Var = BM->addVariable(VarTy,/*isConstant*/true,
-                                      spv::LinkageTypeInternal, Init, "",
-                                      StorageClassUniformConstant, nullptr);
     SPIRVType *SourceTy = transType(PointerType::get(Val->getType(),
                                                      SPIRV::SPIRAS_Constant));
-    SPIRVValue *Source = BM->addUnaryInst(OpBitcast, SourceTy, Var, BB);
+    SPIRVValue *Source = BM->addUnaryInst(OpBitcast, SourceTy,
+                                          getMemSetZeroPool(), BB);
     SPIRVValue *Target = transValue(MSI->getRawDest(), BB);
-    return BM->addCopyMemorySizedInst(Target, Source, CompositeTy->getLength(),
+    return BM->addCopyMemorySizedInst(Target, Source, transValue(Len, BB),
                                       getMemoryAccess(MSI), BB);
   }
   break;
@@ -1325,15 +1435,89 @@ LLVMToSPIRV::transIntrinsicInst(IntrinsicInst *II, SPIRVBasicBlock *BB) {
     return transLifetimeIntrinsicInst(OpLifetimeStart, II, BB);
   case Intrinsic::lifetime_end:
     return transLifetimeIntrinsicInst(OpLifetimeStop, II, BB);
-  default:
-    // LLVM intrinsic functions shouldn't get to SPIRV, because they
+  case Intrinsic::bswap:
+    return transByteSwap(II, BB);
+  default: {
+    OCLExtOpKind ExtOp;
+    if (LLVMIntrinsicOCLExtOpMap::find(II->getIntrinsicID(), &ExtOp)) {
+      // OpenCL clz and ctz are defined for zero, so is_zero_undef is not
+      // translated.
+      unsigned NumArgs = II->getNumArgOperands();
+      if (ExtOp == OpenCLLIB::Clz || ExtOp == OpenCLLIB::Ctz)
+        NumArgs = 1;
+      std::vector<SPIRVValue *> Args;
+      for (unsigned I = 0; I < NumArgs; ++I)
+        Args.push_back(transValue(II->getArgOperand(I), BB));
+      return BM->addExtInst(transType(II->getType()), ExtSetId, ExtOp, Args,
+                            BB);
+    }
+    // Other LLVM intrinsic functions shouldn't get to SPIRV, because they
     // would have no definition there.
     BM->getErrorLog().checkError(false, SPIRVEC_InvalidFunctionCall,
                                  II->getName().str(), "", __FILE__, __LINE__);
   }
+  }
   return nullptr;
 }
 
+/// There is no byte swap in SPIR-V. Each byte is shifted to its swapped
+/// position and masked, and the bytes are combined with bitwise or.
+SPIRVValue *
+LLVMToSPIRV::transByteSwap(IntrinsicInst *II, SPIRVBasicBlock *BB) {
+  Type *Ty = II->getType();
+  SPIRVType *BTy = transType(Ty);
+  SPIRVValue *Op = transValue(II->getArgOperand(0), BB);
+  auto getConst = [&](uint64_t V) {
+    return transValue(ConstantInt::get(Ty, V), BB);
+  };
+  unsigned NumBytes = Ty->getScalarSizeInBits() / 8;
+  SPIRVValue *Res = nullptr;
+  for (unsigned I = 0; I < NumBytes; ++I) {
+    unsigned To = NumBytes - 1 - I;
+    SPIRVValue *Byte = Op;
+    if (To > I)
+      Byte = BM->addBinaryInst(OpShiftLeftLogical, BTy, Op,
+                               getConst(8 * (To - I)), BB);
+    else if (To < I)
+      Byte = BM->addBinaryInst(OpShiftRightLogical, BTy, Op,
+                               getConst(8 * (I - To)), BB);
+    Byte = BM->addBinaryInst(OpBitwiseAnd, BTy, Byte,
+                             getConst(UINT64_C(0xFF) << (8 * To)), BB);
+    Res = Res ? BM->addBinaryInst(OpBitwiseOr, BTy, Res, Byte, BB) : Byte;
+  }
+  return Res;
+}
+
+/// The zero pool is an i8 array as long as the longest llvm.memset of zero
+/// with constant length in the module, so that it is created once for all
+/// of them.
+SPIRVValue *
+LLVMToSPIRV::getMemSetZeroPool() {
+  if (MemSetZeroPool)
+    return MemSetZeroPool;
+  uint64_t Size = 0;
+  for (auto &F : *M) {
+    if (F.getIntrinsicID() != Intrinsic::memset)
+      continue;
+    for (auto U : F.users()) {
+      auto MSI = dyn_cast<MemSetInst>(U);
+      if (!MSI || !isa<Constant>(MSI->getValue()) ||
+          !cast<Constant>(MSI->getValue())->isZeroValue())
+        continue;
+      if (auto Len = dyn_cast<ConstantInt>(MSI->getLength()))
+        Size = std::max(Size, Len->getZExtValue());
+    }
+  }
+  auto *AT = ArrayType::get(Type::getInt8Ty(*Ctx), Size);
+  SPIRVValue *Init = BM->addNullConstant(
+      static_cast<SPIRVTypeArray*>(transType(AT)));
+  SPIRVType *VarTy = transType(PointerType::get(AT, SPIRV::SPIRAS_Constant));
+  MemSetZeroPool = BM->addVariable(VarTy,/*isConstant*/true,
+                                   spv::LinkageTypeInternal, Init, "",
+                                   StorageClassUniformConstant, nullptr);
+  return MemSetZeroPool;
+}
+
 SPIRVValue *
 LLVMToSPIRV::transCallInst(CallInst *CI, SPIRVBasicBlock *BB) {
   SPIRVExtInstSetKind ExtSetKind = SPIRVEIS_Count;
@@ -1470,7 +1654,12 @@ LLVMToSPIRV::mutateFuncArgType(const std::map<unsigned, Type*>& ChangedType,
 
 void
 LLVMToSPIRV::transFunction(Function *I) {
-  transFunctionDecl(I);
+  SPIRVFunction *BF = transFunctionDecl(I);
+  DT.recalculate(*I);
+  PDT.recalculate(*I);
+  LI.releaseMemory();
+  LI.analyze(DT);
+  MergeBlocks.clear();
   // Creating all basic blocks before creating any instruction.
   for (Function::iterator FI = I->begin(), FE = I->end(); FI != FE; ++FI) {
     transValue(&*FI, nullptr);
@@ -1482,6 +1671,376 @@ LLVMToSPIRV::transFunction(Function *I) {
       transValue(&*BI, BB, false);
     }
   }
+  transRestrictDecoration(I, BF);
+}
+
+/// Emit OpLoopMerge before the terminator of a loop header, or
+/// OpSelectionMerge before a conditional branch or switch whose immediate
+/// post-dominator can serve as the merge block of a selection construct.
+/// Nothing is emitted for control flow which is not structured, since
+/// kernels do not require the merge instructions.
+void
+LLVMToSPIRV::transMergeInst(TerminatorInst *TI, SPIRVBasicBlock *BB) {
+  BasicBlock *Block = TI->getParent();
+  Loop *L = LI.getLoopFor(Block);
+  if (L && L->getHeader() == Block) {
+    BasicBlock *Latch = L->getLoopLatch();
+    BasicBlock *Exit = L->getUniqueExitBlock();
+    if (!Latch || !Exit || !DT.dominates(Block, Exit) ||
+        MergeBlocks.count(Exit))
+      return;
+    MergeBlocks.insert(Exit);
+    BM->addLoopMergeInst(transValue(Exit, nullptr)->getId(),
+        transValue(Latch, nullptr)->getId(), transLoopControl(L),
+        std::vector<SPIRVWord>(), BB);
+    return;
+  }
+
+  if (TI->getNumSuccessors() < 2)
+    return;
+  auto Node = PDT.getNode(Block);
+  if (!Node || !Node->getIDom())
+    return;
+  BasicBlock *Merge = Node->getIDom()->getBlock();
+  // The selection construct must not cross the boundary of a loop.
+  if (!Merge || !DT.dominates(Block, Merge) || LI.getLoopFor(Merge) != L ||
+      MergeBlocks.count(Merge))
+    return;
+  MergeBlocks.insert(Merge);
+  BM->addSelectionMergeInst(transValue(Merge, nullptr)->getId(),
+      SelectionControlMaskNone, BB);
+}
+
+/// Translate the llvm.loop properties of a loop to a loop control mask.
+/// A loop annotated as parallel has no loop carried dependency. The
+/// vectorization width is only a preference of the vectorizer and says
+/// nothing about the dependencies, so no dependency length is derived
+/// from it.
+///
+/// DependencyInfinite is a SPIR-V 1.1 loop control, and emitting it raises
+/// the version of the module to 1.1, which consumers accepting only SPIR-V
+/// 1.0 reject. It is therefore only emitted if -spirv-max-version allows 1.1.
+SPIRVWord
+LLVMToSPIRV::transLoopControl(Loop *L) {
+  SPIRVWord LoopControl = LoopControlMaskNone;
+  if (MDNode *LoopID = L->getLoopID()) {
+    for (unsigned I = 1, E = LoopID->getNumOperands(); I < E; ++I) {
+      auto Node = dyn_cast<MDNode>(LoopID->getOperand(I));
+      if (!Node || Node->getNumOperands() == 0)
+        continue;
+      auto Name = dyn_cast<MDString>(Node->getOperand(0));
+      if (!Name)
+        continue;
+      ConstantInt *Val = nullptr;
+      if (Node->getNumOperands() > 1)
+        Val = mdconst::dyn_extract_or_null<ConstantInt>(Node->getOperand(1));
+      StringRef S = Name->getString();
+      if (S == "llvm.loop.unroll.disable" ||
+          (S == "llvm.loop.unroll.count" && Val && Val->isOne()))
+        LoopControl |= LoopControlDontUnrollMask;
+      else if (S == "llvm.loop.unroll.enable" ||
+          S == "llvm.loop.unroll.full" || S == "llvm.loop.unroll.count")
+        LoopControl |= LoopControlUnrollMask;
+    }
+  }
+  // Unroll and DontUnroll are mutually exclusive.
+  if (LoopControl & LoopControlDontUnrollMask)
+    LoopControl &= ~LoopControlUnrollMask;
+
+  if (Opts.MaxSPIRVVersion >= SPIRVMaxVersion11 && L->isAnnotatedParallel())
+    LoopControl |= LoopControlDependencyInfiniteMask;
+  return LoopControl;
+}
+
+bool
+LLVMToSPIRV::isFunctionCacheEnabled() const {
+#ifdef _SPIRV_SUPPORT_TEXT_FMT
+  if (SPIRVUseTextFormat)
+    return false;
+#endif
+  return Opts.FunctionCache && !Opts.CacheDir.empty();
+}
+
+/// Write what determines the SPIR-V of the body of \p F, apart from the
+/// module scope entities it references, which are found again through their
+/// keys when it is reused. Functions with debug info are not cached.
+bool
+LLVMToSPIRV::getFunctionFingerprint(Function *F, std::string &Fingerprint) {
+  if (F->getSubprogram())
+    return false;
+  auto &TypeAnalysis = getAnalysis<OCLTypeToSPIRV>();
+  raw_string_ostream OS(Fingerprint);
+  OS << M->getTargetTriple() << '\n' << M->getDataLayoutStr() << '\n'
+     << SrcLang << ' ' << SrcLangVer << '\n'
+     << *TypeAnalysis.getAdaptedType(F) << '\n'
+     << F->getAttributes().getAsString(AttributeList::FunctionIndex) << '\n';
+
+  SetVector<Type *> Types;
+  Types.insert(F->getFunctionType());
+  SmallVector<std::pair<unsigned, MDNode *>, 4> MDs;
+  for (auto &BB : *F) {
+    for (auto &I : BB) {
+      if (I.getDebugLoc())
+        return false;
+      Types.insert(I.getType());
+      for (auto &Op : I.operands())
+        Types.insert(Op->getType());
+      if (auto AI = dyn_cast<AllocaInst>(&I))
+        Types.insert(AI->getAllocatedType());
+      else if (auto GEP = dyn_cast<GetElementPtrInst>(&I))
+        Types.insert(GEP->getSourceElementType());
+      else if (auto CI = dyn_cast<CallInst>(&I)) {
+        OS << CI->getAttributes().getAsString(AttributeList::FunctionIndex)
+           << '\n';
+        if (auto Callee = CI->getCalledFunction())
+          OS << Callee->getName() << ' '
+             << *TypeAnalysis.getAdaptedType(Callee) << ' '
+             << Callee->getAttributes().getAsString(
+                    AttributeList::FunctionIndex) << '\n';
+      }
+      // The numbers of metadata nodes printed with the function depend on
+      // the rest of the module, so they are printed with their operands.
+      MDs.clear();
+      I.getAllMetadataOtherThanDebugLoc(MDs);
+      for (auto &MD : MDs) {
+        OS << MD.first << ' ';
+        MD.second->printTree(OS, M);
+        OS << '\n';
+      }
+    }
+  }
+
+  // The bodies of the named structures reachable from the types used by the
+  // function.
+  SmallPtrSet<Type *, 16> Visited;
+  SmallVector<Type *, 16> Worklist(Types.begin(), Types.end());
+  while (!Worklist.empty()) {
+    Type *T = Worklist.pop_back_val();
+    if (!Visited.insert(T).second)
+      continue;
+    auto ST = dyn_cast<StructType>(T);
+    if (ST && ST->hasName()) {
+      OS << ST->getName() << " =";
+      if (ST->isOpaque())
+        OS << " opaque";
+      for (auto ET : ST->elements())
+        OS << ' ' << *ET;
+      OS << ' ' << ST->isPacked() << '\n';
+    }
+    Worklist.append(T->subtype_begin(), T->subtype_end());
+  }
+
+  F->print(OS);
+  OS.flush();
+  return true;
+}
+
+/// Add the body of \p F from an entry of the translation cache.
+///
+/// The keys of the module scope entities it references are resolved to
+/// types and values of the module first, and the entry is rejected without
+/// changing the module if one of them is missing. Translating those
+/// entities can still fail afterwards. The entities translated until then
+/// stay in the module; they are the ones the regular translation of \p F,
+/// which the caller falls back to, would add as well.
+///
+/// The entities are translated in the order of the entry and the ids of
+/// \p F are allocated in one block after them, whereas a fresh translation
+/// interleaves both. The module is equivalent, but its ids and the order of
+/// its module scope instructions depend on which functions were found in
+/// the cache.
+/// \returns false if the entry cannot be used.
+bool
+LLVMToSPIRV::transCachedFunction(Function *F, StringRef Entry) {
+  FunctionCacheEntry CE;
+  if (!CE.decode(Entry))
+    return false;
+  SPIRVWord NumLocals = CE.NumLocals;
+  std::vector<FunctionCacheSymbol> Externs(CE.Externs.size());
+  for (size_t I = 0, E = Externs.size(); I != E; ++I)
+    if (!parseFunctionCacheKey(F, CE.Externs[I], Externs[I]) ||
+        (Externs[I].Kind == 'x' && ExtSetId == SPIRVID_INVALID))
+      return false;
+
+  SPIRVDBG(dbgs() << "[transCachedFunction] " << F->getName() << '\n');
+  SPIRVFunction *BF = transFunctionDecl(F);
+  std::vector<SPIRVId> Ids(NumLocals + Externs.size());
+  for (size_t I = 0, IE = Externs.size(); I != IE; ++I) {
+    auto &Sym = Externs[I];
+    SPIRVEntry *E = nullptr;
+    switch (Sym.Kind) {
+    case 'x':
+      Ids[NumLocals + I] = ExtSetId;
+      continue;
+    case 'm':
+      E = getMemSetZeroPool();
+      break;
+    case 't':
+      E = transType(Sym.Ty);
+      break;
+    case 'a':
+      E = BF->getArgument(Sym.Literal);
+      break;
+    case 'l':
+      E = BM->getLiteralAsConstant(Sym.Literal);
+      break;
+    default:
+      E = transValue(Sym.V, nullptr);
+    }
+    if (!E || !E->hasId())
+      return false;
+    Ids[NumLocals + I] = E->getId();
+  }
+  SPIRVId FirstLocal = BM->getId(SPIRVID_INVALID, NumLocals);
+  for (SPIRVWord I = 0; I < NumLocals; ++I)
+    Ids[I] = FirstLocal + I;
+
+  std::vector<SPIRVWord> Words(CE.Code);
+  for (auto Pos : CE.IdWords)
+    Words[Pos] = Ids[CE.Code[Pos]];
+  SPIRVMemoryStreamBuf Buf(reinterpret_cast<const char *>(Words.data()),
+      Words.size() * sizeof(SPIRVWord));
+  std::istream IS(&Buf);
+  BF->decodeBasicBlocks(IS);
+
+  for (auto &I : CE.Names)
+    BM->setName(BM->getEntry(Ids[I.first]), I.second);
+  for (auto &I : CE.Decorates) {
+    auto E = BM->getEntry(Ids[I.first]);
+    auto Kind = static_cast<Decoration>(I.second[0]);
+    if (I.second.size() == 1)
+      E->addDecorate(Kind);
+    else
+      E->addDecorate(Kind, I.second[1]);
+  }
+  // Capabilities which the translation of an instruction adds besides the
+  // ones the instruction requires.
+  for (size_t I = 0, E = BF->getNumBasicBlock(); I != E; ++I) {
+    auto BB = BF->getBasicBlock(I);
+    for (size_t J = 0, JE = BB->getNumInst(); J != JE; ++J) {
+      auto Inst = BB->getInst(J);
+      if (isGroupOpCode(Inst->getOpCode()))
+        BM->addCapability(CapabilityGroups);
+      else if (Inst->getOpCode() == OpAtomicStore &&
+          static_cast<SPIRVInstTemplateBase *>(Inst)->getOperand(3)->
+              getType()->isTypeInt(64))
+        BM->addCapability(CapabilityInt64Atomics);
+    }
+  }
+  transRestrictDecoration(F, BF);
+  return true;
+}
+
+/// Encode the translated body of \p F for the translation cache.
+/// \returns false if it references an entity without a key in \p Keys.
+bool
+LLVMToSPIRV::encodeCachedFunction(Function *F,
+    const DenseMap<SPIRVId, std::string> &Keys, std::string &Entry) {
+  auto BF = static_cast<SPIRVFunction *>(getTranslatedValue(F));
+  FunctionCacheEntry CE;
+  std::vector<size_t> IdWords;
+  if (!BF || !BF->encodeBasicBlocks(CE.Code, IdWords))
+    return false;
+
+  DenseMap<SPIRVId, SPIRVWord> Symbols;
+  std::vector<SPIRVEntry *> Locals;
+  for (size_t I = 0, E = BF->getNumBasicBlock(); I != E; ++I) {
+    auto BB = BF->getBasicBlock(I);
+    Locals.push_back(BB);
+    for (size_t J = 0, JE = BB->getNumInst(); J != JE; ++J)
+      if (BB->getInst(J)->hasId())
+        Locals.push_back(BB->getInst(J));
+  }
+  for (size_t I = 0, E = Locals.size(); I != E; ++I)
+    Symbols[Locals[I]->getId()] = I;
+  CE.NumLocals = Locals.size();
+
+  for (auto Pos : IdWords) {
+    SPIRVId Id = CE.Code[Pos];
+    auto Loc = Symbols.find(Id);
+    if (Loc == Symbols.end()) {
+      std::string Key;
+      SPIRVEntry *E = nullptr;
+      auto KeyLoc = Keys.find(Id);
+      if (KeyLoc != Keys.end())
+        Key = KeyLoc->second;
+      else if (!BM->exist(Id, &E))
+        return false;
+      else if (E->getOpCode() == OpFunctionParameter)
+        Key = "a" + utostr(static_cast<SPIRVFunctionParameter *>(E)->
+            getArgNo()) + ".";
+      else if (E->getOpCode() == OpConstant &&
+          static_cast<SPIRVConstant *>(E)->getType()->isTypeInt(32))
+        Key = "l" + utohexstr(static_cast<SPIRVConstant *>(E)->
+            getZExtIntValue()) + ".";
+      else
+        return false;
+      Loc = Symbols.insert(std::make_pair(Id,
+          SPIRVWord(Locals.size() + CE.Externs.size()))).first;
+      CE.Externs.push_back(Key);
+    }
+    CE.Code[Pos] = Loc->second;
+    CE.IdWords.push_back(Pos);
+  }
+
+  for (size_t I = 0, E = Locals.size(); I != E; ++I) {
+    if (!Locals[I]->getName().empty())
+      CE.Names.push_back(std::make_pair(SPIRVWord(I), Locals[I]->getName()));
+    for (auto Dec : Locals[I]->getDecorates()) {
+      if (Dec->getLiteralCount() > 1)
+        return false;
+      std::vector<SPIRVWord> Words(1, Dec->getDecorateKind());
+      if (Dec->getLiteralCount())
+        Words.push_back(Dec->getLiteral(0));
+      CE.Decorates.push_back(std::make_pair(SPIRVWord(I), Words));
+    }
+  }
+  CE.encode(Entry);
+  return true;
+}
+
+/// Store the functions which were translated because they were not found in
+/// the translation cache.
+void
+LLVMToSPIRV::storeCachedFunctions(FunctionCacheMissVec &Misses) {
+  if (Misses.empty())
+    return;
+  // Keys of the module scope entities by the ids of their translations. The
+  // smallest key is kept if an entity has several, so that the entries do not
+  // depend on the order of the maps.
+  DenseMap<SPIRVId, std::string> Keys;
+  auto AddKey = [&](SPIRVId Id, const std::string &Key) {
+    auto Loc = Keys.insert(std::make_pair(Id, Key));
+    if (!Loc.second && Key < Loc.first->second)
+      Loc.first->second = Key;
+  };
+  for (auto &I : TypeMap) {
+    std::string Key;
+    raw_string_ostream OS(Key);
+    OS << 't';
+    if (I.second && writeFunctionCacheKey(OS, I.first))
+      AddKey(I.second->getId(), OS.str());
+  }
+  for (auto &I : ValueMap) {
+    if (!isa<Constant>(I.first) || !I.second || I.second->isForward() ||
+        !I.second->hasId())
+      continue;
+    std::string Key;
+    raw_string_ostream OS(Key);
+    if (writeFunctionCacheKey(OS, I.first))
+      AddKey(I.second->getId(), OS.str());
+  }
+  if (ExtSetId != SPIRVID_INVALID)
+    AddKey(ExtSetId, "x");
+  if (MemSetZeroPool)
+    AddKey(MemSetZeroPool->getId(), "m");
+
+  for (auto &I : Misses) {
+    std::string Entry;
+    if (encodeCachedFunction(I.first, Keys, Entry))
+      I.second.store(Entry, /*Prune=*/false);
+  }
+  Misses.front().second.prune();
 }
 
 bool
@@ -1522,8 +2081,22 @@ LLVMToSPIRV::translate() {
   }
   for (auto I:Decls)
     transFunctionDecl(I);
-  for (auto I:Defs)
+  FunctionCacheMissVec FunctionCacheMisses;
+  for (auto I:Defs) {
+    std::string Fingerprint;
+    if (isFunctionCacheEnabled() && getFunctionFingerprint(I, Fingerprint)) {
+      SPIRVTranslationCache Cache(Opts, "llvm-function-to-spirv",
+          Fingerprint);
+      if (Cache.lookup([&](StringRef Entry) {
+            return transCachedFunction(I, Entry);
+          })) {
+        ++NumFunctionCacheReuses;
+        continue;
+      }
+      FunctionCacheMisses.push_back(std::make_pair(I, Cache));
+    }
     transFunction(I);
+  }
 
   if (!transOCLKernelMetadata())
     return false;
@@ -1533,6 +2106,7 @@ LLVMToSPIRV::translate() {
   BM->optimizeDecorates();
   BM->resolveUnknownStructFields();
   BM->createForwardPointers();
+  storeCachedFunctions(FunctionCacheMisses);
   return true;
 }
 
@@ -1645,10 +2219,14 @@ LLVMToSPIRV::transOCLKernelMetadata() {
             [](const std::string &Str, SPIRVFunctionParameter *BA){
           if (Str.find("volatile") != std::string::npos)
             BA->addDecorate(new SPIRVDecorate(DecorationVolatile, BA));
-          if (Str.find("restrict") != std::string::npos)
+          // The attributes may already be translated from the noalias and
+          // readonly attributes of the argument.
+          if (Str.find("restrict") != std::string::npos &&
+              !BA->hasAttr(FunctionParameterAttributeNoAlias))
             BA->addDecorate(new SPIRVDecorate(DecorationFuncParamAttr,
                 BA, FunctionParameterAttributeNoAlias));
-          if (Str.find("const") != std::string::npos)
+          if (Str.find("const") != std::string::npos &&
+              !BA->hasAttr(FunctionParameterAttributeNoWrite))
             BA->addDecorate(new SPIRVDecorate(DecorationFuncParamAttr,
                 BA, FunctionParameterAttributeNoWrite));
           });
@@ -1826,45 +2404,122 @@ INITIALIZE_PASS_DEPENDENCY(OCLTypeToSPIRV)
 INITIALIZE_PASS_END(LLVMToSPIRV, "llvmtospv", "Translate LLVM to SPIR-V",
     false, false)
 
-ModulePass *llvm::createLLVMToSPIRV(SPIRVModule *SMod) {
-  return new LLVMToSPIRV(SMod);
+ModulePass *llvm::createLLVMToSPIRV(SPIRVModule *SMod,
+    const TranslatorOptions &Opts) {
+  return new LLVMToSPIRV(SMod, Opts);
 }
 
 void
-addPassesForSPIRV(legacy::PassManager &PassMgr) {
-  if (SPIRVMemToReg)
+addPassesForSPIRV(legacy::PassManager &PassMgr,
+    const TranslatorOptions &Opts) {
+  if (Opts.MemToReg)
     PassMgr.add(createPromoteMemoryToRegisterPass());
-  PassMgr.add(createTransOCLMD());
-  PassMgr.add(createOCL21ToSPIRV());
+  PassMgr.add(createTransOCLMD(Opts));
+  PassMgr.add(createOCL21ToSPIRV(Opts));
   PassMgr.add(createSPIRVLowerOCLBlocks());
   PassMgr.add(createOCLTypeToSPIRV());
-  PassMgr.add(createOCL20ToSPIRV());
-  PassMgr.add(createSPIRVRegularizeLLVM());
-  PassMgr.add(createSPIRVLowerConstExpr());
-  PassMgr.add(createSPIRVLowerBool());
-  PassMgr.add(createSPIRVLowerMemmove());
+  PassMgr.add(createOCL20ToSPIRV(Opts));
+  PassMgr.add(createSPIRVRegularizeLLVM(Opts));
+  PassMgr.add(createSPIRVLowerInst(Opts));
 }
 
 bool
 llvm::WriteSPIRV(Module *M, llvm::raw_ostream &OS, std::string &ErrMsg) {
+  return WriteSPIRV(M, OS, getDefaultTranslatorOptions(), ErrMsg);
+}
+
+static bool
+writeSPIRV(Module *M, llvm::raw_ostream &OS, const TranslatorOptions &Opts,
+    std::string &ErrMsg) {
   std::unique_ptr<SPIRVModule> BM(SPIRVModule::createSPIRVModule());
   legacy::PassManager PassMgr;
-  addPassesForSPIRV(PassMgr);
-  PassMgr.add(createLLVMToSPIRV(BM.get()));
+  addPassesForSPIRV(PassMgr, Opts);
+  PassMgr.add(createLLVMToSPIRV(BM.get(), Opts));
   PassMgr.run(*M);
-
   if (BM->getError(ErrMsg) != SPIRVEC_Success)
     return false;
+  if (!verifyTranslatedModule(*M, Opts, VerifyEndOfPipeline,
+      "LLVM to SPIR-V translation", &ErrMsg))
+    return false;
   OS << *BM;
   return true;
 }
 
+bool
+llvm::WriteSPIRV(Module *M, llvm::raw_ostream &OS,
+    const TranslatorOptions &Opts, std::string &ErrMsg) {
+  if (Opts.CacheDir.empty())
+    return writeSPIRV(M, OS, Opts, ErrMsg);
+
+  // The cache is keyed on the bitcode of the module, which is much cheaper
+  // to produce than its translation.
+  SmallString<0> Bitcode;
+  raw_svector_ostream BitcodeOS(Bitcode);
+  WriteBitcodeToFile(M, BitcodeOS);
+  SPIRVTranslationCache Cache(Opts, "llvm-to-spirv", Bitcode);
+  std::string Result;
+  if (!Cache.lookup([&](StringRef Entry) -> bool {
+        Result = Entry.str();
+        return true;
+      })) {
+    raw_string_ostream ResultOS(Result);
+    if (!writeSPIRV(M, ResultOS, Opts, ErrMsg))
+      return false;
+    Cache.store(ResultOS.str());
+  }
+  OS << Result;
+  return true;
+}
+
+namespace {
+/// Output stream appending SPIR-V binary directly to a vector of words.
+class SPIRVWordVectorOStream : public raw_ostream {
+public:
+  explicit SPIRVWordVectorOStream(SmallVectorImpl<uint32_t> &TheWords)
+    :Words(TheWords), Begin(TheWords.size()), Pos(0) {}
+  ~SPIRVWordVectorOStream() override { flush(); }
+
+private:
+  SmallVectorImpl<uint32_t> &Words;
+  size_t Begin; // Index of the first word written by this stream
+  uint64_t Pos; // Number of bytes written so far
+
+  void write_impl(const char *Ptr, size_t Size) override {
+    Words.resize(Begin + (Pos + Size + sizeof(uint32_t) - 1) /
+        sizeof(uint32_t));
+    memcpy(reinterpret_cast<char *>(Words.data() + Begin) + Pos, Ptr, Size);
+    Pos += Size;
+  }
+  uint64_t current_pos() const override { return Pos; }
+};
+} // anonymous namespace
+
+bool
+llvm::WriteSPIRV(Module *M, SmallVectorImpl<uint32_t> &Words,
+    std::string &ErrMsg) {
+  return WriteSPIRV(M, Words, getDefaultTranslatorOptions(), ErrMsg);
+}
+
+bool
+llvm::WriteSPIRV(Module *M, SmallVectorImpl<uint32_t> &Words,
+    const TranslatorOptions &Opts, std::string &ErrMsg) {
+  SPIRVWordVectorOStream OS(Words);
+  return WriteSPIRV(M, OS, Opts, ErrMsg);
+}
+
 bool
 llvm::RegularizeLLVMForSPIRV(Module *M, std::string &ErrMsg) {
+  return RegularizeLLVMForSPIRV(M, getDefaultTranslatorOptions(), ErrMsg);
+}
+
+bool
+llvm::RegularizeLLVMForSPIRV(Module *M, const TranslatorOptions &Opts,
+    std::string &ErrMsg) {
   std::unique_ptr<SPIRVModule> BM(SPIRVModule::createSPIRVModule());
   legacy::PassManager PassMgr;
-  addPassesForSPIRV(PassMgr);
+  addPassesForSPIRV(PassMgr, Opts);
   PassMgr.run(*M);
-  return true;
+  return verifyTranslatedModule(*M, Opts, VerifyEndOfPipeline,
+      "LLVM regularization", &ErrMsg);
 }
 
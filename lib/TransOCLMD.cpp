@@ -62,12 +62,14 @@ using namespace OCLUtil;
 
 namespace SPIRV {
 
-cl::opt<bool> EraseOCLMD("spirv-erase-cl-md", cl::init(true),
-    cl::desc("Erase OpenCL metadata"));
+cl::opt<bool, true> EraseOCLMD("spirv-erase-cl-md",
+    cl::desc("Erase OpenCL metadata"),
+    cl::location(getMutableDefaultTranslatorOptions().EraseOCLMD));
 
 class TransOCLMD: public ModulePass {
 public:
-  TransOCLMD():ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0) {
+  TransOCLMD(const TranslatorOptions &TheOpts = getDefaultTranslatorOptions())
+    :ModulePass(ID), M(nullptr), Ctx(nullptr), CLVer(0), Opts(TheOpts) {
     initializeTransOCLMDPass(*PassRegistry::getPassRegistry());
   }
 
@@ -79,6 +81,7 @@ private:
   Module *M;
   LLVMContext *Ctx;
   unsigned CLVer;                   /// OpenCL version as major*10+minor
+  TranslatorOptions Opts;
 };
 
 char TransOCLMD::ID = 0;
@@ -95,11 +98,7 @@ TransOCLMD::runOnModule(Module& Module) {
   visit(M);
 
   DEBUG(dbgs() << "After TransOCLMD:\n" << *M);
-  std::string Err;
-  raw_string_ostream ErrorOS(Err);
-  if (verifyModule(*M, &ErrorOS)){
-    DEBUG(errs() << "Fails to verify module: " << ErrorOS.str());
-  }
+  verifyTranslatedModule(*M, Opts, VerifyAfterEachPass, "TransOCLMD");
   return true;
 }
 
@@ -113,7 +112,7 @@ TransOCLMD::visit(Module *M) {
             : spv::SourceLanguageOpenCL_CPP)
         .add(CLVer)
         .done();
-  if (EraseOCLMD)
+  if (Opts.EraseOCLMD)
     B.eraseNamedMD(kSPIR2MD::OCLVer)
      .eraseNamedMD(kSPIR2MD::SPIRVer);
 
@@ -136,12 +135,12 @@ TransOCLMD::visit(Module *M) {
          .add(I)
          .done();
   }
-  if (EraseOCLMD)
+  if (Opts.EraseOCLMD)
     B.eraseNamedMD(kSPIR2MD::Extensions)
      .eraseNamedMD(kSPIR2MD::OptFeatures);
 
   bool HasFPContract = W.getNamedMD(kSPIR2MD::FPContract);
-  if (EraseOCLMD)
+  if (Opts.EraseOCLMD)
     B.eraseNamedMD(kSPIR2MD::FPContract);
 
   // Add entry points
@@ -217,6 +216,6 @@ TransOCLMD::visit(Module *M) {
 INITIALIZE_PASS(TransOCLMD, "clmdtospv", "Transform OCL metadata to SPIR-V",
     false, false)
 
-ModulePass *llvm::createTransOCLMD() {
-  return new TransOCLMD();
+ModulePass *llvm::createTransOCLMD(const TranslatorOptions &Opts) {
+  return new TransOCLMD(Opts);
 }
@@ -42,6 +42,8 @@
 #include "SPIRVValue.h"
 #include "SPIRVModule.h"
 
+#include <algorithm>
+
 namespace SPIRV{
 template<class T, class B>
 spv_ostream &
@@ -165,6 +167,14 @@ SPIRVGroupDecorateGeneric::decode(std::istream &I){
   Module->addGroupDecorateGeneric(this);
 }
 
+bool
+SPIRVGroupDecorateGeneric::eraseTargets(const std::set<SPIRVId> &Ids) {
+  Targets.erase(std::remove_if(Targets.begin(), Targets.end(),
+      [&](SPIRVId Id){ return Ids.count(Id) != 0; }), Targets.end());
+  WordCount = FixedWC + Targets.size();
+  return Targets.empty();
+}
+
 void
 SPIRVGroupDecorate::decorateTargets() {
   for(auto &I:Targets) {
@@ -43,6 +43,7 @@
 #include "SPIRVEntry.h"
 #include "SPIRVUtil.h"
 #include "SPIRVStream.h"
+#include <set>
 #include <string>
 #include <vector>
 #include <utility>
@@ -281,6 +282,8 @@ public:
     Targets.resize(WC - FixedWC);
   }
   virtual void decorateTargets() = 0;
+  // Remove the targets in Ids. Returns true if no target is left.
+  bool eraseTargets(const std::set<SPIRVId> &Ids);
   _SPIRV_DCL_ENCDEC
 protected:
   SPIRVDecorationGroup *DecorationGroup;
@@ -384,6 +384,14 @@ SPIRVEntry::getDecorate(Decoration Kind, size_t Index) const {
   return Value;
 }
 
+std::vector<const SPIRVDecorate *>
+SPIRVEntry::getDecorates() const {
+  std::vector<const SPIRVDecorate *> Decs;
+  for (auto &I : Decorates)
+    Decs.push_back(I.second);
+  return Decs;
+}
+
 bool
 SPIRVEntry::hasLinkageType() const {
   return OpCode == OpFunction || OpCode == OpVariable;
@@ -6,3 +6,5 @@ _SPIRV_OP(InvalidMemoryModel, "Expects 0-3.")
 _SPIRV_OP(InvalidFunctionControlMask,"")
 _SPIRV_OP(InvalidBuiltinSetName, "Expects OpenCL.std.")
 _SPIRV_OP(InvalidFunctionCall, "Unexpected llvm intrinsic:")
+_SPIRV_OP(InvalidKernelName, "Expects the name of a kernel in the module:")
+_SPIRV_OP(LinkError, "Fails to link SPIR-V modules:")
@@ -44,6 +44,8 @@
 
 #include <functional>
 #include <algorithm>
+#include <cstring>
+#include <sstream>
 using namespace SPIRV;
 
 SPIRVFunctionParameter::SPIRVFunctionParameter(SPIRVType *TheType, SPIRVId TheId,
@@ -127,6 +129,76 @@ SPIRVFunction::decode(std::istream &I) {
   }
 }
 
+bool
+SPIRVFunction::encodeBasicBlocks(std::vector<SPIRVWord> &Words,
+    std::vector<size_t> &IdWords) const {
+#ifdef _SPIRV_SUPPORT_TEXT_FMT
+  if (SPIRVUseTextFormat)
+    return false;
+#endif
+  for (auto BB : BBVec) {
+    std::string Buf;
+#ifdef _SPIRV_LLVM_API
+    llvm::raw_string_ostream OS(Buf);
+    OS << *BB;
+    OS.flush();
+#else
+    std::ostringstream OS;
+    OS << *BB;
+    Buf = OS.str();
+#endif
+    if (Buf.size() % sizeof(SPIRVWord))
+      return false;
+    size_t Begin = Words.size();
+    Words.resize(Begin + Buf.size() / sizeof(SPIRVWord));
+    if (!Buf.empty())
+      memcpy(&Words[Begin], Buf.data(), Buf.size());
+
+    // Walk the label and the instructions of the block, which must be all
+    // that was encoded besides the OpLine and OpNoLine preceding them.
+    size_t Pos = Begin;
+    for (size_t I = 0, E = BB->getNumInst(); I <= E;) {
+      if (Pos == Words.size())
+        return false;
+      SPIRVWord WC = Words[Pos] >> 16;
+      Op OC = static_cast<Op>(Words[Pos] & 0xFFFF);
+      std::vector<size_t> Ids;
+      bool IsLine = OC == OpLine || OC == OpNoLine;
+      if (IsLine) {
+        if (OC == OpLine)
+          Ids.push_back(0);
+      } else if (I == 0) {
+        if (OC != OpLabel)
+          return false;
+        Ids.push_back(0);
+      } else if (OC != BB->getInst(I - 1)->getOpCode() ||
+          !BB->getInst(I - 1)->getIdWords(Ids))
+        return false;
+      if (WC == 0 || Pos + WC > Words.size())
+        return false;
+      for (auto Id : Ids) {
+        if (Id + 1 >= WC)
+          return false;
+        IdWords.push_back(Pos + 1 + Id);
+      }
+      Pos += WC;
+      if (!IsLine)
+        ++I;
+    }
+    if (Pos != Words.size())
+      return false;
+  }
+  return true;
+}
+
+void
+SPIRVFunction::decodeBasicBlocks(std::istream &I) {
+  SPIRVDecoder Decoder = getDecoder(I);
+  Decoder.getWordCountAndOpCode();
+  while (Decoder.OpCode == OpLabel)
+    decodeBB(Decoder);
+}
+
 /// Decode basic block and contained instructions.
 /// Do it here instead of in BB:decode to avoid back track in input stream.
 void
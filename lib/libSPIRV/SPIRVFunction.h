@@ -128,9 +128,19 @@ public:
     BBVec.push_back(BB);
     return BB;
   }
+  // Drops the basic blocks, which are owned by the module.
+  void clearBasicBlocks() { BBVec.clear();}
 
   void encodeChildren(spv_ostream &) const override;
   void encodeExecutionModes(spv_ostream &) const;
+  /// Encode the basic blocks in binary form and collect the indices of the
+  /// words which are ids. Returns false if they cannot be told apart from
+  /// the literals.
+  bool encodeBasicBlocks(std::vector<SPIRVWord> &Words,
+      std::vector<size_t> &IdWords) const;
+  /// Decode basic blocks encoded by encodeBasicBlocks and add them to the
+  /// function.
+  void decodeBasicBlocks(std::istream &I);
   _SPIRV_DCL_ENCDEC
   void validate()const override{
     SPIRVValue::validate();
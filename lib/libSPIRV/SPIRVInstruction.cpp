@@ -134,6 +134,91 @@ SPIRVInstruction::getOperandTypes() {
   return getOperandTypes(getOperands());
 }
 
+bool
+SPIRVInstruction::getIdWords(std::vector<size_t> &IdWords) const {
+  size_t NumWords = WordCount - 1;
+  // Number of leading words which are ids. The remaining words are literals
+  // unless handled otherwise below.
+  size_t NumIds = 0;
+  switch (OpCode) {
+  case OpReturn:
+  case OpUnreachable:
+    break;
+  case OpSelectionMerge:
+  case OpLifetimeStart:
+  case OpLifetimeStop:
+    NumIds = 1;
+    break;
+  case OpStore:
+  case OpCopyMemory:
+  case OpLoopMerge:
+    NumIds = 2;
+    break;
+  case OpLoad:
+  case OpCopyMemorySized:
+  case OpBranchConditional:
+  case OpCompositeExtract:
+    NumIds = 3;
+    break;
+  case OpCompositeInsert:
+  case OpVectorShuffle:
+    NumIds = 4;
+    break;
+  case OpReturnValue:
+  case OpBranch:
+  case OpPhi:
+  case OpSelect:
+  case OpFMod:
+  case OpVectorTimesScalar:
+  case OpFunctionCall:
+  case OpCompositeConstruct:
+  case OpCopyObject:
+  case OpVectorExtractDynamic:
+  case OpVectorInsertDynamic:
+  case OpControlBarrier:
+  case OpGroupAsyncCopy:
+    NumIds = NumWords;
+    break;
+  case OpVariable:
+    // Type, Id, StorageClass [, Initializer]
+    for (size_t I = 0; I < NumWords; ++I)
+      if (I != 2)
+        IdWords.push_back(I);
+    return true;
+  case OpSwitch: {
+    // Selector, Default, then pairs of literals and a label.
+    IdWords.push_back(0);
+    IdWords.push_back(1);
+    size_t PairSize = static_cast<const SPIRVSwitch *>(this)->getPairSize();
+    for (size_t I = 1 + PairSize; I < NumWords; I += PairSize)
+      IdWords.push_back(I);
+    return true;
+  }
+  case OpExtInst:
+    // Type, Id, Set, Instruction, then the arguments.
+    for (size_t I = 0; I < NumWords; ++I)
+      if (I < 3 || (I > 3 && !isOperandLiteral(I - 4)))
+        IdWords.push_back(I);
+    return true;
+  default: {
+    if (!isInstTemplate())
+      return false;
+    size_t I = 0;
+    if (hasType())
+      IdWords.push_back(I++);
+    if (hasId())
+      IdWords.push_back(I++);
+    for (size_t Op = 0; I < NumWords; ++I, ++Op)
+      if (!isOperandLiteral(Op))
+        IdWords.push_back(I);
+    return true;
+  }
+  }
+  for (size_t I = 0; I < NumIds && I < NumWords; ++I)
+    IdWords.push_back(I);
+  return true;
+}
+
 bool
 isSpecConstantOpAllowedOp(Op OC) {
   static SPIRVWord Table[] =
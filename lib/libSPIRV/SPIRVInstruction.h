@@ -122,6 +122,13 @@ public:
   SPIRVInstruction(Op TheOC = OpNop):SPIRVValue(TheOC), BB(NULL){}
 
   virtual bool isInst() const override { return true;}
+  /// Whether the instruction is encoded as [Type] [Id] Ops by
+  /// SPIRVInstTemplateBase.
+  virtual bool isInstTemplate() const { return false;}
+  /// Get the indices of the words which are ids, counted from the first word
+  /// following the word count and op code of the encoded instruction.
+  /// \returns false if the layout of the instruction is unknown.
+  bool getIdWords(std::vector<size_t> &IdWords) const;
   SPIRVBasicBlock *getParent() const {return BB;}
   SPIRVInstruction *getPrevious() const { return BB->getPrevious(this);}
   SPIRVInstruction *getNext() const { return BB->getNext(this);}
@@ -240,6 +247,7 @@ public:
   virtual bool isOperandLiteral(unsigned I) const override {
     return Lit.count(I);
   }
+  virtual bool isInstTemplate() const override { return true;}
   void addLit(unsigned L) {
     if (L != ~0U)
       Lit.insert(L);
@@ -1023,11 +1031,16 @@ public:
   static const SPIRVWord FixedWordCount = 4;
 
   SPIRVLoopMerge(SPIRVId TheMergeBlock, SPIRVId TheContinueTarget,
-      SPIRVWord TheLoopControl, SPIRVBasicBlock *BB)
-      :SPIRVInstruction(FixedWordCount, OC, BB), MergeBlock(TheMergeBlock),
-      ContinueTarget(TheContinueTarget), LoopControl(TheLoopControl) {
+      SPIRVWord TheLoopControl, SPIRVBasicBlock *BB,
+      const std::vector<SPIRVWord> &TheLoopControlParameters =
+          std::vector<SPIRVWord>())
+      :SPIRVInstruction(FixedWordCount + TheLoopControlParameters.size(), OC,
+      BB), MergeBlock(TheMergeBlock), ContinueTarget(TheContinueTarget),
+      LoopControl(TheLoopControl),
+      LoopControlParameters(TheLoopControlParameters) {
     validate();
     assert(BB && "Invalid BB");
+    updateModuleVersion();
   }
 
   SPIRVLoopMerge() : SPIRVInstruction(OC), MergeBlock(SPIRVID_MAX),
@@ -1039,12 +1052,29 @@ public:
   SPIRVId getMergeBlock() { return MergeBlock; }
   SPIRVId getContinueTarget() { return ContinueTarget; }
   SPIRVWord getLoopControl() { return LoopControl; }
-  _SPIRV_DEF_ENCDEC3(MergeBlock, ContinueTarget, LoopControl)
+  // Literal operands following the loop control mask, e.g. the
+  // DependencyLength value introduced in SPIR-V 1.1.
+  const std::vector<SPIRVWord> &getLoopControlParameters() const {
+    return LoopControlParameters;
+  }
+  void setWordCount(SPIRVWord TheWordCount) override {
+    SPIRVEntry::setWordCount(TheWordCount);
+    LoopControlParameters.resize(TheWordCount - FixedWordCount);
+  }
+  SPIRVWord getRequiredSPIRVVersion() const override {
+    if (LoopControl & (LoopControlDependencyInfiniteMask |
+        LoopControlDependencyLengthMask))
+      return SPIRV_1_1;
+    return SPIRV_1_0;
+  }
+  _SPIRV_DEF_ENCDEC4(MergeBlock, ContinueTarget, LoopControl,
+      LoopControlParameters)
 
 protected:
   SPIRVId MergeBlock;
   SPIRVId ContinueTarget;
   SPIRVWord LoopControl;
+  std::vector<SPIRVWord> LoopControlParameters;
 };
 
 class SPIRVSwitch: public SPIRVInstruction {
@@ -0,0 +1,877 @@
+//===- SPIRVLinker.cpp - Link SPIR-V modules --------------------*- C++ -*-===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file implements the linker of SPIR-V modules.
+///
+/// The instructions preceding the functions are linked word by word, using
+/// the layout of their operands to tell ids from literals. The functions are
+/// taken from the decoded SPIRVModule, whose instructions know which of their
+/// words are ids.
+///
+//===----------------------------------------------------------------------===//
+
+#include "SPIRVLinker.h"
+#include "SPIRVFunction.h"
+#include "SPIRVInstruction.h"
+#include "SPIRVStream.h"
+#include "SPIRVValue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+
+using namespace SPIRV;
+
+namespace SPIRV {
+/// A module added to the linker.
+struct SPIRVLinkerInput {
+  const SPIRVWord *Words;
+  size_t NumWords;
+  std::unique_ptr<SPIRVModule> Module;
+  /// Offsets of the instructions preceding the functions.
+  std::vector<size_t> Insts;
+  /// Id in the linked module of each id of this one, or zero if the id has
+  /// not been mapped yet.
+  std::vector<SPIRVId> Map;
+  /// Resolved imports and their parameters, which are dropped together with
+  /// their names and decorations.
+  std::vector<bool> Dropped;
+  /// Decorations of each target without the target, sorted. The decorations
+  /// of a decoration group are applied to the targets of the group.
+  std::map<SPIRVId, std::vector<std::vector<SPIRVWord>>> Decorations;
+  std::set<SPIRVId> Groups;
+  std::map<SPIRVId, std::string> Names;
+};
+}
+
+static const size_t HeaderSize = 5;
+static const size_t NoResult = ~size_t(0);
+
+static SPIRVWord
+getWordCountOpCode(size_t WordCount, Op OC) {
+  return (static_cast<SPIRVWord>(WordCount) << 16) | OC;
+}
+
+/// Decode the literal string starting at operand \p I.
+/// \returns the number of words it takes, or zero if it is not terminated.
+static size_t
+decodeLiteralString(const SPIRVWord *Ops, size_t NumOps, size_t I,
+    std::string &Str) {
+  if (I >= NumOps)
+    return 0;
+  const char *Begin = reinterpret_cast<const char *>(Ops + I);
+  const char *End = reinterpret_cast<const char *>(Ops + NumOps);
+  const char *Nul = std::find(Begin, End, '\0');
+  if (Nul == End)
+    return 0;
+  Str.assign(Begin, Nul);
+  return (Nul - Begin) / sizeof(SPIRVWord) + 1;
+}
+
+static void
+appendLiteralStringInst(std::vector<SPIRVWord> &Words, Op OC,
+    const std::string &Str) {
+  size_t NumOps = Str.size() / sizeof(SPIRVWord) + 1;
+  Words.push_back(getWordCountOpCode(NumOps + 1, OC));
+  size_t Begin = Words.size();
+  Words.resize(Begin + NumOps, 0);
+  memcpy(&Words[Begin], Str.data(), Str.size());
+}
+
+/// Get the indices of the operands of an instruction preceding the functions
+/// which are ids, and the index of its result id in \p Result, or NoResult.
+/// \returns false if the instruction is not expected before the functions or
+/// has too few operands.
+static bool
+getModuleInstIds(Op OC, const SPIRVWord *Ops, size_t NumOps,
+    std::vector<size_t> &Ids, size_t &Result) {
+  std::string Str;
+  Result = NoResult;
+  switch (OC) {
+  case OpCapability:
+    return NumOps == 1;
+  case OpMemoryModel:
+    return NumOps == 2;
+  case OpNoLine:
+    return true;
+  case OpExtension:
+  case OpSourceExtension:
+  case OpSourceContinued:
+    return decodeLiteralString(Ops, NumOps, 0, Str) != 0;
+  case OpExtInstImport:
+  case OpString:
+    Result = 0;
+    Ids.push_back(0);
+    return decodeLiteralString(Ops, NumOps, 1, Str) != 0;
+  case OpDecorationGroup:
+    Result = 0;
+    Ids.push_back(0);
+    return NumOps == 1;
+  case OpSource:
+    if (NumOps > 2)
+      Ids.push_back(2);
+    return NumOps >= 2;
+  case OpEntryPoint: {
+    size_t Len = decodeLiteralString(Ops, NumOps, 2, Str);
+    Ids.push_back(1);
+    for (size_t I = 2 + Len; I < NumOps; ++I)
+      Ids.push_back(I);
+    return Len != 0;
+  }
+  case OpName:
+    Ids.push_back(0);
+    return decodeLiteralString(Ops, NumOps, 1, Str) != 0;
+  case OpMemberName:
+    Ids.push_back(0);
+    return decodeLiteralString(Ops, NumOps, 2, Str) != 0;
+  case OpExecutionMode:
+  case OpDecorate:
+    Ids.push_back(0);
+    return NumOps >= 2;
+  case OpMemberDecorate:
+  case OpLine:
+    Ids.push_back(0);
+    return NumOps >= 3;
+  case OpGroupDecorate:
+    for (size_t I = 0; I < NumOps; ++I)
+      Ids.push_back(I);
+    return NumOps >= 1;
+  case OpGroupMemberDecorate:
+    // The group, then pairs of a target and a member.
+    Ids.push_back(0);
+    for (size_t I = 1; I < NumOps; I += 2)
+      Ids.push_back(I);
+    return NumOps % 2 == 1;
+  case OpTypeForwardPointer:
+    Ids.push_back(0);
+    return NumOps == 2;
+  default:
+    break;
+  }
+
+  if (isTypeOpCode(OC)) {
+    Result = 0;
+    Ids.push_back(0);
+    switch (OC) {
+    case OpTypeVector:
+    case OpTypeMatrix:
+    case OpTypeImage:
+    case OpTypeSampledImage:
+    case OpTypeRuntimeArray:
+      Ids.push_back(1);
+      break;
+    case OpTypeArray:
+      Ids.push_back(1);
+      Ids.push_back(2);
+      break;
+    case OpTypePointer:
+      Ids.push_back(2);
+      break;
+    case OpTypeStruct:
+    case OpTypeFunction:
+      for (size_t I = 1; I < NumOps; ++I)
+        Ids.push_back(I);
+      break;
+    default:
+      break;
+    }
+    return Ids.back() < NumOps;
+  }
+
+  if (!isConstantOpCode(OC) && OC != OpVariable)
+    return false;
+  // Type, Id, then the operands.
+  Result = 1;
+  Ids.push_back(0);
+  Ids.push_back(1);
+  size_t First = NumOps;
+  size_t Last = NumOps;
+  switch (OC) {
+  case OpConstantComposite:
+  case OpSpecConstantComposite:
+    First = 2;
+    break;
+  case OpVariable:
+    // Storage class, then the optional initializer.
+    First = 3;
+    break;
+  case OpSpecConstantOp:
+    // Operation, then its operands, whose trailing literals are indices.
+    First = 3;
+    if (NumOps < 3)
+      return false;
+    if (Ops[2] == OpCompositeExtract)
+      Last = std::min<size_t>(NumOps, 4);
+    else if (Ops[2] == OpCompositeInsert || Ops[2] == OpVectorShuffle)
+      Last = std::min<size_t>(NumOps, 5);
+    break;
+  default:
+    break;
+  }
+  for (size_t I = First; I < Last; ++I)
+    Ids.push_back(I);
+  return NumOps >= 2;
+}
+
+/// Types and constants with the same operands and decorations are unified,
+/// unless they are specialization constants.
+static bool
+isUnifiable(Op OC) {
+  return isTypeOpCode(OC) || (isConstantOpCode(OC) &&
+      (OC < OpSpecConstantTrue || OC > OpSpecConstantOp));
+}
+
+namespace {
+/// A function or global variable resolving the imports of its name: the one
+/// exported with the name or, if there is none, its first import.
+struct LinkedSymbol {
+  SPIRVLinkerInput *In;
+  SPIRVEntry *Entry;
+};
+
+/// A type, constant or global variable referring to ids which are not
+/// defined yet in the linked module, e.g. a global variable initialized with
+/// an import resolved by a later module. It is appended to the globals once
+/// all of them are.
+struct DeferredGlobal {
+  /// The instruction with its ids mapped.
+  std::vector<SPIRVWord> Inst;
+  /// The OpLine in effect for the instruction with its ids mapped, or empty.
+  std::vector<SPIRVWord> Line;
+  SPIRVId Result;
+  std::vector<SPIRVId> Operands;
+};
+
+/// The state of one link of SPIRVLinker.
+class SPIRVModuleLinker {
+public:
+  SPIRVModuleLinker(std::vector<std::unique_ptr<SPIRVLinkerInput>> &TheInputs,
+      SPIRVErrorLog &TheErrLog);
+
+  bool link(spv_ostream &O);
+  SPIRVErrorLog &getErrorLog() { return ErrLog;}
+
+private:
+  std::vector<std::unique_ptr<SPIRVLinkerInput>> &Inputs;
+  SPIRVErrorLog &ErrLog;
+  SPIRVId NextId;
+  bool InvalidId;
+  SPIRVWord Version;
+  std::set<SPIRVWord> Capabilities;
+  std::set<std::string> Extensions;
+  std::set<std::string> SourceExtensions;
+  std::map<std::string, SPIRVId> ExtInstImports;
+  std::vector<SPIRVWord> MemoryModel;
+  SPIRVLinkerInput *SourceInput;
+  std::map<std::string, LinkedSymbol> Symbols;
+  std::vector<std::pair<LinkedSymbol, LinkedSymbol>> ResolvedImports;
+  std::set<std::pair<SPIRVWord, std::string>> EntryPointNames;
+  std::set<SPIRVId> NamedIds;
+  std::set<std::pair<SPIRVId, SPIRVWord>> NamedMembers;
+  std::set<std::vector<SPIRVWord>> AnnotationSet;
+  std::map<std::vector<SPIRVWord>, SPIRVId> UniqueValues;
+  /// Ids defined by the globals, or declared by an OpTypeForwardPointer.
+  std::set<SPIRVId> DefinedGlobals;
+  std::vector<DeferredGlobal> DeferredGlobals;
+  /// The OpLine in effect at the end of the globals, or empty.
+  std::vector<SPIRVWord> GlobalLine;
+
+  // The sections of the linked module, in their order.
+  std::vector<SPIRVWord> ExtInstImportInsts;
+  std::vector<SPIRVWord> EntryPoints;
+  std::vector<SPIRVWord> ExecutionModes;
+  std::vector<SPIRVWord> Debug;
+  std::vector<SPIRVWord> Names;
+  std::vector<SPIRVWord> Annotations;
+  std::vector<SPIRVWord> Globals;
+  std::vector<SPIRVWord> Declarations;
+  std::vector<SPIRVWord> Definitions;
+
+  SPIRVId mapId(SPIRVLinkerInput &In, SPIRVId Id);
+  bool isDropped(const SPIRVLinkerInput &In, SPIRVId Id) const {
+    return Id < In.Dropped.size() && In.Dropped[Id];
+  }
+  void appendInst(std::vector<SPIRVWord> &Section, SPIRVLinkerInput &In,
+      const SPIRVWord *W);
+  void collectDecorations(SPIRVLinkerInput &In);
+  bool resolveLinkage();
+  bool linkGlobals(SPIRVLinkerInput &In);
+  void linkGlobal(SPIRVLinkerInput &In, const SPIRVWord *W);
+  bool isDefined(const DeferredGlobal &G) const;
+  void appendGlobal(const DeferredGlobal &G);
+  void setGlobalLine(const std::vector<SPIRVWord> &Line);
+  bool linkDebugAndAnnotations(SPIRVLinkerInput &In);
+  bool checkResolvedImports();
+  bool linkFunctions(SPIRVLinkerInput &In);
+  void write(spv_ostream &O);
+};
+} // anonymous namespace
+
+SPIRVModuleLinker::SPIRVModuleLinker(
+    std::vector<std::unique_ptr<SPIRVLinkerInput>> &TheInputs,
+    SPIRVErrorLog &TheErrLog)
+  :Inputs(TheInputs), ErrLog(TheErrLog), NextId(1), InvalidId(false),
+   Version(0), SourceInput(nullptr) {
+  for (auto &In : Inputs) {
+    In->Map.assign(In->Words[3], 0);
+    In->Dropped.assign(In->Words[3], false);
+    In->Decorations.clear();
+    In->Groups.clear();
+    In->Names.clear();
+    Version = std::max(Version, In->Words[1]);
+  }
+}
+
+SPIRVId
+SPIRVModuleLinker::mapId(SPIRVLinkerInput &In, SPIRVId Id) {
+  if (Id == 0 || Id >= In.Map.size()) {
+    InvalidId = true;
+    return 0;
+  }
+  if (!In.Map[Id])
+    In.Map[Id] = NextId++;
+  return In.Map[Id];
+}
+
+/// Append the instruction at \p W with all its ids mapped to \p Section.
+void
+SPIRVModuleLinker::appendInst(std::vector<SPIRVWord> &Section,
+    SPIRVLinkerInput &In, const SPIRVWord *W) {
+  size_t WC = W[0] >> 16;
+  std::vector<size_t> Ids;
+  size_t Result;
+  getModuleInstIds(static_cast<Op>(W[0] & 0xFFFF), W + 1, WC - 1, Ids,
+      Result);
+  size_t Begin = Section.size();
+  Section.insert(Section.end(), W, W + WC);
+  for (auto I : Ids)
+    Section[Begin + 1 + I] = mapId(In, W[1 + I]);
+}
+
+void
+SPIRVModuleLinker::collectDecorations(SPIRVLinkerInput &In) {
+  for (auto Off : In.Insts) {
+    const SPIRVWord *W = In.Words + Off;
+    size_t NumOps = (W[0] >> 16) - 1;
+    const SPIRVWord *Ops = W + 1;
+    switch (static_cast<Op>(W[0] & 0xFFFF)) {
+    case OpName:
+      decodeLiteralString(Ops, NumOps, 1, In.Names[Ops[0]]);
+      break;
+    case OpDecorate:
+    case OpMemberDecorate: {
+      std::vector<SPIRVWord> Dec(1, W[0] & 0xFFFF);
+      Dec.insert(Dec.end(), Ops + 1, Ops + NumOps);
+      In.Decorations[Ops[0]].push_back(Dec);
+      break;
+    }
+    case OpDecorationGroup:
+      In.Groups.insert(Ops[0]);
+      break;
+    case OpGroupDecorate: {
+      auto Group = In.Decorations[Ops[0]];
+      for (size_t I = 1; I < NumOps; ++I) {
+        auto &Decs = In.Decorations[Ops[I]];
+        Decs.insert(Decs.end(), Group.begin(), Group.end());
+      }
+      break;
+    }
+    case OpGroupMemberDecorate: {
+      auto Group = In.Decorations[Ops[0]];
+      for (size_t I = 1; I < NumOps; I += 2)
+        for (auto &D : Group) {
+          std::vector<SPIRVWord> Dec;
+          Dec.push_back(OpMemberDecorate);
+          Dec.push_back(Ops[I + 1]);
+          Dec.insert(Dec.end(), D.begin() + 1, D.end());
+          In.Decorations[Ops[I]].push_back(Dec);
+        }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+  for (auto &I : In.Decorations)
+    std::sort(I.second.begin(), I.second.end());
+}
+
+bool
+SPIRVModuleLinker::resolveLinkage() {
+  std::vector<LinkedSymbol> Imports;
+  for (auto &In : Inputs) {
+    auto Visit = [&](SPIRVEntry *E) {
+      if (!E->hasLinkageType())
+        return true;
+      LinkedSymbol Sym = {In.get(), E};
+      if (E->getLinkageType() == LinkageTypeImport)
+        Imports.push_back(Sym);
+      else if (E->getLinkageType() == LinkageTypeExport) {
+        SPIRVCKRT(Symbols.insert(std::make_pair(E->getName(), Sym)).second,
+            LinkError, "Duplicate export of " + E->getName());
+        mapId(*In, E->getId());
+      }
+      return true;
+    };
+    SPIRVModule *M = In->Module.get();
+    for (unsigned I = 0, E = M->getNumFunctions(); I < E; ++I)
+      if (!Visit(M->getFunction(I)))
+        return false;
+    for (unsigned I = 0, E = M->getNumVariables(); I < E; ++I)
+      if (!Visit(M->getVariable(I)))
+        return false;
+  }
+
+  for (auto &Imp : Imports) {
+    const std::string &Name = Imp.Entry->getName();
+    auto Loc = Symbols.insert(std::make_pair(Name, Imp));
+    if (Loc.second) {
+      mapId(*Imp.In, Imp.Entry->getId());
+      continue;
+    }
+    LinkedSymbol &Def = Loc.first->second;
+    SPIRVCKRT(Def.Entry->getOpCode() == Imp.Entry->getOpCode(), LinkError,
+        "Import of " + Name + " does not match its export");
+    SPIRVId Id = Imp.Entry->getId();
+    if (Id >= Imp.In->Map.size()) {
+      InvalidId = true;
+      continue;
+    }
+    Imp.In->Map[Id] = mapId(*Def.In, Def.Entry->getId());
+    Imp.In->Dropped[Id] = true;
+    if (Imp.Entry->getOpCode() == OpFunction) {
+      auto F = static_cast<SPIRVFunction *>(Imp.Entry);
+      for (size_t I = 0, E = F->getNumArguments(); I < E; ++I)
+        if (F->getArgumentId(I) < Imp.In->Dropped.size())
+          Imp.In->Dropped[F->getArgumentId(I)] = true;
+    }
+    ResolvedImports.push_back(std::make_pair(Imp, Def));
+  }
+  return true;
+}
+
+bool
+SPIRVModuleLinker::linkGlobals(SPIRVLinkerInput &In) {
+  for (auto Off : In.Insts) {
+    const SPIRVWord *W = In.Words + Off;
+    Op OC = static_cast<Op>(W[0] & 0xFFFF);
+    size_t NumOps = (W[0] >> 16) - 1;
+    const SPIRVWord *Ops = W + 1;
+    std::string Str;
+    switch (OC) {
+    case OpCapability:
+      Capabilities.insert(Ops[0]);
+      break;
+    case OpExtension:
+      decodeLiteralString(Ops, NumOps, 0, Str);
+      Extensions.insert(Str);
+      break;
+    case OpExtInstImport: {
+      decodeLiteralString(Ops, NumOps, 1, Str);
+      auto Loc = ExtInstImports.find(Str);
+      if (Loc == ExtInstImports.end()) {
+        ExtInstImports[Str] = mapId(In, Ops[0]);
+        appendInst(ExtInstImportInsts, In, W);
+      } else if (Ops[0] < In.Map.size())
+        In.Map[Ops[0]] = Loc->second;
+      break;
+    }
+    case OpMemoryModel:
+      if (MemoryModel.empty())
+        MemoryModel.assign(Ops, Ops + NumOps);
+      SPIRVCKRT(std::equal(Ops, Ops + NumOps, MemoryModel.begin()), LinkError,
+          "Modules with different memory models");
+      break;
+    case OpLine:
+    case OpNoLine:
+    case OpTypeForwardPointer:
+    case OpVariable:
+      linkGlobal(In, W);
+      break;
+    default:
+      if (isTypeOpCode(OC) || isConstantOpCode(OC))
+        linkGlobal(In, W);
+      break;
+    }
+  }
+  return true;
+}
+
+/// Append a type, constant, global variable or line to the globals, unless
+/// it is a resolved import or an identical type or constant is there already.
+/// An instruction referring to ids not defined yet is deferred until they
+/// are.
+void
+SPIRVModuleLinker::linkGlobal(SPIRVLinkerInput &In, const SPIRVWord *W) {
+  size_t WC = W[0] >> 16;
+  Op OC = static_cast<Op>(W[0] & 0xFFFF);
+  const SPIRVWord *Ops = W + 1;
+  std::vector<size_t> Ids;
+  size_t Result;
+  getModuleInstIds(OC, Ops, WC - 1, Ids, Result);
+  if (Result == NoResult) {
+    appendInst(Globals, In, W);
+    if (OC == OpLine)
+      GlobalLine.assign(Globals.end() - WC, Globals.end());
+    else if (OC == OpNoLine)
+      GlobalLine.clear();
+    else if (OC == OpTypeForwardPointer)
+      DefinedGlobals.insert(mapId(In, Ops[0]));
+    return;
+  }
+  SPIRVId Id = Ops[Result];
+  if (isDropped(In, Id))
+    return;
+
+  std::vector<SPIRVWord> Inst(W, W + WC);
+  for (auto I : Ids)
+    if (I != Result)
+      Inst[1 + I] = mapId(In, Ops[I]);
+  // An id mapped already, e.g. by a forward pointer or an export, is kept.
+  if (isUnifiable(OC) && Id < In.Map.size() && !In.Map[Id]) {
+    std::vector<SPIRVWord> Key(Inst);
+    Key[1 + Result] = 0;
+    auto Decs = In.Decorations.find(Id);
+    if (Decs != In.Decorations.end()) {
+      Key.push_back(Decs->second.size());
+      for (auto &D : Decs->second) {
+        Key.push_back(D.size());
+        Key.insert(Key.end(), D.begin(), D.end());
+      }
+    }
+    // Structs with the same members but different names are different
+    // types, e.g. OpenCL opaque types.
+    auto Name = In.Names.find(Id);
+    if (OC == OpTypeStruct && Name != In.Names.end()) {
+      Key.push_back(Name->second.size());
+      Key.insert(Key.end(), Name->second.begin(), Name->second.end());
+    }
+    auto Loc = UniqueValues.insert(std::make_pair(Key, 0));
+    if (!Loc.second) {
+      In.Map[Id] = Loc.first->second;
+      return;
+    }
+    Loc.first->second = mapId(In, Id);
+  }
+  Inst[1 + Result] = mapId(In, Id);
+
+  DeferredGlobal G;
+  G.Inst.swap(Inst);
+  G.Line = GlobalLine;
+  G.Result = G.Inst[1 + Result];
+  for (auto I : Ids)
+    if (I != Result)
+      G.Operands.push_back(G.Inst[1 + I]);
+  if (!isDefined(G)) {
+    DeferredGlobals.push_back(std::move(G));
+    return;
+  }
+  // The globals released by this one may have lines of their own, after
+  // which the line of the following instructions is restored.
+  std::vector<SPIRVWord> Line(GlobalLine);
+  appendGlobal(G);
+  setGlobalLine(Line);
+}
+
+bool
+SPIRVModuleLinker::isDefined(const DeferredGlobal &G) const {
+  for (auto Id : G.Operands)
+    if (!DefinedGlobals.count(Id))
+      return false;
+  return true;
+}
+
+/// Append \p G to the globals, followed by the deferred globals which only
+/// waited for it.
+void
+SPIRVModuleLinker::appendGlobal(const DeferredGlobal &G) {
+  setGlobalLine(G.Line);
+  Globals.insert(Globals.end(), G.Inst.begin(), G.Inst.end());
+  DefinedGlobals.insert(G.Result);
+  for (;;) {
+    auto Ready = std::find_if(DeferredGlobals.begin(), DeferredGlobals.end(),
+        [&](const DeferredGlobal &D) { return isDefined(D); });
+    if (Ready == DeferredGlobals.end())
+      return;
+    DeferredGlobal D = std::move(*Ready);
+    DeferredGlobals.erase(Ready);
+    appendGlobal(D);
+  }
+}
+
+void
+SPIRVModuleLinker::setGlobalLine(const std::vector<SPIRVWord> &Line) {
+  if (Line == GlobalLine)
+    return;
+  if (Line.empty())
+    Globals.push_back(getWordCountOpCode(1, OpNoLine));
+  else
+    Globals.insert(Globals.end(), Line.begin(), Line.end());
+  GlobalLine = Line;
+}
+
+bool
+SPIRVModuleLinker::linkDebugAndAnnotations(SPIRVLinkerInput &In) {
+  for (auto Off : In.Insts) {
+    const SPIRVWord *W = In.Words + Off;
+    Op OC = static_cast<Op>(W[0] & 0xFFFF);
+    size_t NumOps = (W[0] >> 16) - 1;
+    const SPIRVWord *Ops = W + 1;
+    std::string Str;
+    switch (OC) {
+    case OpEntryPoint:
+      decodeLiteralString(Ops, NumOps, 2, Str);
+      SPIRVCKRT(EntryPointNames.insert(std::make_pair(Ops[0], Str)).second,
+          LinkError, "Duplicate entry point " + Str);
+      appendInst(EntryPoints, In, W);
+      break;
+    case OpExecutionMode:
+      appendInst(ExecutionModes, In, W);
+      break;
+    case OpString:
+      appendInst(Debug, In, W);
+      break;
+    case OpSource:
+      // The source language of the first module is kept.
+      if (!SourceInput)
+        SourceInput = &In;
+      if (SourceInput == &In)
+        appendInst(Debug, In, W);
+      break;
+    case OpSourceContinued:
+      if (SourceInput == &In)
+        appendInst(Debug, In, W);
+      break;
+    case OpSourceExtension:
+      decodeLiteralString(Ops, NumOps, 0, Str);
+      SourceExtensions.insert(Str);
+      break;
+    case OpName:
+      if (!isDropped(In, Ops[0]) && NamedIds.insert(mapId(In, Ops[0])).second)
+        appendInst(Names, In, W);
+      break;
+    case OpMemberName:
+      if (NamedMembers.insert(std::make_pair(mapId(In, Ops[0]),
+          Ops[1])).second)
+        appendInst(Names, In, W);
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Decoration groups are not kept, their decorations are applied to the
+  // targets directly, so that the decorations of unified types and
+  // constants can be merged.
+  for (auto &I : In.Decorations) {
+    if (In.Groups.count(I.first) || isDropped(In, I.first))
+      continue;
+    SPIRVId Target = mapId(In, I.first);
+    for (auto &D : I.second) {
+      std::vector<SPIRVWord> Inst;
+      Inst.push_back(getWordCountOpCode(D.size() + 1, static_cast<Op>(D[0])));
+      Inst.push_back(Target);
+      Inst.insert(Inst.end(), D.begin() + 1, D.end());
+      if (AnnotationSet.insert(Inst).second)
+        Annotations.insert(Annotations.end(), Inst.begin(), Inst.end());
+    }
+  }
+  return true;
+}
+
+bool
+SPIRVModuleLinker::checkResolvedImports() {
+  auto GetTypeId = [](SPIRVEntry *E) {
+    if (E->getOpCode() == OpFunction)
+      return static_cast<SPIRVFunction *>(E)->getFunctionType()->getId();
+    return static_cast<SPIRVValue *>(E)->getType()->getId();
+  };
+  for (auto &I : ResolvedImports) {
+    const LinkedSymbol &Imp = I.first;
+    const LinkedSymbol &Def = I.second;
+    SPIRVCKRT(mapId(*Imp.In, GetTypeId(Imp.Entry)) ==
+        mapId(*Def.In, GetTypeId(Def.Entry)), LinkError,
+        "Type of the import of " + Imp.Entry->getName() +
+        " does not match its export");
+  }
+  return true;
+}
+
+bool
+SPIRVModuleLinker::linkFunctions(SPIRVLinkerInput &In) {
+  SPIRVModule *M = In.Module.get();
+  for (unsigned I = 0, E = M->getNumFunctions(); I < E; ++I) {
+    SPIRVFunction *F = M->getFunction(I);
+    if (isDropped(In, F->getId()))
+      continue;
+    std::vector<SPIRVWord> Body;
+    std::vector<size_t> IdWords;
+    M->setCurrentLine(nullptr);
+    SPIRVCKRT(F->encodeBasicBlocks(Body, IdWords), LinkError,
+        "Unsupported instruction in function " + F->getName());
+    for (auto W : IdWords)
+      Body[W] = mapId(In, Body[W]);
+
+    // Function declarations precede the definitions.
+    auto &Section = F->getNumBasicBlock() ? Definitions : Declarations;
+    Section.push_back(getWordCountOpCode(5, OpFunction));
+    Section.push_back(mapId(In, F->getType()->getId()));
+    Section.push_back(mapId(In, F->getId()));
+    Section.push_back(F->getFuncCtlMask());
+    Section.push_back(mapId(In, F->getFunctionType()->getId()));
+    for (size_t A = 0, AE = F->getNumArguments(); A < AE; ++A) {
+      SPIRVFunctionParameter *Arg = F->getArgument(A);
+      Section.push_back(getWordCountOpCode(3, OpFunctionParameter));
+      Section.push_back(mapId(In, Arg->getType()->getId()));
+      Section.push_back(mapId(In, Arg->getId()));
+    }
+    Section.insert(Section.end(), Body.begin(), Body.end());
+    Section.push_back(getWordCountOpCode(1, OpFunctionEnd));
+  }
+  return true;
+}
+
+void
+SPIRVModuleLinker::write(spv_ostream &O) {
+  std::vector<SPIRVWord> Words;
+  Words.push_back(MagicNumber);
+  Words.push_back(Version);
+  Words.push_back(Inputs.front()->Words[2]);
+  Words.push_back(NextId);
+  Words.push_back(0);
+  for (auto Cap : Capabilities) {
+    Words.push_back(getWordCountOpCode(2, OpCapability));
+    Words.push_back(Cap);
+  }
+  for (auto &Ext : Extensions)
+    appendLiteralStringInst(Words, OpExtension, Ext);
+  Words.insert(Words.end(), ExtInstImportInsts.begin(),
+      ExtInstImportInsts.end());
+  if (!MemoryModel.empty()) {
+    Words.push_back(getWordCountOpCode(MemoryModel.size() + 1,
+        OpMemoryModel));
+    Words.insert(Words.end(), MemoryModel.begin(), MemoryModel.end());
+  }
+  Words.insert(Words.end(), EntryPoints.begin(), EntryPoints.end());
+  Words.insert(Words.end(), ExecutionModes.begin(), ExecutionModes.end());
+  for (auto &Ext : SourceExtensions)
+    appendLiteralStringInst(Words, OpSourceExtension, Ext);
+  for (auto Section : {&Debug, &Names, &Annotations, &Globals, &Declarations,
+      &Definitions})
+    Words.insert(Words.end(), Section->begin(), Section->end());
+  O.write(reinterpret_cast<const char *>(Words.data()),
+      Words.size() * sizeof(SPIRVWord));
+}
+
+bool
+SPIRVModuleLinker::link(spv_ostream &O) {
+  SPIRVCKRT(!Inputs.empty(), LinkError, "No module to link");
+  for (auto &In : Inputs)
+    collectDecorations(*In);
+  if (!resolveLinkage())
+    return false;
+  // Types and constants are unified before anything refers to them by
+  // their linked ids.
+  for (auto &In : Inputs)
+    if (!linkGlobals(*In))
+      return false;
+  // Invalid ids are never defined, so they are reported as such below.
+  SPIRVCKRT(DeferredGlobals.empty() || InvalidId, LinkError,
+      "Cyclic references between global variables");
+  for (auto &In : Inputs)
+    if (!linkDebugAndAnnotations(*In))
+      return false;
+  if (!checkResolvedImports())
+    return false;
+  for (auto &In : Inputs)
+    if (!linkFunctions(*In))
+      return false;
+  SPIRVCKRT(!InvalidId, LinkError, "Invalid id");
+  write(O);
+  return true;
+}
+
+SPIRVLinker::SPIRVLinker() {
+}
+
+SPIRVLinker::~SPIRVLinker() {
+}
+
+bool
+SPIRVLinker::addModule(const SPIRVWord *Words, size_t NumWords) {
+#ifdef _SPIRV_SUPPORT_TEXT_FMT
+  SPIRVCKRT(!SPIRVUseTextFormat, LinkError,
+      "Only SPIR-V binary can be linked");
+#endif
+  SPIRVCKRT(NumWords >= HeaderSize && Words[0] == MagicNumber, LinkError,
+      "Invalid SPIR-V binary");
+  std::unique_ptr<SPIRVLinkerInput> In(new SPIRVLinkerInput);
+  In->Words = Words;
+  In->NumWords = NumWords;
+  for (size_t Pos = HeaderSize; Pos < NumWords;) {
+    size_t WC = Words[Pos] >> 16;
+    Op OC = static_cast<Op>(Words[Pos] & 0xFFFF);
+    SPIRVCKRT(WC && Pos + WC <= NumWords, LinkError,
+        "Invalid word count of instruction " + OpCodeNameMap::map(OC));
+    if (OC == OpFunction)
+      break;
+    std::vector<size_t> Ids;
+    size_t Result;
+    SPIRVCKRT(getModuleInstIds(OC, Words + Pos + 1, WC - 1, Ids, Result) &&
+        (Ids.empty() || Ids.back() < WC - 1), LinkError,
+        "Unsupported instruction " + OpCodeNameMap::map(OC));
+    In->Insts.push_back(Pos);
+    Pos += WC;
+  }
+
+  In->Module.reset(SPIRVModule::createSPIRVModule());
+  SPIRVMemoryStreamBuf Buf(reinterpret_cast<const char *>(Words),
+      NumWords * sizeof(SPIRVWord));
+  std::istream IS(&Buf);
+  IS >> *In->Module;
+  std::string ErrMsg;
+  SPIRVCKRT(In->Module->getError(ErrMsg) == SPIRVEC_Success, LinkError,
+      ErrMsg);
+  Inputs.push_back(std::move(In));
+  return true;
+}
+
+bool
+SPIRVLinker::link(spv_ostream &O) {
+  SPIRVModuleLinker Linker(Inputs, ErrLog);
+  return Linker.link(O);
+}
@@ -0,0 +1,90 @@
+//===- SPIRVLinker.h - Link SPIR-V modules ----------------------*- C++ -*-===//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Copyright (c) 2014 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines the linker of SPIR-V modules, which works on the SPIR-V
+/// binary and SPIRVModule without translating the modules to LLVM.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef SPIRVLINKER_H
+#define SPIRVLINKER_H
+
+#include "SPIRVError.h"
+#include "SPIRVModule.h"
+
+#include <memory>
+#include <vector>
+
+namespace SPIRV {
+
+struct SPIRVLinkerInput;
+
+/// Links SPIR-V binary modules into one.
+///
+/// A function or global variable imported by the LinkageAttributes
+/// decoration of a module is resolved to the one exported with the same name
+/// by another module, and the imports of a name which is not exported are
+/// merged into one. Identical types and constants are unified, capabilities,
+/// extensions and extended instruction set imports merged, and the ids of
+/// all the modules renumbered. A global referring to an import resolved by a
+/// later module is moved after the export, and globals referring to each
+/// other in a cycle fail to link.
+class SPIRVLinker {
+public:
+  SPIRVLinker();
+  ~SPIRVLinker();
+
+  /// Add the SPIR-V binary module of \p NumWords words at \p Words. The words
+  /// are not copied and must stay valid until link() returns.
+  /// \returns false if the module cannot be decoded.
+  bool addModule(const SPIRVWord *Words, size_t NumWords);
+
+  /// Link the modules added so far and write the binary of the result.
+  /// \returns false if the modules cannot be linked.
+  bool link(spv_ostream &O);
+
+  SPIRVErrorLog &getErrorLog() { return ErrLog;}
+  SPIRVErrorCode getError(std::string &ErrMsg) {
+    return ErrLog.getError(ErrMsg);
+  }
+
+private:
+  SPIRVErrorLog ErrLog;
+  std::vector<std::unique_ptr<SPIRVLinkerInput>> Inputs;
+};
+
+}
+
+#endif /* SPIRVLINKER_H */
@@ -78,7 +78,8 @@ public:
   // Object query functions
   bool exist(SPIRVId) const override;
   bool exist(SPIRVId, SPIRVEntry **) const override;
-  SPIRVId getId(SPIRVId Id = SPIRVID_INVALID, unsigned Increment = 1);
+  SPIRVId getId(SPIRVId Id = SPIRVID_INVALID, unsigned Increment = 1)
+      override;
   virtual SPIRVEntry *getEntry(SPIRVId Id) const override;
   bool hasDebugInfo() const override { return !StringVec.empty();}
 
@@ -185,6 +186,7 @@ public:
   virtual SPIRVFunction *addFunction(SPIRVTypeFunction *, SPIRVId) override;
   virtual SPIRVEntry *replaceForward(SPIRVForward *, SPIRVEntry *) override;
   virtual void eraseInstruction(SPIRVInstruction *, SPIRVBasicBlock *) override;
+  virtual void releaseFunctionBody(SPIRVFunction *) override;
 
   // Type creation functions
   template<class T> T * addType(T *Ty);
@@ -288,7 +290,9 @@ public:
   virtual SPIRVInstruction *addSelectInst(SPIRVValue *, SPIRVValue *, SPIRVValue *,
       SPIRVBasicBlock *) override;
   virtual SPIRVInstruction *addLoopMergeInst(SPIRVId MergeBlock,
-      SPIRVId ContinueTarget, SPIRVWord LoopControl, SPIRVBasicBlock *BB) override;
+      SPIRVId ContinueTarget, SPIRVWord LoopControl,
+      const std::vector<SPIRVWord> &LoopControlParameters,
+      SPIRVBasicBlock *BB) override;
   virtual SPIRVInstruction *addSelectionMergeInst(SPIRVId MergeBlock,
       SPIRVWord SelectionControl, SPIRVBasicBlock *BB) override;
   virtual SPIRVInstruction *addStoreInst(SPIRVValue *, SPIRVValue *,
@@ -375,6 +379,8 @@ private:
   std::map<unsigned, SPIRVConstant*> LiteralMap;
 
   void layoutEntry(SPIRVEntry* Entry);
+  void releaseEntry(SPIRVEntry* Entry);
+  void releaseDecorates(SPIRVEntry* Entry);
 };
 
 SPIRVModuleImpl::~SPIRVModuleImpl() {
@@ -901,6 +907,69 @@ SPIRVModuleImpl::eraseInstruction(SPIRVInstruction *I, SPIRVBasicBlock *BB) {
   delete I;
 }
 
+void
+SPIRVModuleImpl::releaseEntry(SPIRVEntry *E) {
+  if (E->hasId()) {
+    auto Loc = IdEntryMap.find(E->getId());
+    assert(Loc != IdEntryMap.end() && Loc->second == E);
+    IdEntryMap.erase(Loc);
+    NamedId.erase(E->getId());
+  } else
+    EntryNoId.erase(E);
+  delete E;
+}
+
+// Release the decorates targeting the entry. Decorates owned by a decoration
+// group are kept, since its group decorates apply them to other targets too.
+void
+SPIRVModuleImpl::releaseDecorates(SPIRVEntry *E) {
+  for (auto Dec : E->getDecorates()) {
+    if (Dec->getOwner() || Dec->getTargetId() != E->getId())
+      continue;
+    auto ER = DecorateSet.equal_range(Dec);
+    for (auto I = ER.first; I != ER.second; ++I)
+      if (*I == Dec) {
+        DecorateSet.erase(I);
+        break;
+      }
+    auto D = const_cast<SPIRVDecorate *>(Dec);
+    EntryNoId.erase(D);
+    delete D;
+  }
+}
+
+void
+SPIRVModuleImpl::releaseFunctionBody(SPIRVFunction *F) {
+  std::set<SPIRVId> Released;
+  auto release = [&](SPIRVEntry *E) {
+    if (E->hasId()) {
+      Released.insert(E->getId());
+      releaseDecorates(E);
+    }
+    releaseEntry(E);
+  };
+  for (size_t I = 0, E = F->getNumBasicBlock(); I != E; ++I) {
+    SPIRVBasicBlock *BB = F->getBasicBlock(I);
+    for (size_t J = 0, JE = BB->getNumInst(); J != JE; ++J)
+      release(BB->getInst(J));
+    release(BB);
+  }
+  F->clearBasicBlocks();
+
+  // Group decorates must not keep targeting the released ids either. The
+  // targets of a group member decorate are types, which are not released.
+  for (auto I = GroupDecVec.begin(); I != GroupDecVec.end();) {
+    auto GD = *I;
+    if (GD->getOpCode() != OpGroupDecorate || !GD->eraseTargets(Released)) {
+      ++I;
+      continue;
+    }
+    I = GroupDecVec.erase(I);
+    EntryNoId.erase(GD);
+    delete GD;
+  }
+}
+
 SPIRVValue *
 SPIRVModuleImpl::addConstant(SPIRVValue *C) {
   return add(C);
@@ -1150,9 +1219,10 @@ SPIRVModuleImpl::addSelectionMergeInst(SPIRVId MergeBlock,
 
 SPIRVInstruction *
 SPIRVModuleImpl::addLoopMergeInst(SPIRVId MergeBlock, SPIRVId ContinueTarget,
-    SPIRVWord LoopControl, SPIRVBasicBlock *BB) {
+    SPIRVWord LoopControl, const std::vector<SPIRVWord> &LoopControlParameters,
+    SPIRVBasicBlock *BB) {
   return addInstruction(new SPIRVLoopMerge(MergeBlock, ContinueTarget,
-      LoopControl, BB), BB);
+      LoopControl, BB, LoopControlParameters), BB);
 }
 
 SPIRVInstruction *
@@ -137,6 +137,9 @@ public:
   virtual SPIRVWord getSPIRVVersion() const = 0;
 
   // Module changing functions
+  // Reserve Increment consecutive ids, starting at Id if it is valid.
+  virtual SPIRVId getId(SPIRVId Id = SPIRVID_INVALID,
+      unsigned Increment = 1) = 0;
   virtual bool importBuiltinSet(const std::string &, SPIRVId *) = 0;
   virtual bool importBuiltinSetWithId(const std::string &, SPIRVId) = 0;
   virtual void setAddressingModel(SPIRVAddressingModelKind) = 0;
@@ -189,6 +192,10 @@ public:
       SPIRVId Id = SPIRVID_INVALID) = 0;
   virtual SPIRVEntry *replaceForward(SPIRVForward *, SPIRVEntry *) = 0;
   virtual void eraseInstruction(SPIRVInstruction *, SPIRVBasicBlock *) = 0;
+  /// Delete the basic blocks and instructions of a function, keeping the
+  /// function and its parameters. The function body can no longer be
+  /// accessed or encoded afterwards.
+  virtual void releaseFunctionBody(SPIRVFunction *) = 0;
 
   // Type creation functions
   virtual SPIRVTypeArray *addArrayType(SPIRVType *, SPIRVConstant *) = 0;
@@ -299,7 +306,9 @@ public:
   virtual SPIRVInstruction *addSelectionMergeInst(SPIRVId MergeBlock,
       SPIRVWord SelectionControl, SPIRVBasicBlock *BB) = 0;
   virtual SPIRVInstruction *addLoopMergeInst(SPIRVId MergeBlock,
-      SPIRVId ContinueTarget, SPIRVWord LoopControl, SPIRVBasicBlock *BB) = 0;
+      SPIRVId ContinueTarget, SPIRVWord LoopControl,
+      const std::vector<SPIRVWord> &LoopControlParameters,
+      SPIRVBasicBlock *BB) = 0;
   virtual SPIRVInstruction *addStoreInst(SPIRVValue *, SPIRVValue *,
       const std::vector<SPIRVWord>&, SPIRVBasicBlock *) = 0;
   virtual SPIRVInstruction *addSwitchInst(SPIRVValue *, SPIRVBasicBlock *,
@@ -64,6 +64,17 @@ extern bool SPIRVUseTextFormat;
 class SPIRVFunction;
 class SPIRVBasicBlock;
 
+/// Read-only stream buffer over a block of memory owned by the caller. It
+/// allows the istream based decoder to consume a SPIR-V binary in place
+/// without copying it into a string stream first.
+class SPIRVMemoryStreamBuf : public std::streambuf {
+public:
+  SPIRVMemoryStreamBuf(const char *Begin, size_t Size) {
+    char *B = const_cast<char *>(Begin);
+    setg(B, B, B + Size);
+  }
+};
+
 class SPIRVDecoder {
 public:
   SPIRVDecoder(std::istream& InputStream, SPIRVModule& Module)
@@ -58,7 +58,8 @@ while.cond:                                       ; preds = %if.end, %entry
 ; CHECK-SPIRV-NEXT: INotEqual
 ; CHECK-LLVM: %tobool = icmp ne i32 %b.0, 0, !dbg ![[Line_5]]
   %tobool = icmp ne i32 %b.0, 0, !dbg !31
-; CHECK-SPIRV-NEXT: BranchConditional {{[0-9]+}} [[while_body:[0-9]+]] [[while_end:[0-9]+]]
+; CHECK-SPIRV-NEXT: LoopMerge [[while_end:[0-9]+]] {{[0-9]+}} 0
+; CHECK-SPIRV-NEXT: BranchConditional {{[0-9]+}} [[while_body:[0-9]+]] [[while_end]]
 ; CHECK-LLVM: br i1 %tobool, label %while.body, label %while.end, !dbg ![[Line_5]]
   br i1 %tobool, label %while.body, label %while.end, !dbg !31
 
@@ -68,6 +69,7 @@ while.body:                                       ; preds = %while.cond
 ; CHECK-SPIRV-NEXT: SGreaterThan
 ; CHECK-LLVM: %cmp = icmp sgt i32 %a.addr.0, 4, !dbg ![[Line_6:[0-9]+]]
   %cmp = icmp sgt i32 %a.addr.0, 4, !dbg !34
+; CHECK-SPIRV-NEXT: SelectionMerge [[if_end:[0-9]+]] 0
 ; CHECK-SPIRV-NEXT: BranchConditional {{[0-9]+}} [[if_then:[0-9]+]] [[if_else:[0-9]+]]
 ; CHECK-LLVM: br i1 %cmp, label %if.then, label %if.else, !dbg ![[Line_6]]
   br i1 %cmp, label %if.then, label %if.else, !dbg !37
@@ -79,7 +81,7 @@ if.then:                                          ; preds = %while.body
 ; CHECK-LLVM: %sub = sub i32 %a.addr.0, 1, !dbg ![[Line_7:[0-9]+]]
   %sub = sub nsw i32 %a.addr.0, 1, !dbg !38
   call void @llvm.dbg.value(metadata i32 %sub, i64 0, metadata !28, metadata !25), !dbg !29
-; CHECK-SPIRV-NEXT: Branch [[if_end:[0-9]+]]
+; CHECK-SPIRV-NEXT: Branch [[if_end]]
 ; CHECK-LLVM: br label %if.end, !dbg ![[Line_7]]
   br label %if.end, !dbg !38
 
@@ -0,0 +1,58 @@
+; Check that the aliasing and alignment facts of pointer arguments and
+; memory accesses are translated to decorations and memory operands.
+; RUN: llvm-as < %s > %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o - | FileCheck %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o - | llvm-dis | FileCheck %s --check-prefix=CHECK-LLVM
+
+; CHECK-SPIRV-DAG: Name [[A:[0-9]+]] "a"
+; CHECK-SPIRV-DAG: Name [[B:[0-9]+]] "b"
+; CHECK-SPIRV-DAG: Name [[SRC:[0-9]+]] "src"
+; CHECK-SPIRV-DAG: Decorate [[A]] FuncParamAttr 4
+; CHECK-SPIRV-DAG: Decorate [[A]] FuncParamAttr 5
+; CHECK-SPIRV-DAG: Decorate [[A]] FuncParamAttr 6
+; CHECK-SPIRV-DAG: Decorate [[A]] Alignment 16
+; CHECK-SPIRV-DAG: Decorate [[A]] MaxByteOffset 64
+; CHECK-SPIRV-DAG: Decorate [[SRC]] Restrict
+; CHECK-SPIRV: Load {{[0-9]+}} {{[0-9]+}} [[A]] 2 16
+; CHECK-SPIRV: Store [[B]] {{[0-9]+}} 6 4
+; CHECK-SPIRV: Load {{[0-9]+}} {{[0-9]+}} [[SRC]] 2 4
+
+; CHECK-LLVM: define spir_func void @scoped(i32 addrspace(1)* %dst, i32 addrspace(1)* noalias %src)
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_func void @attrs(i32 addrspace(1)* noalias nocapture readonly align 16 dereferenceable(64) %a, i32 addrspace(1)* %b) #0 {
+entry:
+  %0 = load i32, i32 addrspace(1)* %a, align 16
+  store i32 %0, i32 addrspace(1)* %b, align 4, !nontemporal !3
+  ret void
+}
+
+; The accesses through %src are in a scope which the other accesses of the
+; function do not alias, as after inlining a function with a noalias
+; argument.
+; Function Attrs: nounwind
+define spir_func void @scoped(i32 addrspace(1)* %dst, i32 addrspace(1)* %src) #0 {
+entry:
+  %0 = load i32, i32 addrspace(1)* %src, align 4, !alias.scope !2
+  store i32 %0, i32 addrspace(1)* %dst, align 4, !noalias !2
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.spir.version = !{!4}
+!opencl.ocl.version = !{!4}
+!opencl.used.extensions = !{!5}
+!opencl.used.optional.core.features = !{!5}
+!opencl.compiler.options = !{!5}
+
+!0 = distinct !{!0, !"scoped"}
+!1 = distinct !{!1, !0, !"scoped: %src"}
+!2 = !{!1}
+!3 = !{i32 1}
+!4 = !{i32 1, i32 2}
+!5 = !{}
@@ -0,0 +1,144 @@
+; Check that the names clang emits for OpenCL builtins demangle to the
+; expected signatures, and which of them NameMangler mangles differently, as
+; described in lib/Mangler/NameMangleAPI.h.
+; RUN: sed -n 's/^; NAME: //p' %s | llvm-spirv -demangle-builtins | FileCheck %s
+
+; NAME: _Z13get_global_idj
+; NAME: _Z5clampDv4_fS_S_
+; NAME: _Z3mixDv4_fS_f
+; NAME: _Z3dotDv4_fS_
+; NAME: _Z5crossDv3_fS_
+; NAME: _Z6selectDv4_iS_S_
+; NAME: _Z9bitselectDv2_fS_S_
+; NAME: _Z3anyDv4_i
+; NAME: _Z7shuffleDv4_fDv4_j
+; NAME: _Z8shuffle2Dv8_iS_Dv8_j
+; NAME: _Z4sqrtDh
+; NAME: _Z5fractDv4_fPU3AS1S_
+; NAME: _Z6sincosfPf
+; NAME: _Z5frexpDv2_dPDv2_i
+; NAME: _Z4modfDv8_fPU3AS3S_
+; NAME: _Z6remquoffPi
+; NAME: _Z20convert_int4_sat_rteDv4_f
+; NAME: _Z16convert_char_satf
+; NAME: _Z6vload4jPKU3AS1f
+; NAME: _Z6vload4jPU3AS1Kf
+; NAME: _Z7vstore4Dv4_fjPU3AS1f
+; NAME: _Z10vload_halfjPKU3AS1Dh
+; NAME: _Z15vstore_half_rtefjPU3AS1Dh
+; NAME: _Z12vloada_half4jPKU3AS1Dh
+; NAME: _Z17vstorea_half4_rtpDv4_fmPU3AS1Dh
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_i
+; NAME: _Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f
+; NAME: _Z11read_imagef19ocl_image2d_msaa_roDv2_ii
+; NAME: _Z11read_imagef20ocl_image2d_depth_ro11ocl_samplerDv2_f
+; NAME: _Z11read_imagei20ocl_image2d_array_roDv4_i
+; NAME: _Z12read_imageui14ocl_image1d_roi
+; NAME: _Z11read_imagef21ocl_image1d_buffer_roi
+; NAME: _Z11read_imagef11ocl_image3d11ocl_samplerDv4_f
+; NAME: _Z12write_imagef14ocl_image2d_woDv2_iDv4_f
+; NAME: _Z12write_imagei14ocl_image3d_woDv4_iS_
+; NAME: _Z15get_image_width14ocl_image3d_ro
+; NAME: _Z13get_image_dim20ocl_image2d_array_ro
+; NAME: _Z19is_valid_reserve_id13ocl_reserveid
+; NAME: _Z8atom_addPU3AS1Vii
+; NAME: _Z10atomic_incPU3AS1Vi
+; NAME: _Z14atomic_cmpxchgPU3AS3Vjjj
+; NAME: _Z11atomic_loadPVU3AS4U7_Atomici
+; NAME: _Z12atomic_storePVU3AS4U7_Atomicii
+; NAME: _Z15atomic_exchangePVU3AS4U7_Atomicff
+; NAME: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order
+; NAME: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope
+; NAME: _Z25atomic_fetch_add_explicitPU3AS4VU7_Atomicii12memory_order12memory_scope
+; NAME: _Z30atomic_compare_exchange_strongPVU3AS4U7_AtomiciPU3AS4ii
+; NAME: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_
+; NAME: _Z24atomic_flag_test_and_setPVU3AS4U7_Atomici
+; NAME: _Z22atomic_work_item_fencej12memory_order12memory_scope
+; NAME: _Z10ndrange_1Dm
+; NAME: _Z10ndrange_2DPKmS0_
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvvE
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvPU3AS3vzEjz
+; NAME: _Z26get_kernel_work_group_sizeU13block_pointerFvvE
+; NAME: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvvE
+; NAME: _Z14enqueue_marker9ocl_queuejPK12ocl_clkeventP12ocl_clkevent
+; NAME: _Z12retain_event12ocl_clkevent
+; NAME: _Z21async_work_group_copyPU3AS3fPKU3AS1fj9ocl_event
+; NAME: _Z17wait_group_eventsiP9ocl_event
+; NAME: _Z19sub_group_broadcastij
+; NAME: _Z20sub_group_reduce_addi
+; NAME: _Z3fooPVU3AS1U7_AtomiciDv4_fS2_
+; NAME: _Z3fooPU3AS1Dv4_fS_S0_
+; NAME: _Z3barU13block_pointerFvPU3AS3vES0_S2_
+; NAME: _Z3barU13block_pointerFvPU3AS3vES1_
+; NAME: _Z5clamp
+
+; CHECK: _Z13get_global_idj -> get_global_id(uint){{$}}
+; CHECK-NEXT: _Z5clampDv4_fS_S_ -> clamp(float4, float4, float4){{$}}
+; CHECK-NEXT: _Z3mixDv4_fS_f -> mix(float4, float4, float){{$}}
+; CHECK-NEXT: _Z3dotDv4_fS_ -> dot(float4, float4){{$}}
+; CHECK-NEXT: _Z5crossDv3_fS_ -> cross(float3, float3){{$}}
+; CHECK-NEXT: _Z6selectDv4_iS_S_ -> select(int4, int4, int4){{$}}
+; CHECK-NEXT: _Z9bitselectDv2_fS_S_ -> bitselect(float2, float2, float2){{$}}
+; CHECK-NEXT: _Z3anyDv4_i -> any(int4){{$}}
+; CHECK-NEXT: _Z7shuffleDv4_fDv4_j -> shuffle(float4, uint4){{$}}
+; CHECK-NEXT: _Z8shuffle2Dv8_iS_Dv8_j -> shuffle2(int8, int8, uint8){{$}}
+; CHECK-NEXT: _Z4sqrtDh -> sqrt(half){{$}}
+; CHECK-NEXT: _Z5fractDv4_fPU3AS1S_ -> fract(float4, __global float4 *){{$}}
+; CHECK-NEXT: _Z6sincosfPf -> sincos(float, __private float *){{$}}
+; CHECK-NEXT: _Z5frexpDv2_dPDv2_i -> frexp(double2, __private int2 *){{$}}
+; CHECK-NEXT: _Z4modfDv8_fPU3AS3S_ -> modf(float8, __local float8 *){{$}}
+; CHECK-NEXT: _Z6remquoffPi -> remquo(float, float, __private int *){{$}}
+; CHECK-NEXT: _Z20convert_int4_sat_rteDv4_f -> convert_int4_sat_rte(float4){{$}}
+; CHECK-NEXT: _Z16convert_char_satf -> convert_char_sat(float){{$}}
+; CHECK-NEXT: _Z6vload4jPKU3AS1f -> vload4(uint, const __global float *){{$}}
+; CHECK-NEXT: _Z6vload4jPU3AS1Kf -> vload4(uint, const __global float *) -> _Z6vload4jPKU3AS1f
+; CHECK-NEXT: _Z7vstore4Dv4_fjPU3AS1f -> vstore4(float4, uint, __global float *){{$}}
+; CHECK-NEXT: _Z10vload_halfjPKU3AS1Dh -> vload_half(uint, const __global half *){{$}}
+; CHECK-NEXT: _Z15vstore_half_rtefjPU3AS1Dh -> vstore_half_rte(float, uint, __global half *){{$}}
+; CHECK-NEXT: _Z12vloada_half4jPKU3AS1Dh -> vloada_half4(uint, const __global half *){{$}}
+; CHECK-NEXT: _Z17vstorea_half4_rtpDv4_fmPU3AS1Dh -> vstorea_half4_rtp(float4, ulong, __global half *){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_i -> read_imagef(image2d_t, sampler_t, int2){{$}}
+; CHECK-NEXT: _Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f -> read_imagef(image2d_t, sampler_t, float2) -> _Z11read_imagef11ocl_image2d11ocl_samplerDv2_f
+; CHECK-NEXT: _Z11read_imagef19ocl_image2d_msaa_roDv2_ii -> read_imagef(image2d_msaa_t, int2, int) -> _Z11read_imagef15ocl_image2dmsaaDv2_ii
+; CHECK-NEXT: _Z11read_imagef20ocl_image2d_depth_ro11ocl_samplerDv2_f -> read_imagef(image2d_depth_t, sampler_t, float2) -> _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv2_f
+; CHECK-NEXT: _Z11read_imagei20ocl_image2d_array_roDv4_i -> read_imagei(image2d_array_t, int4) -> _Z11read_imagei16ocl_image2darrayDv4_i
+; CHECK-NEXT: _Z12read_imageui14ocl_image1d_roi -> read_imageui(image1d_t, int) -> _Z12read_imageui11ocl_image1di
+; CHECK-NEXT: _Z11read_imagef21ocl_image1d_buffer_roi -> read_imagef(image1d_buffer_t, int) -> _Z11read_imagef17ocl_image1dbufferi
+; CHECK-NEXT: _Z11read_imagef11ocl_image3d11ocl_samplerDv4_f -> read_imagef(image3d_t, sampler_t, float4){{$}}
+; CHECK-NEXT: _Z12write_imagef14ocl_image2d_woDv2_iDv4_f -> write_imagef(image2d_t, int2, float4) -> _Z12write_imagef11ocl_image2dDv2_iDv4_f
+; CHECK-NEXT: _Z12write_imagei14ocl_image3d_woDv4_iS_ -> write_imagei(image3d_t, int4, int4) -> _Z12write_imagei11ocl_image3dDv4_iS_
+; CHECK-NEXT: _Z15get_image_width14ocl_image3d_ro -> get_image_width(image3d_t) -> _Z15get_image_width11ocl_image3d
+; CHECK-NEXT: _Z13get_image_dim20ocl_image2d_array_ro -> get_image_dim(image2d_array_t) -> _Z13get_image_dim16ocl_image2darray
+; CHECK-NEXT: _Z19is_valid_reserve_id13ocl_reserveid -> is_valid_reserve_id(reserve_id_t){{$}}
+; CHECK-NEXT: _Z8atom_addPU3AS1Vii -> atom_add(volatile __global int *, int) -> _Z8atom_addPVU3AS1ii
+; CHECK-NEXT: _Z10atomic_incPU3AS1Vi -> atomic_inc(volatile __global int *) -> _Z10atomic_incPVU3AS1i
+; CHECK-NEXT: _Z14atomic_cmpxchgPU3AS3Vjjj -> atomic_cmpxchg(volatile __local uint *, uint, uint) -> _Z14atomic_cmpxchgPVU3AS3jjj
+; CHECK-NEXT: _Z11atomic_loadPVU3AS4U7_Atomici -> atomic_load(volatile __generic atomic_int *){{$}}
+; CHECK-NEXT: _Z12atomic_storePVU3AS4U7_Atomicii -> atomic_store(volatile __generic atomic_int *, int){{$}}
+; CHECK-NEXT: _Z15atomic_exchangePVU3AS4U7_Atomicff -> atomic_exchange(volatile __generic atomic_float *, float){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPU3AS4VU7_Atomicii12memory_order12memory_scope -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order, memory_scope) -> _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope
+; CHECK-NEXT: _Z30atomic_compare_exchange_strongPVU3AS4U7_AtomiciPU3AS4ii -> atomic_compare_exchange_strong(volatile __generic atomic_int *, __generic int *, int){{$}}
+; CHECK-NEXT: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_ -> atomic_compare_exchange_strong_explicit(volatile __generic atomic_int *, __generic int *, int, memory_order, memory_order) -> _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_order12memory_order
+; CHECK-NEXT: _Z24atomic_flag_test_and_setPVU3AS4U7_Atomici -> atomic_flag_test_and_set(volatile __generic atomic_int *){{$}}
+; CHECK-NEXT: _Z22atomic_work_item_fencej12memory_order12memory_scope -> atomic_work_item_fence(uint, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z10ndrange_1Dm -> ndrange_1D(ulong){{$}}
+; CHECK-NEXT: _Z10ndrange_2DPKmS0_ -> ndrange_2D(const __private ulong *, const __private ulong *){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvvE -> enqueue_kernel(queue_t, int, ndrange_t, void ()*){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvPU3AS3vzEjz -> enqueue_kernel(queue_t, int, ndrange_t, uint, const __private clk_event_t *, __private clk_event_t *, void (__local void *, ...)*, uint, ...){{$}}
+; CHECK-NEXT: _Z26get_kernel_work_group_sizeU13block_pointerFvvE -> get_kernel_work_group_size(void ()*){{$}}
+; CHECK-NEXT: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvvE -> get_kernel_preferred_work_group_size_multiple(void ()*){{$}}
+; CHECK-NEXT: _Z14enqueue_marker9ocl_queuejPK12ocl_clkeventP12ocl_clkevent -> enqueue_marker(queue_t, uint, const __private clk_event_t *, __private clk_event_t *){{$}}
+; CHECK-NEXT: _Z12retain_event12ocl_clkevent -> retain_event(clk_event_t){{$}}
+; CHECK-NEXT: _Z21async_work_group_copyPU3AS3fPKU3AS1fj9ocl_event -> async_work_group_copy(__local float *, const __global float *, uint, event_t){{$}}
+; CHECK-NEXT: _Z17wait_group_eventsiP9ocl_event -> wait_group_events(int, __private event_t *){{$}}
+; CHECK-NEXT: _Z19sub_group_broadcastij -> sub_group_broadcast(int, uint){{$}}
+; CHECK-NEXT: _Z20sub_group_reduce_addi -> sub_group_reduce_add(int){{$}}
+; CHECK-NEXT: _Z3fooPVU3AS1U7_AtomiciDv4_fS2_ -> foo(volatile __global atomic_int *, float4, float4) -> _Z3fooPVU3AS1U7_AtomiciDv4_fS1_
+; CHECK-NEXT: _Z3fooPU3AS1Dv4_fS_S0_ -> <invalid>
+; A block takes two substitutions, its function type and then itself.
+; CHECK-NEXT: _Z3barU13block_pointerFvPU3AS3vES0_S2_ -> bar(void (__local void *)*, __local void *, void (__local void *)*) -> _Z3barU13block_pointerFvPU3AS3vES0_U13block_pointerFvS0_E
+; The function type of a block is not a parameter type.
+; CHECK-NEXT: _Z3barU13block_pointerFvPU3AS3vES1_ -> <invalid>
+; CHECK-NEXT: _Z5clamp -> <invalid>
@@ -0,0 +1,78 @@
+; Check that the functions of a module found unchanged in the translation
+; cache are reused when another function of the module changes, and that the
+; result translates back to the same module as a translation without the
+; cache. The SPIR-V binaries themselves differ in their ids. That the function
+; is actually reused is checked by function_cache_stats.ll.
+; RUN: rm -rf %t.cache
+; RUN: llvm-as %s -o %t.bc
+; RUN: sed -e 's/add i32 %s, 42/add i32 %s, 43/' %s | llvm-as -o %t.changed.bc
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-function-cache -o %t.spv
+; RUN: llvm-spirv %t.changed.bc -spirv-cache-dir=%t.cache -spirv-function-cache -o %t.changed.spv
+; RUN: llvm-spirv -r %t.changed.spv -o - | llvm-dis -o %t.changed.ll
+; RUN: FileCheck < %t.changed.ll %s
+; RUN: llvm-spirv %t.changed.bc -o %t.changed.cold.spv
+; RUN: llvm-spirv -r %t.changed.cold.spv -o - | llvm-dis -o %t.changed.cold.ll
+; RUN: diff %t.changed.cold.ll %t.changed.ll
+
+; CHECK: define spir_func i32 @sum(i32 addrspace(1)* %p, i32 %n)
+; CHECK: %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+; CHECK: %s = phi i32 [ 0, %entry ], [ %s.next, %loop ]
+; CHECK: load i32, i32 addrspace(1)*
+; CHECK: %s.next = add i32 %s, %v
+; CHECK: %cmp = icmp slt i32 %i.next, %n
+; CHECK: br i1 %cmp, label %loop, label %exit
+; CHECK: ret i32 %s.next
+
+; CHECK: define spir_kernel void @foo(i32 addrspace(1)* %a)
+; CHECK: %s = call spir_func i32 @sum(i32 addrspace(1)* %a, i32 16)
+; CHECK: %r = add i32 %s, 43
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_func i32 @sum(i32 addrspace(1)* %p, i32 %n) #0 {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %s = phi i32 [ 0, %entry ], [ %s.next, %loop ]
+  %gep = getelementptr inbounds i32, i32 addrspace(1)* %p, i32 %i
+  %v = load i32, i32 addrspace(1)* %gep, align 4
+  %s.next = add i32 %s, %v
+  %i.next = add i32 %i, 1
+  %cmp = icmp slt i32 %i.next, %n
+  br i1 %cmp, label %loop, label %exit
+
+exit:
+  ret i32 %s.next
+}
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %s = call spir_func i32 @sum(i32 addrspace(1)* %a, i32 16) #0
+  %r = add i32 %s, 42
+  store i32 %r, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
@@ -0,0 +1,11 @@
+; Check that the function cache reuses the unchanged function of the module of
+; function_cache.ll, and only that function.
+; REQUIRES: asserts
+; RUN: rm -rf %t.cache
+; RUN: llvm-as %S/function_cache.ll -o %t.bc
+; RUN: sed -e 's/add i32 %s, 42/add i32 %s, 43/' %S/function_cache.ll | llvm-as -o %t.changed.bc
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-function-cache -stats -o %t.spv 2>&1 | FileCheck %s --check-prefix=COLD
+; RUN: llvm-spirv %t.changed.bc -spirv-cache-dir=%t.cache -spirv-function-cache -stats -o %t.changed.spv 2>&1 | FileCheck %s --check-prefix=WARM
+
+; COLD-NOT: Number of functions reused from the translation cache
+; WARM: 1 spirv - Number of functions reused from the translation cache
@@ -0,0 +1,49 @@
+; Check that the in-memory ReadSPIRV/WriteSPIRV overloads round trip and
+; produce the same results as the stream based ones.
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.ref.spv
+; RUN: llvm-spirv -in-memory %t.bc -o %t.spv
+; RUN: cmp %t.ref.spv %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.ref.bc
+; RUN: llvm-spirv -r -in-memory %t.spv -o %t.rev.bc
+; RUN: cmp %t.ref.bc %t.rev.bc
+; RUN: llvm-dis %t.rev.bc -o - | FileCheck %s
+; RUN: llvm-spirv -in-memory -time-passes %t.bc -o %t.timed.spv 2>&1 | FileCheck %s --check-prefix=CHECK-TIME
+; RUN: llvm-spirv -r -in-memory -time-passes %t.spv -o %t.timed.bc 2>&1 | FileCheck %s --check-prefix=CHECK-TIME
+
+; CHECK: define spir_kernel void @foo(i32 addrspace(1)* %a)
+; CHECK: add i32 {{.*}}, 1
+; CHECK: store i32 {{.*}}, i32 addrspace(1)* %a
+
+; CHECK-TIME: LLVM/SPIR-V translator
+; CHECK-TIME: {{SPIR-V to LLVM|LLVM to SPIR-V}} translation
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %0 = load i32, i32 addrspace(1)* %a, align 4
+  %add = add i32 %0, 1
+  store i32 %add, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
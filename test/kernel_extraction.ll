@@ -0,0 +1,64 @@
+; Check that only the requested kernel and the functions and global variables
+; it uses are translated from SPIR-V.
+; RUN: llvm-as < %s > %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r -kernel=foo %t.spv -o - | llvm-dis | FileCheck %s
+
+; CHECK: @c_foo = {{.*}}addrspace(2) constant i32 5
+; CHECK-NOT: @c_bar
+; CHECK: define spir_kernel void @foo
+; CHECK: call spir_func i32 @helper
+; CHECK: define spir_func i32 @helper
+; CHECK-NOT: @bar
+; CHECK: !opencl.kernels
+; CHECK-NOT: @bar
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+@c_foo = addrspace(2) constant i32 5, align 4
+@c_bar = addrspace(2) constant i32 7, align 4
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %0 = load i32, i32 addrspace(2)* @c_foo, align 4
+  %call = call spir_func i32 @helper(i32 %0) #0
+  store i32 %call, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+; Function Attrs: nounwind
+define spir_func i32 @helper(i32 %x) #0 {
+entry:
+  %add = add nsw i32 %x, 1
+  ret i32 %add
+}
+
+; Function Attrs: nounwind
+define spir_kernel void @bar(i32 addrspace(1)* %a) #0 {
+entry:
+  %0 = load i32, i32 addrspace(2)* @c_bar, align 4
+  store i32 %0, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0, !6}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!7}
+!opencl.ocl.version = !{!7}
+!opencl.used.extensions = !{!8}
+!opencl.used.optional.core.features = !{!8}
+!opencl.compiler.options = !{!8}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{void (i32 addrspace(1)*)* @bar, !1, !2, !3, !4, !5}
+!7 = !{i32 1, i32 2}
+!8 = !{}
@@ -0,0 +1,64 @@
+; Check that a global variable initialized with an import resolved by a later
+; module follows the variable exported by that module in the linked module.
+; RUN: llvm-as %s -o %t.bc
+; RUN: sed -n -e 's/^;LIB: //p' %s | llvm-as -o %t.lib.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv %t.lib.bc -o %t.lib.spv
+; RUN: llvm-spirv %t.spv -link %t.lib.spv -o %t.linked.spv
+; RUN: llvm-spirv -r %t.linked.spv -o - | llvm-dis | FileCheck %s
+
+; CHECK-DAG: @g = addrspace(1) global i32 42
+; CHECK-DAG: @p = addrspace(1) global i32 addrspace(1)* @g
+; CHECK: define spir_kernel void @foo(i32 addrspace(1)* %a)
+; CHECK: load i32 addrspace(1)*, i32 addrspace(1)* addrspace(1)* @p
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+@g = external addrspace(1) global i32
+@p = addrspace(1) global i32 addrspace(1)* @g, align 8
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %q = load i32 addrspace(1)*, i32 addrspace(1)* addrspace(1)* @p, align 8
+  %v = load i32, i32 addrspace(1)* %q, align 4
+  store i32 %v, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
+
+;LIB: target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+;LIB: target triple = "spir64-unknown-unknown"
+;LIB:
+;LIB: @g = addrspace(1) global i32 42, align 4
+;LIB:
+;LIB: attributes #0 = { nounwind }
+;LIB:
+;LIB: !opencl.enable.FP_CONTRACT = !{}
+;LIB: !opencl.spir.version = !{!0}
+;LIB: !opencl.ocl.version = !{!0}
+;LIB: !opencl.used.extensions = !{!1}
+;LIB: !opencl.used.optional.core.features = !{!1}
+;LIB: !opencl.compiler.options = !{!1}
+;LIB:
+;LIB: !0 = !{i32 1, i32 2}
+;LIB: !1 = !{}
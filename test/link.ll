@@ -0,0 +1,75 @@
+; Check that the SPIR-V modules are linked without translating them to LLVM:
+; the import of @add_one is resolved to the function exported by the library
+; and the types of both modules are unified.
+; RUN: llvm-as %s -o %t.bc
+; RUN: sed -n -e 's/^;LIB: //p' %s | llvm-as -o %t.lib.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv %t.lib.bc -o %t.lib.spv
+; RUN: llvm-spirv %t.spv -link %t.lib.spv -o %t.linked.spv
+; RUN: llvm-spirv %t.linked.spv -to-text -o - | FileCheck %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv -r %t.linked.spv -o - | llvm-dis | FileCheck %s
+
+; CHECK-SPIRV-NOT: LinkageAttributes "add_one" Import
+; CHECK-SPIRV: LinkageAttributes "add_one" Export
+; CHECK-SPIRV-NOT: LinkageAttributes "add_one" Import
+; CHECK-SPIRV: TypeInt {{[0-9]+}} 32 0
+; CHECK-SPIRV-NOT: TypeInt {{[0-9]+}} 32 0
+
+; CHECK: define spir_func i32 @add_one(i32 %x)
+; CHECK: add i32 %x, 1
+; CHECK: define spir_kernel void @foo(i32 addrspace(1)* %a)
+; CHECK: call spir_func i32 @add_one(i32 %v)
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %v = load i32, i32 addrspace(1)* %a, align 4
+  %r = call spir_func i32 @add_one(i32 %v) #0
+  store i32 %r, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+declare spir_func i32 @add_one(i32) #0
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
+
+;LIB: target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+;LIB: target triple = "spir64-unknown-unknown"
+;LIB:
+;LIB: define spir_func i32 @add_one(i32 %x) #0 {
+;LIB: entry:
+;LIB:   %r = add i32 %x, 1
+;LIB:   ret i32 %r
+;LIB: }
+;LIB:
+;LIB: attributes #0 = { nounwind }
+;LIB:
+;LIB: !opencl.enable.FP_CONTRACT = !{}
+;LIB: !opencl.spir.version = !{!0}
+;LIB: !opencl.ocl.version = !{!0}
+;LIB: !opencl.used.extensions = !{!1}
+;LIB: !opencl.used.optional.core.features = !{!1}
+;LIB: !opencl.compiler.options = !{!1}
+;LIB:
+;LIB: !0 = !{i32 1, i32 2}
+;LIB: !1 = !{}
@@ -1,9 +1,11 @@
 ; Translator should not translate llvm intrinsic calls straight forward.
 ; It either represnts intrinsic's semantics with SPIRV instruction(s), or
 ; reports an error.
-; XFAIL: *
 ; RUN: llvm-as %s -o %t.bc
-; RUN: llvm-spirv %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o - | FileCheck %s
+
+; CHECK-NOT: llvm.fma
+; CHECK: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} fma
 
 target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024-n8:16:32:64"
 target triple = "spir64"
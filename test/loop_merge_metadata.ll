@@ -0,0 +1,98 @@
+; Check that loop metadata is translated to OpLoopMerge loop controls and
+; back to llvm.loop metadata.
+; RUN: llvm-as < %s > %t.bc
+; RUN: llvm-spirv %t.bc -spirv-max-version=1.1 -spirv-text -o - | FileCheck %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -spirv-max-version=1.1 -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o - | llvm-dis | FileCheck %s --check-prefix=CHECK-LLVM
+
+; DependencyInfinite needs SPIR-V 1.1, so the module gets that version.
+; CHECK-SPIRV: 119734787 65792
+
+; CHECK-SPIRV: Branch [[Header:[0-9]+]]
+; CHECK-SPIRV: Label [[Header]]
+; CHECK-SPIRV: 4 LoopMerge [[Exit:[0-9]+]] [[Latch:[0-9]+]] 6
+; CHECK-SPIRV-NEXT: BranchConditional {{[0-9]+}} [[Latch]] [[Exit]]
+; CHECK-SPIRV: Label [[Latch]]
+; CHECK-SPIRV: Branch [[Header]]
+
+; The vectorization width is only a hint and implies no dependency length.
+; CHECK-SPIRV: 4 LoopMerge {{[0-9]+}} {{[0-9]+}} 0
+; CHECK-SPIRV-NEXT: BranchConditional
+; CHECK-SPIRV-NOT: LoopMerge
+
+; CHECK-LLVM-LABEL: @parallel
+; CHECK-LLVM: load i32, {{.*}}, !llvm.mem.parallel_loop_access ![[ACCESS:[0-9]+]]
+; CHECK-LLVM: store i32 {{.*}}, !llvm.mem.parallel_loop_access ![[ACCESS]]
+; CHECK-LLVM: br label %{{[0-9a-z.]+}}, !llvm.loop ![[LOOP_PAR:[0-9]+]]
+; A loop merge without loop controls still gets a loop ID, with nothing in it.
+; CHECK-LLVM-LABEL: @vectorize_width
+; CHECK-LLVM: br label %{{[0-9a-z.]+}}, !llvm.loop ![[LOOP_VW:[0-9]+]]
+; CHECK-LLVM-DAG: ![[LOOP_PAR]] = distinct !{![[LOOP_PAR]], ![[UNROLL:[0-9]+]], ![[VECTORIZE:[0-9]+]]}
+; CHECK-LLVM-DAG: ![[UNROLL]] = !{!"llvm.loop.unroll.disable"}
+; CHECK-LLVM-DAG: ![[VECTORIZE]] = !{!"llvm.loop.vectorize.enable", i1 true}
+; CHECK-LLVM-DAG: ![[LOOP_VW]] = distinct !{![[LOOP_VW]]}
+; CHECK-LLVM-NOT: llvm.loop.vectorize.width
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_func void @parallel(i32 addrspace(1)* %a, i32 %n) #0 {
+entry:
+  br label %for.cond
+
+for.cond:
+  %i = phi i32 [ 0, %entry ], [ %inc, %for.body ]
+  %cmp = icmp slt i32 %i, %n
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %idx = sext i32 %i to i64
+  %p = getelementptr inbounds i32, i32 addrspace(1)* %a, i64 %idx
+  %v = load i32, i32 addrspace(1)* %p, align 4, !llvm.mem.parallel_loop_access !0
+  %add = add nsw i32 %v, 1
+  store i32 %add, i32 addrspace(1)* %p, align 4, !llvm.mem.parallel_loop_access !0
+  %inc = add nsw i32 %i, 1
+  br label %for.cond, !llvm.loop !0
+
+for.end:
+  ret void
+}
+
+; Function Attrs: nounwind
+define spir_func void @vectorize_width(i32 addrspace(1)* %a, i32 %n) #0 {
+entry:
+  br label %for.cond
+
+for.cond:
+  %i = phi i32 [ 0, %entry ], [ %inc, %for.body ]
+  %cmp = icmp slt i32 %i, %n
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %idx = sext i32 %i to i64
+  %p = getelementptr inbounds i32, i32 addrspace(1)* %a, i64 %idx
+  %v = load i32, i32 addrspace(1)* %p, align 4
+  %add = add nsw i32 %v, 1
+  store i32 %add, i32 addrspace(1)* %p, align 4
+  %inc = add nsw i32 %i, 1
+  br label %for.cond, !llvm.loop !2
+
+for.end:
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.spir.version = !{!4}
+!opencl.ocl.version = !{!4}
+!opencl.used.extensions = !{!5}
+!opencl.used.optional.core.features = !{!5}
+!opencl.compiler.options = !{!5}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.unroll.disable"}
+!2 = distinct !{!2, !3}
+!3 = !{!"llvm.loop.vectorize.width", i32 4}
+!4 = !{i32 1, i32 2}
+!5 = !{}
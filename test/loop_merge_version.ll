@@ -0,0 +1,53 @@
+; Check that a parallel loop does not raise the version of the module to
+; SPIR-V 1.1 unless -spirv-max-version allows it.
+; RUN: llvm-as < %s > %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o - | FileCheck %s --check-prefix=CHECK-1_0
+; RUN: llvm-spirv %t.bc -spirv-max-version=1.0 -spirv-text -o - | FileCheck %s --check-prefix=CHECK-1_0
+; RUN: llvm-spirv %t.bc -spirv-max-version=1.1 -spirv-text -o - | FileCheck %s --check-prefix=CHECK-1_1
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -to-text %t.spv -o - | FileCheck %s --check-prefix=CHECK-1_0
+
+; CHECK-1_0: 119734787 65536
+; CHECK-1_0: 4 LoopMerge {{[0-9]+}} {{[0-9]+}} 2
+
+; CHECK-1_1: 119734787 65792
+; CHECK-1_1: 4 LoopMerge {{[0-9]+}} {{[0-9]+}} 6
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_func void @parallel(i32 addrspace(1)* %a, i32 %n) #0 {
+entry:
+  br label %for.cond
+
+for.cond:
+  %i = phi i32 [ 0, %entry ], [ %inc, %for.body ]
+  %cmp = icmp slt i32 %i, %n
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %idx = sext i32 %i to i64
+  %p = getelementptr inbounds i32, i32 addrspace(1)* %a, i64 %idx
+  %v = load i32, i32 addrspace(1)* %p, align 4, !llvm.mem.parallel_loop_access !0
+  %add = add nsw i32 %v, 1
+  store i32 %add, i32 addrspace(1)* %p, align 4, !llvm.mem.parallel_loop_access !0
+  %inc = add nsw i32 %i, 1
+  br label %for.cond, !llvm.loop !0
+
+for.end:
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.spir.version = !{!2}
+!opencl.ocl.version = !{!2}
+!opencl.used.extensions = !{!3}
+!opencl.used.optional.core.features = !{!3}
+!opencl.compiler.options = !{!3}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.unroll.disable"}
+!2 = !{i32 1, i32 2}
+!3 = !{}
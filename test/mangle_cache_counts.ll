@@ -0,0 +1,15 @@
+; Check that the hits and misses of the mangled builtin name cache are
+; reported without -stats, so also in builds without assertions.
+; RUN: llvm-as %S/mangling_substitutions.ll -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv-bench -in-process -requests=2 -concurrency=1 %t.spv | FileCheck %s
+; RUN: llvm-spirv-bench -in-process -requests=2 -concurrency=1 -spirv-mangle-cache-size=0 %t.spv | FileCheck %s --check-prefix=NOCACHE
+
+; CHECK: requests: 2
+; CHECK-NEXT: errors: 0
+; CHECK: latency max:
+; CHECK-NEXT: mangle cache hits: {{[1-9][0-9]*}}
+; CHECK-NEXT: mangle cache misses: {{[1-9][0-9]*}}
+
+; NOCACHE: mangle cache hits: 0
+; NOCACHE-NEXT: mangle cache misses: {{[1-9][0-9]*}}
@@ -0,0 +1,19 @@
+; Check that the mangled builtin names of one translation are reused by the
+; next translation in the same process, and that the process-wide limit set
+; by -spirv-mangle-cache-size=0 disables the cache.
+; REQUIRES: asserts
+; RUN: llvm-as %S/mangling_substitutions.ll -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv-bench -in-process -requests=2 -concurrency=1 -stats %t.spv 2>%t.stats | FileCheck %s --check-prefix=CHECK-BENCH
+; RUN: FileCheck %s < %t.stats
+; RUN: llvm-spirv-bench -in-process -requests=2 -concurrency=1 -stats -spirv-mangle-cache-size=0 %t.spv 2>%t.nocache.stats | FileCheck %s --check-prefix=CHECK-BENCH
+; RUN: FileCheck %s --check-prefix=NOCACHE < %t.nocache.stats
+
+; CHECK-BENCH: requests: 2
+; CHECK-BENCH-NEXT: errors: 0
+
+; CHECK: {{[1-9][0-9]*}} spirv - Number of builtin names found in the mangle cache
+
+; NOCACHE-NOT: Number of builtin names found in the mangle cache
+; NOCACHE: spirv - Number of builtin names mangled
+; NOCACHE-NOT: Number of builtin names found in the mangle cache
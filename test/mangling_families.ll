@@ -0,0 +1,648 @@
+; Golden mangled names for every builtin signature family the translator
+; handles. Each name is demangled and mangled again by NameMangler; the
+; expected signatures and names were produced by the mangler before it was
+; rewritten, so a change in substitution numbering or type encoding in any
+; family shows up here. Names NameMangler spells differently from clang are
+; followed by its own spelling, see lib/Mangler/NameMangleAPI.h.
+; RUN: sed -n 's/^; NAME: //p' %s | llvm-spirv -demangle-builtins | FileCheck %s
+
+; Images and samplers
+; NAME: _Z11read_imagef11ocl_image1d11ocl_sampleri
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_f
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_fDv2_fDv2_f
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_fS_S_
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_ff
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_i
+; NAME: _Z11read_imagef11ocl_image2d11ocl_samplerDv4_if
+; NAME: _Z11read_imagef11ocl_image2dDv2_i
+; NAME: _Z11read_imagef11ocl_image3d11ocl_samplerDv4_f
+; NAME: _Z11read_imagef14ocl_image1d_rw11ocl_sampleri
+; NAME: _Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f
+; NAME: _Z11read_imagef14ocl_image2d_roDv2_i
+; NAME: _Z11read_imagef15ocl_image2dmsaaDv2_ii
+; NAME: _Z11read_imagef16ocl_image1darray11ocl_samplerDv2_f
+; NAME: _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv2_i
+; NAME: _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv4_if
+; NAME: _Z11read_imagef19ocl_image2d_msaa_roDv2_ii
+; NAME: _Z11read_imagef20ocl_image2d_depth_ro11ocl_samplerDv2_f
+; NAME: _Z11read_imagef21ocl_image1d_buffer_roi
+; NAME: _Z11read_imagei20ocl_image2d_array_roDv4_i
+; NAME: _Z12read_imageui14ocl_image1d_roi
+; NAME: _Z12read_imageui21ocl_image2darraydepth11ocl_samplerDv4_f
+; NAME: _Z12write_imagef11ocl_image2dDv2_iDv4_f
+; NAME: _Z12write_imagef11ocl_image2dDv2_iiDv4_f
+; NAME: _Z12write_imagef11ocl_image3dDv4_iDv4_f
+; NAME: _Z12write_imagef14ocl_image2d_woDv2_iDv4_f
+; NAME: _Z12write_imagef21ocl_image2darraydepthDv4_if
+; NAME: _Z12write_imageh17ocl_image1dbufferiDv4_Dh
+; NAME: _Z12write_imagei14ocl_image3d_woDv4_iS_
+; NAME: _Z13get_image_dim11ocl_image2d
+; NAME: _Z13get_image_dim11ocl_image3d
+; NAME: _Z13get_image_dim16ocl_image2darray
+; NAME: _Z13get_image_dim16ocl_image2ddepth
+; NAME: _Z13get_image_dim20ocl_image2d_array_ro
+; NAME: _Z13get_image_dim21ocl_image2darraydepth
+; NAME: _Z13write_imageui16ocl_image1darrayDv2_iDv4_j
+; NAME: _Z15get_image_depth11ocl_image3d
+; NAME: _Z15get_image_width11ocl_image1d
+; NAME: _Z15get_image_width11ocl_image2d
+; NAME: _Z15get_image_width11ocl_image3d
+; NAME: _Z15get_image_width14ocl_image3d_ro
+; NAME: _Z15get_image_width15ocl_image2dmsaa
+; NAME: _Z15get_image_width16ocl_image1darray
+; NAME: _Z15get_image_width16ocl_image2darray
+; NAME: _Z15get_image_width17ocl_image1dbuffer
+; NAME: _Z15get_image_width20ocl_image2d_array_ro
+; NAME: _Z15get_image_width21ocl_image2darraydepth
+; NAME: _Z16get_image_height11ocl_image2d
+; NAME: _Z16get_image_height11ocl_image3d
+; NAME: _Z16get_image_height15ocl_image2dmsaa
+; NAME: _Z16get_image_height16ocl_image2darray
+; NAME: _Z16get_image_height21ocl_image2darraydepth
+; NAME: _Z20get_image_array_size16ocl_image1darray
+; NAME: _Z20get_image_array_size16ocl_image2darray
+; NAME: _Z20get_image_array_size21ocl_image2darraydepth
+; NAME: _Z21get_image_num_samples15ocl_image2dmsaa
+; NAME: _Z23get_image_channel_order11ocl_image2d
+; NAME: _Z23get_image_channel_order15ocl_image2dmsaa
+; NAME: _Z27get_image_channel_data_type11ocl_image2d
+; NAME: _Z27intel_sub_group_block_read214ocl_image2d_roDv2_i
+; NAME: _Z28intel_sub_group_block_write214ocl_image2d_woDv2_iDv2_j
+; NAME: _Z31intel_sub_group_block_write_us214ocl_image2d_woDv2_iDv2_t
+
+; Pipes and reserve ids
+; NAME: _Z10write_pipePU3AS18ocl_pipe13ocl_reserveidjPU3AS4vjj
+; NAME: _Z10write_pipePU3AS18ocl_pipePU3AS4Kvjj
+; NAME: _Z10write_pipePU3AS18ocl_pipePU3AS4vjj
+; NAME: _Z16commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z17commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z17reserve_read_pipePU3AS18ocl_pipejjj
+; NAME: _Z18reserve_write_pipePU3AS18ocl_pipejjj
+; NAME: _Z19is_valid_reserve_id13ocl_reserveid
+; NAME: _Z20get_pipe_max_packetsPU3AS18ocl_pipejj
+; NAME: _Z20get_pipe_num_packetsPU3AS18ocl_pipe
+; NAME: _Z20get_pipe_num_packetsPU3AS18ocl_pipejj
+; NAME: _Z26sub_group_commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z27sub_group_commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z27sub_group_reserve_read_pipePU3AS18ocl_pipejjj
+; NAME: _Z27work_group_commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z28sub_group_reserve_write_pipePU3AS18ocl_pipejjj
+; NAME: _Z28work_group_commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj
+; NAME: _Z28work_group_reserve_read_pipePU3AS18ocl_pipejjj
+; NAME: _Z29work_group_reserve_write_pipePU3AS18ocl_pipejjj
+; NAME: _Z9read_pipePU3AS18ocl_pipe13ocl_reserveidjPU3AS4vjj
+; NAME: _Z9read_pipePU3AS18ocl_pipePU3AS4vjj
+
+; OpenCL 1.2 and 2.0 atomics
+; NAME: _Z10atomic_addPVU3AS1ii
+; NAME: _Z10atomic_addPVU3AS1jj
+; NAME: _Z10atomic_addPVU3AS3ii
+; NAME: _Z10atomic_addPVU3AS3jj
+; NAME: _Z10atomic_andPVU3AS1ii
+; NAME: _Z10atomic_andPVU3AS1jj
+; NAME: _Z10atomic_andPVU3AS3ii
+; NAME: _Z10atomic_andPVU3AS3jj
+; NAME: _Z10atomic_decPVU3AS1j
+; NAME: _Z10atomic_decPVU3AS3j
+; NAME: _Z10atomic_incPU3AS1Vi
+; NAME: _Z10atomic_incPVU3AS1i
+; NAME: _Z10atomic_incPVU3AS3i
+; NAME: _Z10atomic_maxPVU3AS1ii
+; NAME: _Z10atomic_maxPVU3AS1jj
+; NAME: _Z10atomic_maxPVU3AS3ii
+; NAME: _Z10atomic_maxPVU3AS3jj
+; NAME: _Z10atomic_minPVU3AS1ii
+; NAME: _Z10atomic_minPVU3AS1jj
+; NAME: _Z10atomic_minPVU3AS3ii
+; NAME: _Z10atomic_minPVU3AS3jj
+; NAME: _Z10atomic_subPVU3AS1ii
+; NAME: _Z10atomic_subPVU3AS1jj
+; NAME: _Z10atomic_subPVU3AS3ii
+; NAME: _Z10atomic_subPVU3AS3jj
+; NAME: _Z10atomic_xorPVU3AS1ii
+; NAME: _Z10atomic_xorPVU3AS1jj
+; NAME: _Z10atomic_xorPVU3AS3ii
+; NAME: _Z10atomic_xorPVU3AS3jj
+; NAME: _Z11atomic_initPVU3AS4U7_Atomicii
+; NAME: _Z11atomic_loadPVU3AS4U7_Atomici
+; NAME: _Z11atomic_xchgPVU3AS1ii
+; NAME: _Z11atomic_xchgPVU3AS1jj
+; NAME: _Z11atomic_xchgPVU3AS3ii
+; NAME: _Z11atomic_xchgPVU3AS3jj
+; NAME: _Z12atom_cmpxchgPVU3AS3lll
+; NAME: _Z12atomic_storePVU3AS4U7_Atomicii
+; NAME: _Z12atomic_storePVU3AS4U7_Atomicll
+; NAME: _Z14atomic_cmpxchgPU3AS3Vjjj
+; NAME: _Z14atomic_cmpxchgPVU3AS1iii
+; NAME: _Z14atomic_cmpxchgPVU3AS1jjj
+; NAME: _Z14atomic_cmpxchgPVU3AS3iii
+; NAME: _Z14atomic_cmpxchgPVU3AS3jjj
+; NAME: _Z15atomic_exchangePVU3AS4U7_Atomicff
+; NAME: _Z15atomic_fetch_orPVU3AS4U7_Atomicmm
+; NAME: _Z16atomic_fetch_minPVU3AS4U7_Atomicii
+; NAME: _Z16atomic_fetch_minPVU3AS4U7_Atomicjj
+; NAME: _Z16atomic_fetch_xorPVU3AS4U7_Atomicll
+; NAME: _Z20atomic_load_explicitPVU3AS4U7_Atomicf12memory_order
+; NAME: _Z21atomic_store_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope
+; NAME: _Z21atomic_store_explicitPVU3AS4U7_Atomiciiii
+; NAME: _Z22atomic_work_item_fencej12memory_order12memory_scope
+; NAME: _Z22atomic_work_item_fencejii
+; NAME: _Z24atomic_exchange_explicitPVU3AS4U7_Atomicdd12memory_order
+; NAME: _Z24atomic_flag_test_and_setPVU3AS4U7_Atomici
+; NAME: _Z25atomic_fetch_add_explicitPU3AS4VU7_Atomicii12memory_order12memory_scope
+; NAME: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order
+; NAME: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope
+; NAME: _Z25atomic_fetch_and_explicitPVU3AS4U7_Atomicjj12memory_order12memory_scope
+; NAME: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicii12memory_order
+; NAME: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomiciiii
+; NAME: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjj12memory_order
+; NAME: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjjii
+; NAME: _Z25atomic_fetch_min_explicitPVU3AS4U7_Atomiciiii
+; NAME: _Z25atomic_fetch_min_explicitPVU3AS4U7_Atomicjjii
+; NAME: _Z26atomic_flag_clear_explicitPVU3AS4U7_Atomici12memory_order12memory_scope
+; NAME: _Z28atomic_compare_exchange_weakPVU3AS4U7_AtomiciPU3AS4ii
+; NAME: _Z30atomic_compare_exchange_strongPVU3AS4U7_AtomiciPU3AS4ii
+; NAME: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_
+; NAME: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope
+; NAME: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPiiiii
+; NAME: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_
+; NAME: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope
+; NAME: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPiiiii
+; NAME: _Z8atom_addPU3AS1Vii
+; NAME: _Z9atom_xchgPVU3AS1mm
+; NAME: _Z9atomic_orPVU3AS1ii
+; NAME: _Z9atomic_orPVU3AS1jj
+; NAME: _Z9atomic_orPVU3AS3ii
+; NAME: _Z9atomic_orPVU3AS3jj
+
+; Blocks
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvPU3AS3vzEjz
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvvE
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvPU3AS3vzEjz
+; NAME: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvvE
+; NAME: _Z26get_kernel_work_group_sizeU13block_pointerFvPU3AS3vzE
+; NAME: _Z26get_kernel_work_group_sizeU13block_pointerFvvE
+; NAME: _Z38get_kernel_sub_group_count_for_ndrange9ndrange_tU13block_pointerFvvE
+; NAME: _Z41get_kernel_max_sub_group_size_for_ndrange9ndrange_tU13block_pointerFvPU3AS3vzE
+; NAME: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvPU3AS3vzE
+; NAME: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvvE
+
+; vload and vstore
+; NAME: _Z10vload_halfjPKU3AS1Dh
+; NAME: _Z11vload_half3jPKU3AS3Dh
+; NAME: _Z11vload_half4jPKDh
+; NAME: _Z12vloada_half4jPKU3AS1Dh
+; NAME: _Z12vstore_half2Dv2_fjPU3AS1Dh
+; NAME: _Z13vloada_half16jPKU3AS2Dh
+; NAME: _Z15vstore_half_rtefjPU3AS1Dh
+; NAME: _Z16vstore_half4_rtzDv4_djPU3AS3Dh
+; NAME: _Z17vstorea_half4_rtpDv4_fmPU3AS1Dh
+; NAME: _Z17vstorea_half8_rtnDv8_fjPDh
+; NAME: _Z6vload2mPKU3AS3c
+; NAME: _Z6vload3jPKU3AS4s
+; NAME: _Z6vload4jPKU3AS1f
+; NAME: _Z6vload4jPU3AS1Kf
+; NAME: _Z6vload8jPKU3AS2d
+; NAME: _Z7vload16jPKh
+; NAME: _Z7vstore2Dv2_cmPU3AS3c
+; NAME: _Z7vstore3Dv3_sjPU3AS4s
+; NAME: _Z7vstore4Dv4_fjPU3AS1f
+; NAME: _Z7vstore8Dv8_ijPi
+; NAME: _Z8vstore16Dv16_hjPU3AS1h
+
+; Work items, math, relational, conversion, events and sub groups
+; NAME: _Z10ndrange_1Djj
+; NAME: _Z10ndrange_1Djjj
+; NAME: _Z10ndrange_1Dm
+; NAME: _Z10ndrange_1Dmm
+; NAME: _Z10ndrange_2DPKm
+; NAME: _Z10ndrange_2DPKmS0_
+; NAME: _Z10ndrange_3DPKm
+; NAME: _Z12convert_int8Dv8_f
+; NAME: _Z12convert_int8Dv8_t
+; NAME: _Z12get_group_idj
+; NAME: _Z12get_local_idj
+; NAME: _Z12retain_event12ocl_clkevent
+; NAME: _Z13__spirv_IsNanf
+; NAME: _Z13convert_char8Dv8_i
+; NAME: _Z13convert_uint8Dv8_d
+; NAME: _Z13get_global_idj
+; NAME: _Z14__spirv_Selectbii
+; NAME: _Z14convert_float8Dv8_d
+; NAME: _Z14convert_float8Dv8_j
+; NAME: _Z14convert_short8Dv8_c
+; NAME: _Z14enqueue_kernel9ocl_queue
+; NAME: _Z14enqueue_marker9ocl_queuejPK12ocl_clkeventP12ocl_clkevent
+; NAME: _Z14get_local_sizej
+; NAME: _Z14isgreaterequalff
+; NAME: _Z14work_group_alli
+; NAME: _Z14work_group_anyi
+; NAME: _Z15convert_double8Dv8_c
+; NAME: _Z15convert_double8Dv8_f
+; NAME: _Z15convert_double8Dv8_i
+; NAME: _Z15convert_ushort8Dv8_c
+; NAME: _Z16convert_char_satf
+; NAME: _Z17get_default_queuev
+; NAME: _Z17sub_group_barrierj
+; NAME: _Z17sub_group_barrierji
+; NAME: _Z17wait_group_eventsiP9ocl_event
+; NAME: _Z17wait_group_eventsiPU3AS49ocl_event
+; NAME: _Z18get_sub_group_sizev
+; NAME: _Z18work_group_barrierj
+; NAME: _Z18work_group_barrierji
+; NAME: _Z19sub_group_broadcastij
+; NAME: _Z20__spirv_SampledImagePU3AS1K34__spirv_Image__float_1_1_0_0_0_0_0PU3AS1K15__spirv_Sampler
+; NAME: _Z20convert_int4_sat_rteDv4_f
+; NAME: _Z20sub_group_reduce_addi
+; NAME: _Z21async_work_group_copyPU3AS1Dv2_cPKU3AS3S_j9ocl_event
+; NAME: _Z21async_work_group_copyPU3AS3fPKU3AS1fj9ocl_event
+; NAME: _Z22__spirv_ControlBarrieriii
+; NAME: _Z22get_sub_group_local_idv
+; NAME: _Z23intel_sub_group_shuffleDv2_fj
+; NAME: _Z26intel_sub_group_shuffle_upDv2_fDv2_fj
+; NAME: _Z27intel_sub_group_shuffle_xorDv2_fj
+; NAME: _Z28__spirv_FOrdGreaterThanEqualff
+; NAME: _Z28intel_sub_group_block_write2PU3AS1jDv2_j
+; NAME: _Z28intel_sub_group_shuffle_downDv2_fDv2_fj
+; NAME: _Z29async_work_group_strided_copyPU3AS1Dv2_hPKU3AS3S_jj9ocl_event
+; NAME: _Z30intel_sub_group_block_read_us2PKU3AS1t
+; NAME: _Z31intel_sub_group_block_write_us2PU3AS1tDv2_t
+; NAME: _Z38__spirv_CreatePipeFromPipeStorage_readPU3AS119__spirv_PipeStorage
+; NAME: _Z38__spirv_CreatePipeFromPipeStorage_readPU3AS1K19__spirv_PipeStorage
+; NAME: _Z38__spirv_ImageSampleExplicitLod_Rfloat4PU3AS120__spirv_SampledImageDv4_iif
+; NAME: _Z39__spirv_CreatePipeFromPipeStorage_writePU3AS119__spirv_PipeStorage
+; NAME: _Z39__spirv_CreatePipeFromPipeStorage_writePU3AS1K19__spirv_PipeStorage
+; NAME: _Z3absi
+; NAME: _Z3allDv2_i
+; NAME: _Z3allDv2_l
+; NAME: _Z3anyDv2_i
+; NAME: _Z3anyDv2_l
+; NAME: _Z3anyDv4_i
+; NAME: _Z3cosf
+; NAME: _Z3dotDv4_fS_
+; NAME: _Z3dotff
+; NAME: _Z3fmafff
+; NAME: _Z3minDv2_iS_
+; NAME: _Z3minDv2_ii
+; NAME: _Z3mixDv4_fS_f
+; NAME: _Z4fabsDv4_f
+; NAME: _Z4fmaxDv4_fS_
+; NAME: _Z4fmodff
+; NAME: _Z4modfDv8_fPU3AS3S_
+; NAME: _Z4sqrtDh
+; NAME: _Z4sqrtf
+; NAME: _Z5clampDhDhDh
+; NAME: _Z5clampDv4_fS_S_
+; NAME: _Z5clampfff
+; NAME: _Z5crossDv3_fS_
+; NAME: _Z5fractDv4_fPU3AS1S_
+; NAME: _Z5frexpDv2_dPDv2_i
+; NAME: _Z5isinfDh
+; NAME: _Z5isinfDv2_Dh
+; NAME: _Z5isinfDv2_d
+; NAME: _Z5isinfDv2_f
+; NAME: _Z5isinff
+; NAME: _Z5isnanDh
+; NAME: _Z5isnanDv2_Dh
+; NAME: _Z5isnanDv2_d
+; NAME: _Z5isnanDv2_f
+; NAME: _Z5isnanf
+; NAME: _Z6remquoffPi
+; NAME: _Z6selectDv4_iS_S_
+; NAME: _Z6sincosfPf
+; NAME: _Z7barrierj
+; NAME: _Z7isequalDv8_fDv8_f
+; NAME: _Z7shuffleDv4_fDv4_j
+; NAME: _Z7signbitDh
+; NAME: _Z7signbitf
+; NAME: _Z8copysigndd
+; NAME: _Z8isfiniteDh
+; NAME: _Z8isfiniteDv2_Dh
+; NAME: _Z8isfiniteDv2_d
+; NAME: _Z8isfiniteDv2_f
+; NAME: _Z8isfinitef
+; NAME: _Z8isnormalDh
+; NAME: _Z8isnormalDv2_Dh
+; NAME: _Z8isnormalDv2_d
+; NAME: _Z8isnormalDv2_f
+; NAME: _Z8isnormalf
+; NAME: _Z8shuffle2Dv8_iS_Dv8_j
+; NAME: _Z9bitselectDv2_fS_S_
+; NAME: _Z9get_fencePKU3AS4v
+; NAME: _Z9get_fencePU3AS4v
+; NAME: _Z9mem_fencej
+
+; CHECK: _Z11read_imagef11ocl_image1d11ocl_sampleri -> read_imagef(image1d_t, sampler_t, int){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_f -> read_imagef(image2d_t, sampler_t, float2){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_fDv2_fDv2_f -> read_imagef(image2d_t, sampler_t, float2, float2, float2) -> _Z11read_imagef11ocl_image2d11ocl_samplerDv2_fS_S_
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_fS_S_ -> read_imagef(image2d_t, sampler_t, float2, float2, float2){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_ff -> read_imagef(image2d_t, sampler_t, float2, float){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv2_i -> read_imagef(image2d_t, sampler_t, int2){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2d11ocl_samplerDv4_if -> read_imagef(image2d_t, sampler_t, int4, float){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image2dDv2_i -> read_imagef(image2d_t, int2){{$}}
+; CHECK-NEXT: _Z11read_imagef11ocl_image3d11ocl_samplerDv4_f -> read_imagef(image3d_t, sampler_t, float4){{$}}
+; CHECK-NEXT: _Z11read_imagef14ocl_image1d_rw11ocl_sampleri -> read_imagef(image1d_t, sampler_t, int) -> _Z11read_imagef11ocl_image1d11ocl_sampleri
+; CHECK-NEXT: _Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f -> read_imagef(image2d_t, sampler_t, float2) -> _Z11read_imagef11ocl_image2d11ocl_samplerDv2_f
+; CHECK-NEXT: _Z11read_imagef14ocl_image2d_roDv2_i -> read_imagef(image2d_t, int2) -> _Z11read_imagef11ocl_image2dDv2_i
+; CHECK-NEXT: _Z11read_imagef15ocl_image2dmsaaDv2_ii -> read_imagef(image2d_msaa_t, int2, int){{$}}
+; CHECK-NEXT: _Z11read_imagef16ocl_image1darray11ocl_samplerDv2_f -> read_imagef(image1d_array_t, sampler_t, float2){{$}}
+; CHECK-NEXT: _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv2_i -> read_imagef(image2d_depth_t, sampler_t, int2){{$}}
+; CHECK-NEXT: _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv4_if -> read_imagef(image2d_depth_t, sampler_t, int4, float){{$}}
+; CHECK-NEXT: _Z11read_imagef19ocl_image2d_msaa_roDv2_ii -> read_imagef(image2d_msaa_t, int2, int) -> _Z11read_imagef15ocl_image2dmsaaDv2_ii
+; CHECK-NEXT: _Z11read_imagef20ocl_image2d_depth_ro11ocl_samplerDv2_f -> read_imagef(image2d_depth_t, sampler_t, float2) -> _Z11read_imagef16ocl_image2ddepth11ocl_samplerDv2_f
+; CHECK-NEXT: _Z11read_imagef21ocl_image1d_buffer_roi -> read_imagef(image1d_buffer_t, int) -> _Z11read_imagef17ocl_image1dbufferi
+; CHECK-NEXT: _Z11read_imagei20ocl_image2d_array_roDv4_i -> read_imagei(image2d_array_t, int4) -> _Z11read_imagei16ocl_image2darrayDv4_i
+; CHECK-NEXT: _Z12read_imageui14ocl_image1d_roi -> read_imageui(image1d_t, int) -> _Z12read_imageui11ocl_image1di
+; CHECK-NEXT: _Z12read_imageui21ocl_image2darraydepth11ocl_samplerDv4_f -> read_imageui(image2d_array_depth_t, sampler_t, float4){{$}}
+; CHECK-NEXT: _Z12write_imagef11ocl_image2dDv2_iDv4_f -> write_imagef(image2d_t, int2, float4){{$}}
+; CHECK-NEXT: _Z12write_imagef11ocl_image2dDv2_iiDv4_f -> write_imagef(image2d_t, int2, int, float4){{$}}
+; CHECK-NEXT: _Z12write_imagef11ocl_image3dDv4_iDv4_f -> write_imagef(image3d_t, int4, float4){{$}}
+; CHECK-NEXT: _Z12write_imagef14ocl_image2d_woDv2_iDv4_f -> write_imagef(image2d_t, int2, float4) -> _Z12write_imagef11ocl_image2dDv2_iDv4_f
+; CHECK-NEXT: _Z12write_imagef21ocl_image2darraydepthDv4_if -> write_imagef(image2d_array_depth_t, int4, float){{$}}
+; CHECK-NEXT: _Z12write_imageh17ocl_image1dbufferiDv4_Dh -> write_imageh(image1d_buffer_t, int, half4){{$}}
+; CHECK-NEXT: _Z12write_imagei14ocl_image3d_woDv4_iS_ -> write_imagei(image3d_t, int4, int4) -> _Z12write_imagei11ocl_image3dDv4_iS_
+; CHECK-NEXT: _Z13get_image_dim11ocl_image2d -> get_image_dim(image2d_t){{$}}
+; CHECK-NEXT: _Z13get_image_dim11ocl_image3d -> get_image_dim(image3d_t){{$}}
+; CHECK-NEXT: _Z13get_image_dim16ocl_image2darray -> get_image_dim(image2d_array_t){{$}}
+; CHECK-NEXT: _Z13get_image_dim16ocl_image2ddepth -> get_image_dim(image2d_depth_t){{$}}
+; CHECK-NEXT: _Z13get_image_dim20ocl_image2d_array_ro -> get_image_dim(image2d_array_t) -> _Z13get_image_dim16ocl_image2darray
+; CHECK-NEXT: _Z13get_image_dim21ocl_image2darraydepth -> get_image_dim(image2d_array_depth_t){{$}}
+; CHECK-NEXT: _Z13write_imageui16ocl_image1darrayDv2_iDv4_j -> write_imageui(image1d_array_t, int2, uint4){{$}}
+; CHECK-NEXT: _Z15get_image_depth11ocl_image3d -> get_image_depth(image3d_t){{$}}
+; CHECK-NEXT: _Z15get_image_width11ocl_image1d -> get_image_width(image1d_t){{$}}
+; CHECK-NEXT: _Z15get_image_width11ocl_image2d -> get_image_width(image2d_t){{$}}
+; CHECK-NEXT: _Z15get_image_width11ocl_image3d -> get_image_width(image3d_t){{$}}
+; CHECK-NEXT: _Z15get_image_width14ocl_image3d_ro -> get_image_width(image3d_t) -> _Z15get_image_width11ocl_image3d
+; CHECK-NEXT: _Z15get_image_width15ocl_image2dmsaa -> get_image_width(image2d_msaa_t){{$}}
+; CHECK-NEXT: _Z15get_image_width16ocl_image1darray -> get_image_width(image1d_array_t){{$}}
+; CHECK-NEXT: _Z15get_image_width16ocl_image2darray -> get_image_width(image2d_array_t){{$}}
+; CHECK-NEXT: _Z15get_image_width17ocl_image1dbuffer -> get_image_width(image1d_buffer_t){{$}}
+; CHECK-NEXT: _Z15get_image_width20ocl_image2d_array_ro -> get_image_width(image2d_array_t) -> _Z15get_image_width16ocl_image2darray
+; CHECK-NEXT: _Z15get_image_width21ocl_image2darraydepth -> get_image_width(image2d_array_depth_t){{$}}
+; CHECK-NEXT: _Z16get_image_height11ocl_image2d -> get_image_height(image2d_t){{$}}
+; CHECK-NEXT: _Z16get_image_height11ocl_image3d -> get_image_height(image3d_t){{$}}
+; CHECK-NEXT: _Z16get_image_height15ocl_image2dmsaa -> get_image_height(image2d_msaa_t){{$}}
+; CHECK-NEXT: _Z16get_image_height16ocl_image2darray -> get_image_height(image2d_array_t){{$}}
+; CHECK-NEXT: _Z16get_image_height21ocl_image2darraydepth -> get_image_height(image2d_array_depth_t){{$}}
+; CHECK-NEXT: _Z20get_image_array_size16ocl_image1darray -> get_image_array_size(image1d_array_t){{$}}
+; CHECK-NEXT: _Z20get_image_array_size16ocl_image2darray -> get_image_array_size(image2d_array_t){{$}}
+; CHECK-NEXT: _Z20get_image_array_size21ocl_image2darraydepth -> get_image_array_size(image2d_array_depth_t){{$}}
+; CHECK-NEXT: _Z21get_image_num_samples15ocl_image2dmsaa -> get_image_num_samples(image2d_msaa_t){{$}}
+; CHECK-NEXT: _Z23get_image_channel_order11ocl_image2d -> get_image_channel_order(image2d_t){{$}}
+; CHECK-NEXT: _Z23get_image_channel_order15ocl_image2dmsaa -> get_image_channel_order(image2d_msaa_t){{$}}
+; CHECK-NEXT: _Z27get_image_channel_data_type11ocl_image2d -> get_image_channel_data_type(image2d_t){{$}}
+; CHECK-NEXT: _Z27intel_sub_group_block_read214ocl_image2d_roDv2_i -> intel_sub_group_block_read2(image2d_t, int2) -> _Z27intel_sub_group_block_read211ocl_image2dDv2_i
+; CHECK-NEXT: _Z28intel_sub_group_block_write214ocl_image2d_woDv2_iDv2_j -> intel_sub_group_block_write2(image2d_t, int2, uint2) -> _Z28intel_sub_group_block_write211ocl_image2dDv2_iDv2_j
+; CHECK-NEXT: _Z31intel_sub_group_block_write_us214ocl_image2d_woDv2_iDv2_t -> intel_sub_group_block_write_us2(image2d_t, int2, ushort2) -> _Z31intel_sub_group_block_write_us211ocl_image2dDv2_iDv2_t
+; CHECK-NEXT: _Z10write_pipePU3AS18ocl_pipe13ocl_reserveidjPU3AS4vjj -> write_pipe(__global pipe_t *, reserve_id_t, uint, __generic void *, uint, uint){{$}}
+; CHECK-NEXT: _Z10write_pipePU3AS18ocl_pipePU3AS4Kvjj -> write_pipe(__global pipe_t *, const __generic void *, uint, uint) -> _Z10write_pipePU3AS18ocl_pipePKU3AS4vjj
+; CHECK-NEXT: _Z10write_pipePU3AS18ocl_pipePU3AS4vjj -> write_pipe(__global pipe_t *, __generic void *, uint, uint){{$}}
+; CHECK-NEXT: _Z16commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj -> commit_read_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z17commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj -> commit_write_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z17reserve_read_pipePU3AS18ocl_pipejjj -> reserve_read_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z18reserve_write_pipePU3AS18ocl_pipejjj -> reserve_write_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z19is_valid_reserve_id13ocl_reserveid -> is_valid_reserve_id(reserve_id_t){{$}}
+; CHECK-NEXT: _Z20get_pipe_max_packetsPU3AS18ocl_pipejj -> get_pipe_max_packets(__global pipe_t *, uint, uint){{$}}
+; CHECK-NEXT: _Z20get_pipe_num_packetsPU3AS18ocl_pipe -> get_pipe_num_packets(__global pipe_t *){{$}}
+; CHECK-NEXT: _Z20get_pipe_num_packetsPU3AS18ocl_pipejj -> get_pipe_num_packets(__global pipe_t *, uint, uint){{$}}
+; CHECK-NEXT: _Z26sub_group_commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj -> sub_group_commit_read_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z27sub_group_commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj -> sub_group_commit_write_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z27sub_group_reserve_read_pipePU3AS18ocl_pipejjj -> sub_group_reserve_read_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z27work_group_commit_read_pipePU3AS18ocl_pipe13ocl_reserveidjj -> work_group_commit_read_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z28sub_group_reserve_write_pipePU3AS18ocl_pipejjj -> sub_group_reserve_write_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z28work_group_commit_write_pipePU3AS18ocl_pipe13ocl_reserveidjj -> work_group_commit_write_pipe(__global pipe_t *, reserve_id_t, uint, uint){{$}}
+; CHECK-NEXT: _Z28work_group_reserve_read_pipePU3AS18ocl_pipejjj -> work_group_reserve_read_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z29work_group_reserve_write_pipePU3AS18ocl_pipejjj -> work_group_reserve_write_pipe(__global pipe_t *, uint, uint, uint){{$}}
+; CHECK-NEXT: _Z9read_pipePU3AS18ocl_pipe13ocl_reserveidjPU3AS4vjj -> read_pipe(__global pipe_t *, reserve_id_t, uint, __generic void *, uint, uint){{$}}
+; CHECK-NEXT: _Z9read_pipePU3AS18ocl_pipePU3AS4vjj -> read_pipe(__global pipe_t *, __generic void *, uint, uint){{$}}
+; CHECK-NEXT: _Z10atomic_addPVU3AS1ii -> atomic_add(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_addPVU3AS1jj -> atomic_add(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_addPVU3AS3ii -> atomic_add(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_addPVU3AS3jj -> atomic_add(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_andPVU3AS1ii -> atomic_and(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_andPVU3AS1jj -> atomic_and(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_andPVU3AS3ii -> atomic_and(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_andPVU3AS3jj -> atomic_and(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_decPVU3AS1j -> atomic_dec(volatile __global uint *){{$}}
+; CHECK-NEXT: _Z10atomic_decPVU3AS3j -> atomic_dec(volatile __local uint *){{$}}
+; CHECK-NEXT: _Z10atomic_incPU3AS1Vi -> atomic_inc(volatile __global int *) -> _Z10atomic_incPVU3AS1i
+; CHECK-NEXT: _Z10atomic_incPVU3AS1i -> atomic_inc(volatile __global int *){{$}}
+; CHECK-NEXT: _Z10atomic_incPVU3AS3i -> atomic_inc(volatile __local int *){{$}}
+; CHECK-NEXT: _Z10atomic_maxPVU3AS1ii -> atomic_max(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_maxPVU3AS1jj -> atomic_max(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_maxPVU3AS3ii -> atomic_max(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_maxPVU3AS3jj -> atomic_max(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_minPVU3AS1ii -> atomic_min(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_minPVU3AS1jj -> atomic_min(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_minPVU3AS3ii -> atomic_min(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_minPVU3AS3jj -> atomic_min(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_subPVU3AS1ii -> atomic_sub(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_subPVU3AS1jj -> atomic_sub(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_subPVU3AS3ii -> atomic_sub(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_subPVU3AS3jj -> atomic_sub(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_xorPVU3AS1ii -> atomic_xor(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_xorPVU3AS1jj -> atomic_xor(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z10atomic_xorPVU3AS3ii -> atomic_xor(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z10atomic_xorPVU3AS3jj -> atomic_xor(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z11atomic_initPVU3AS4U7_Atomicii -> atomic_init(volatile __generic atomic_int *, int){{$}}
+; CHECK-NEXT: _Z11atomic_loadPVU3AS4U7_Atomici -> atomic_load(volatile __generic atomic_int *){{$}}
+; CHECK-NEXT: _Z11atomic_xchgPVU3AS1ii -> atomic_xchg(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z11atomic_xchgPVU3AS1jj -> atomic_xchg(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z11atomic_xchgPVU3AS3ii -> atomic_xchg(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z11atomic_xchgPVU3AS3jj -> atomic_xchg(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z12atom_cmpxchgPVU3AS3lll -> atom_cmpxchg(volatile __local long *, long, long){{$}}
+; CHECK-NEXT: _Z12atomic_storePVU3AS4U7_Atomicii -> atomic_store(volatile __generic atomic_int *, int){{$}}
+; CHECK-NEXT: _Z12atomic_storePVU3AS4U7_Atomicll -> atomic_store(volatile __generic atomic_long *, long){{$}}
+; CHECK-NEXT: _Z14atomic_cmpxchgPU3AS3Vjjj -> atomic_cmpxchg(volatile __local uint *, uint, uint) -> _Z14atomic_cmpxchgPVU3AS3jjj
+; CHECK-NEXT: _Z14atomic_cmpxchgPVU3AS1iii -> atomic_cmpxchg(volatile __global int *, int, int){{$}}
+; CHECK-NEXT: _Z14atomic_cmpxchgPVU3AS1jjj -> atomic_cmpxchg(volatile __global uint *, uint, uint){{$}}
+; CHECK-NEXT: _Z14atomic_cmpxchgPVU3AS3iii -> atomic_cmpxchg(volatile __local int *, int, int){{$}}
+; CHECK-NEXT: _Z14atomic_cmpxchgPVU3AS3jjj -> atomic_cmpxchg(volatile __local uint *, uint, uint){{$}}
+; CHECK-NEXT: _Z15atomic_exchangePVU3AS4U7_Atomicff -> atomic_exchange(volatile __generic atomic_float *, float){{$}}
+; CHECK-NEXT: _Z15atomic_fetch_orPVU3AS4U7_Atomicmm -> atomic_fetch_or(volatile __generic atomic_ulong *, ulong){{$}}
+; CHECK-NEXT: _Z16atomic_fetch_minPVU3AS4U7_Atomicii -> atomic_fetch_min(volatile __generic atomic_int *, int){{$}}
+; CHECK-NEXT: _Z16atomic_fetch_minPVU3AS4U7_Atomicjj -> atomic_fetch_min(volatile __generic atomic_uint *, uint){{$}}
+; CHECK-NEXT: _Z16atomic_fetch_xorPVU3AS4U7_Atomicll -> atomic_fetch_xor(volatile __generic atomic_long *, long){{$}}
+; CHECK-NEXT: _Z20atomic_load_explicitPVU3AS4U7_Atomicf12memory_order -> atomic_load_explicit(volatile __generic atomic_float *, memory_order){{$}}
+; CHECK-NEXT: _Z21atomic_store_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope -> atomic_store_explicit(volatile __generic atomic_int *, int, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z21atomic_store_explicitPVU3AS4U7_Atomiciiii -> atomic_store_explicit(volatile __generic atomic_int *, int, int, int){{$}}
+; CHECK-NEXT: _Z22atomic_work_item_fencej12memory_order12memory_scope -> atomic_work_item_fence(uint, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z22atomic_work_item_fencejii -> atomic_work_item_fence(uint, int, int){{$}}
+; CHECK-NEXT: _Z24atomic_exchange_explicitPVU3AS4U7_Atomicdd12memory_order -> atomic_exchange_explicit(volatile __generic atomic_double *, double, memory_order){{$}}
+; CHECK-NEXT: _Z24atomic_flag_test_and_setPVU3AS4U7_Atomici -> atomic_flag_test_and_set(volatile __generic atomic_int *){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPU3AS4VU7_Atomicii12memory_order12memory_scope -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order, memory_scope) -> _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_add_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope -> atomic_fetch_add_explicit(volatile __generic atomic_int *, int, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_and_explicitPVU3AS4U7_Atomicjj12memory_order12memory_scope -> atomic_fetch_and_explicit(volatile __generic atomic_uint *, uint, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicii12memory_order -> atomic_fetch_max_explicit(volatile __generic atomic_int *, int, memory_order){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomiciiii -> atomic_fetch_max_explicit(volatile __generic atomic_int *, int, int, int){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjj12memory_order -> atomic_fetch_max_explicit(volatile __generic atomic_uint *, uint, memory_order){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjjii -> atomic_fetch_max_explicit(volatile __generic atomic_uint *, uint, int, int){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_min_explicitPVU3AS4U7_Atomiciiii -> atomic_fetch_min_explicit(volatile __generic atomic_int *, int, int, int){{$}}
+; CHECK-NEXT: _Z25atomic_fetch_min_explicitPVU3AS4U7_Atomicjjii -> atomic_fetch_min_explicit(volatile __generic atomic_uint *, uint, int, int){{$}}
+; CHECK-NEXT: _Z26atomic_flag_clear_explicitPVU3AS4U7_Atomici12memory_order12memory_scope -> atomic_flag_clear_explicit(volatile __generic atomic_int *, memory_order, memory_scope){{$}}
+; CHECK-NEXT: _Z28atomic_compare_exchange_weakPVU3AS4U7_AtomiciPU3AS4ii -> atomic_compare_exchange_weak(volatile __generic atomic_int *, __generic int *, int){{$}}
+; CHECK-NEXT: _Z30atomic_compare_exchange_strongPVU3AS4U7_AtomiciPU3AS4ii -> atomic_compare_exchange_strong(volatile __generic atomic_int *, __generic int *, int){{$}}
+; CHECK-NEXT: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_ -> atomic_compare_exchange_weak_explicit(volatile __generic atomic_int *, __generic int *, int, memory_order, memory_order) -> _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_order12memory_order
+; CHECK-NEXT: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope -> atomic_compare_exchange_weak_explicit(volatile __generic atomic_int *, __generic int *, int, memory_order, memory_order, memory_scope) -> _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_order12memory_order12memory_scope
+; CHECK-NEXT: _Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPiiiii -> atomic_compare_exchange_weak_explicit(volatile __generic atomic_int *, __private int *, int, int, int, int){{$}}
+; CHECK-NEXT: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_ -> atomic_compare_exchange_strong_explicit(volatile __generic atomic_int *, __generic int *, int, memory_order, memory_order) -> _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_order12memory_order
+; CHECK-NEXT: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope -> atomic_compare_exchange_strong_explicit(volatile __generic atomic_int *, __generic int *, int, memory_order, memory_order, memory_scope) -> _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_order12memory_order12memory_scope
+; CHECK-NEXT: _Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPiiiii -> atomic_compare_exchange_strong_explicit(volatile __generic atomic_int *, __private int *, int, int, int, int){{$}}
+; CHECK-NEXT: _Z8atom_addPU3AS1Vii -> atom_add(volatile __global int *, int) -> _Z8atom_addPVU3AS1ii
+; CHECK-NEXT: _Z9atom_xchgPVU3AS1mm -> atom_xchg(volatile __global ulong *, ulong){{$}}
+; CHECK-NEXT: _Z9atomic_orPVU3AS1ii -> atomic_or(volatile __global int *, int){{$}}
+; CHECK-NEXT: _Z9atomic_orPVU3AS1jj -> atomic_or(volatile __global uint *, uint){{$}}
+; CHECK-NEXT: _Z9atomic_orPVU3AS3ii -> atomic_or(volatile __local int *, int){{$}}
+; CHECK-NEXT: _Z9atomic_orPVU3AS3jj -> atomic_or(volatile __local uint *, uint){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvPU3AS3vzEjz -> enqueue_kernel(queue_t, int, ndrange_t, void (__local void *, ...)*, uint, ...){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tU13block_pointerFvvE -> enqueue_kernel(queue_t, int, ndrange_t, void ()*){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvPU3AS3vzEjz -> enqueue_kernel(queue_t, int, ndrange_t, uint, const __private clk_event_t *, __private clk_event_t *, void (__local void *, ...)*, uint, ...){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queuei9ndrange_tjPK12ocl_clkeventP12ocl_clkeventU13block_pointerFvvE -> enqueue_kernel(queue_t, int, ndrange_t, uint, const __private clk_event_t *, __private clk_event_t *, void ()*){{$}}
+; CHECK-NEXT: _Z26get_kernel_work_group_sizeU13block_pointerFvPU3AS3vzE -> get_kernel_work_group_size(void (__local void *, ...)*){{$}}
+; CHECK-NEXT: _Z26get_kernel_work_group_sizeU13block_pointerFvvE -> get_kernel_work_group_size(void ()*){{$}}
+; CHECK-NEXT: _Z38get_kernel_sub_group_count_for_ndrange9ndrange_tU13block_pointerFvvE -> get_kernel_sub_group_count_for_ndrange(ndrange_t, void ()*){{$}}
+; CHECK-NEXT: _Z41get_kernel_max_sub_group_size_for_ndrange9ndrange_tU13block_pointerFvPU3AS3vzE -> get_kernel_max_sub_group_size_for_ndrange(ndrange_t, void (__local void *, ...)*){{$}}
+; CHECK-NEXT: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvPU3AS3vzE -> get_kernel_preferred_work_group_size_multiple(void (__local void *, ...)*){{$}}
+; CHECK-NEXT: _Z45get_kernel_preferred_work_group_size_multipleU13block_pointerFvvE -> get_kernel_preferred_work_group_size_multiple(void ()*){{$}}
+; CHECK-NEXT: _Z10vload_halfjPKU3AS1Dh -> vload_half(uint, const __global half *){{$}}
+; CHECK-NEXT: _Z11vload_half3jPKU3AS3Dh -> vload_half3(uint, const __local half *){{$}}
+; CHECK-NEXT: _Z11vload_half4jPKDh -> vload_half4(uint, const __private half *){{$}}
+; CHECK-NEXT: _Z12vloada_half4jPKU3AS1Dh -> vloada_half4(uint, const __global half *){{$}}
+; CHECK-NEXT: _Z12vstore_half2Dv2_fjPU3AS1Dh -> vstore_half2(float2, uint, __global half *){{$}}
+; CHECK-NEXT: _Z13vloada_half16jPKU3AS2Dh -> vloada_half16(uint, const __constant half *){{$}}
+; CHECK-NEXT: _Z15vstore_half_rtefjPU3AS1Dh -> vstore_half_rte(float, uint, __global half *){{$}}
+; CHECK-NEXT: _Z16vstore_half4_rtzDv4_djPU3AS3Dh -> vstore_half4_rtz(double4, uint, __local half *){{$}}
+; CHECK-NEXT: _Z17vstorea_half4_rtpDv4_fmPU3AS1Dh -> vstorea_half4_rtp(float4, ulong, __global half *){{$}}
+; CHECK-NEXT: _Z17vstorea_half8_rtnDv8_fjPDh -> vstorea_half8_rtn(float8, uint, __private half *){{$}}
+; CHECK-NEXT: _Z6vload2mPKU3AS3c -> vload2(ulong, const __local char *){{$}}
+; CHECK-NEXT: _Z6vload3jPKU3AS4s -> vload3(uint, const __generic short *){{$}}
+; CHECK-NEXT: _Z6vload4jPKU3AS1f -> vload4(uint, const __global float *){{$}}
+; CHECK-NEXT: _Z6vload4jPU3AS1Kf -> vload4(uint, const __global float *) -> _Z6vload4jPKU3AS1f
+; CHECK-NEXT: _Z6vload8jPKU3AS2d -> vload8(uint, const __constant double *){{$}}
+; CHECK-NEXT: _Z7vload16jPKh -> vload16(uint, const __private uchar *){{$}}
+; CHECK-NEXT: _Z7vstore2Dv2_cmPU3AS3c -> vstore2(char2, ulong, __local char *){{$}}
+; CHECK-NEXT: _Z7vstore3Dv3_sjPU3AS4s -> vstore3(short3, uint, __generic short *){{$}}
+; CHECK-NEXT: _Z7vstore4Dv4_fjPU3AS1f -> vstore4(float4, uint, __global float *){{$}}
+; CHECK-NEXT: _Z7vstore8Dv8_ijPi -> vstore8(int8, uint, __private int *){{$}}
+; CHECK-NEXT: _Z8vstore16Dv16_hjPU3AS1h -> vstore16(uchar16, uint, __global uchar *){{$}}
+; CHECK-NEXT: _Z10ndrange_1Djj -> ndrange_1D(uint, uint){{$}}
+; CHECK-NEXT: _Z10ndrange_1Djjj -> ndrange_1D(uint, uint, uint){{$}}
+; CHECK-NEXT: _Z10ndrange_1Dm -> ndrange_1D(ulong){{$}}
+; CHECK-NEXT: _Z10ndrange_1Dmm -> ndrange_1D(ulong, ulong){{$}}
+; CHECK-NEXT: _Z10ndrange_2DPKm -> ndrange_2D(const __private ulong *){{$}}
+; CHECK-NEXT: _Z10ndrange_2DPKmS0_ -> ndrange_2D(const __private ulong *, const __private ulong *){{$}}
+; CHECK-NEXT: _Z10ndrange_3DPKm -> ndrange_3D(const __private ulong *){{$}}
+; CHECK-NEXT: _Z12convert_int8Dv8_f -> convert_int8(float8){{$}}
+; CHECK-NEXT: _Z12convert_int8Dv8_t -> convert_int8(ushort8){{$}}
+; CHECK-NEXT: _Z12get_group_idj -> get_group_id(uint){{$}}
+; CHECK-NEXT: _Z12get_local_idj -> get_local_id(uint){{$}}
+; CHECK-NEXT: _Z12retain_event12ocl_clkevent -> retain_event(clk_event_t){{$}}
+; CHECK-NEXT: _Z13__spirv_IsNanf -> __spirv_IsNan(float){{$}}
+; CHECK-NEXT: _Z13convert_char8Dv8_i -> convert_char8(int8){{$}}
+; CHECK-NEXT: _Z13convert_uint8Dv8_d -> convert_uint8(double8){{$}}
+; CHECK-NEXT: _Z13get_global_idj -> get_global_id(uint){{$}}
+; CHECK-NEXT: _Z14__spirv_Selectbii -> __spirv_Select(bool, int, int){{$}}
+; CHECK-NEXT: _Z14convert_float8Dv8_d -> convert_float8(double8){{$}}
+; CHECK-NEXT: _Z14convert_float8Dv8_j -> convert_float8(uint8){{$}}
+; CHECK-NEXT: _Z14convert_short8Dv8_c -> convert_short8(char8){{$}}
+; CHECK-NEXT: _Z14enqueue_kernel9ocl_queue -> enqueue_kernel(queue_t){{$}}
+; CHECK-NEXT: _Z14enqueue_marker9ocl_queuejPK12ocl_clkeventP12ocl_clkevent -> enqueue_marker(queue_t, uint, const __private clk_event_t *, __private clk_event_t *){{$}}
+; CHECK-NEXT: _Z14get_local_sizej -> get_local_size(uint){{$}}
+; CHECK-NEXT: _Z14isgreaterequalff -> isgreaterequal(float, float){{$}}
+; CHECK-NEXT: _Z14work_group_alli -> work_group_all(int){{$}}
+; CHECK-NEXT: _Z14work_group_anyi -> work_group_any(int){{$}}
+; CHECK-NEXT: _Z15convert_double8Dv8_c -> convert_double8(char8){{$}}
+; CHECK-NEXT: _Z15convert_double8Dv8_f -> convert_double8(float8){{$}}
+; CHECK-NEXT: _Z15convert_double8Dv8_i -> convert_double8(int8){{$}}
+; CHECK-NEXT: _Z15convert_ushort8Dv8_c -> convert_ushort8(char8){{$}}
+; CHECK-NEXT: _Z16convert_char_satf -> convert_char_sat(float){{$}}
+; CHECK-NEXT: _Z17get_default_queuev -> get_default_queue(void){{$}}
+; CHECK-NEXT: _Z17sub_group_barrierj -> sub_group_barrier(uint){{$}}
+; CHECK-NEXT: _Z17sub_group_barrierji -> sub_group_barrier(uint, int){{$}}
+; CHECK-NEXT: _Z17wait_group_eventsiP9ocl_event -> wait_group_events(int, __private event_t *){{$}}
+; CHECK-NEXT: _Z17wait_group_eventsiPU3AS49ocl_event -> wait_group_events(int, __generic event_t *){{$}}
+; CHECK-NEXT: _Z18get_sub_group_sizev -> get_sub_group_size(void){{$}}
+; CHECK-NEXT: _Z18work_group_barrierj -> work_group_barrier(uint){{$}}
+; CHECK-NEXT: _Z18work_group_barrierji -> work_group_barrier(uint, int){{$}}
+; CHECK-NEXT: _Z19sub_group_broadcastij -> sub_group_broadcast(int, uint){{$}}
+; CHECK-NEXT: _Z20__spirv_SampledImagePU3AS1K34__spirv_Image__float_1_1_0_0_0_0_0PU3AS1K15__spirv_Sampler -> __spirv_SampledImage(const __global __spirv_Image__float_1_1_0_0_0_0_0 *, const __global __spirv_Sampler *) -> _Z20__spirv_SampledImagePKU3AS134__spirv_Image__float_1_1_0_0_0_0_0PKU3AS115__spirv_Sampler
+; CHECK-NEXT: _Z20convert_int4_sat_rteDv4_f -> convert_int4_sat_rte(float4){{$}}
+; CHECK-NEXT: _Z20sub_group_reduce_addi -> sub_group_reduce_add(int){{$}}
+; CHECK-NEXT: _Z21async_work_group_copyPU3AS1Dv2_cPKU3AS3S_j9ocl_event -> async_work_group_copy(__global char2 *, const __local char2 *, uint, event_t){{$}}
+; CHECK-NEXT: _Z21async_work_group_copyPU3AS3fPKU3AS1fj9ocl_event -> async_work_group_copy(__local float *, const __global float *, uint, event_t){{$}}
+; CHECK-NEXT: _Z22__spirv_ControlBarrieriii -> __spirv_ControlBarrier(int, int, int){{$}}
+; CHECK-NEXT: _Z22get_sub_group_local_idv -> get_sub_group_local_id(void){{$}}
+; CHECK-NEXT: _Z23intel_sub_group_shuffleDv2_fj -> intel_sub_group_shuffle(float2, uint){{$}}
+; CHECK-NEXT: _Z26intel_sub_group_shuffle_upDv2_fDv2_fj -> intel_sub_group_shuffle_up(float2, float2, uint) -> _Z26intel_sub_group_shuffle_upDv2_fS_j
+; CHECK-NEXT: _Z27intel_sub_group_shuffle_xorDv2_fj -> intel_sub_group_shuffle_xor(float2, uint){{$}}
+; CHECK-NEXT: _Z28__spirv_FOrdGreaterThanEqualff -> __spirv_FOrdGreaterThanEqual(float, float){{$}}
+; CHECK-NEXT: _Z28intel_sub_group_block_write2PU3AS1jDv2_j -> intel_sub_group_block_write2(__global uint *, uint2){{$}}
+; CHECK-NEXT: _Z28intel_sub_group_shuffle_downDv2_fDv2_fj -> intel_sub_group_shuffle_down(float2, float2, uint) -> _Z28intel_sub_group_shuffle_downDv2_fS_j
+; CHECK-NEXT: _Z29async_work_group_strided_copyPU3AS1Dv2_hPKU3AS3S_jj9ocl_event -> async_work_group_strided_copy(__global uchar2 *, const __local uchar2 *, uint, uint, event_t){{$}}
+; CHECK-NEXT: _Z30intel_sub_group_block_read_us2PKU3AS1t -> intel_sub_group_block_read_us2(const __global ushort *){{$}}
+; CHECK-NEXT: _Z31intel_sub_group_block_write_us2PU3AS1tDv2_t -> intel_sub_group_block_write_us2(__global ushort *, ushort2){{$}}
+; CHECK-NEXT: _Z38__spirv_CreatePipeFromPipeStorage_readPU3AS119__spirv_PipeStorage -> __spirv_CreatePipeFromPipeStorage_read(__global __spirv_PipeStorage *){{$}}
+; CHECK-NEXT: _Z38__spirv_CreatePipeFromPipeStorage_readPU3AS1K19__spirv_PipeStorage -> __spirv_CreatePipeFromPipeStorage_read(const __global __spirv_PipeStorage *) -> _Z38__spirv_CreatePipeFromPipeStorage_readPKU3AS119__spirv_PipeStorage
+; CHECK-NEXT: _Z38__spirv_ImageSampleExplicitLod_Rfloat4PU3AS120__spirv_SampledImageDv4_iif -> __spirv_ImageSampleExplicitLod_Rfloat4(__global __spirv_SampledImage *, int4, int, float){{$}}
+; CHECK-NEXT: _Z39__spirv_CreatePipeFromPipeStorage_writePU3AS119__spirv_PipeStorage -> __spirv_CreatePipeFromPipeStorage_write(__global __spirv_PipeStorage *){{$}}
+; CHECK-NEXT: _Z39__spirv_CreatePipeFromPipeStorage_writePU3AS1K19__spirv_PipeStorage -> __spirv_CreatePipeFromPipeStorage_write(const __global __spirv_PipeStorage *) -> _Z39__spirv_CreatePipeFromPipeStorage_writePKU3AS119__spirv_PipeStorage
+; CHECK-NEXT: _Z3absi -> abs(int){{$}}
+; CHECK-NEXT: _Z3allDv2_i -> all(int2){{$}}
+; CHECK-NEXT: _Z3allDv2_l -> all(long2){{$}}
+; CHECK-NEXT: _Z3anyDv2_i -> any(int2){{$}}
+; CHECK-NEXT: _Z3anyDv2_l -> any(long2){{$}}
+; CHECK-NEXT: _Z3anyDv4_i -> any(int4){{$}}
+; CHECK-NEXT: _Z3cosf -> cos(float){{$}}
+; CHECK-NEXT: _Z3dotDv4_fS_ -> dot(float4, float4){{$}}
+; CHECK-NEXT: _Z3dotff -> dot(float, float){{$}}
+; CHECK-NEXT: _Z3fmafff -> fma(float, float, float){{$}}
+; CHECK-NEXT: _Z3minDv2_iS_ -> min(int2, int2){{$}}
+; CHECK-NEXT: _Z3minDv2_ii -> min(int2, int){{$}}
+; CHECK-NEXT: _Z3mixDv4_fS_f -> mix(float4, float4, float){{$}}
+; CHECK-NEXT: _Z4fabsDv4_f -> fabs(float4){{$}}
+; CHECK-NEXT: _Z4fmaxDv4_fS_ -> fmax(float4, float4){{$}}
+; CHECK-NEXT: _Z4fmodff -> fmod(float, float){{$}}
+; CHECK-NEXT: _Z4modfDv8_fPU3AS3S_ -> modf(float8, __local float8 *){{$}}
+; CHECK-NEXT: _Z4sqrtDh -> sqrt(half){{$}}
+; CHECK-NEXT: _Z4sqrtf -> sqrt(float){{$}}
+; CHECK-NEXT: _Z5clampDhDhDh -> clamp(half, half, half){{$}}
+; CHECK-NEXT: _Z5clampDv4_fS_S_ -> clamp(float4, float4, float4){{$}}
+; CHECK-NEXT: _Z5clampfff -> clamp(float, float, float){{$}}
+; CHECK-NEXT: _Z5crossDv3_fS_ -> cross(float3, float3){{$}}
+; CHECK-NEXT: _Z5fractDv4_fPU3AS1S_ -> fract(float4, __global float4 *){{$}}
+; CHECK-NEXT: _Z5frexpDv2_dPDv2_i -> frexp(double2, __private int2 *){{$}}
+; CHECK-NEXT: _Z5isinfDh -> isinf(half){{$}}
+; CHECK-NEXT: _Z5isinfDv2_Dh -> isinf(half2){{$}}
+; CHECK-NEXT: _Z5isinfDv2_d -> isinf(double2){{$}}
+; CHECK-NEXT: _Z5isinfDv2_f -> isinf(float2){{$}}
+; CHECK-NEXT: _Z5isinff -> isinf(float){{$}}
+; CHECK-NEXT: _Z5isnanDh -> isnan(half){{$}}
+; CHECK-NEXT: _Z5isnanDv2_Dh -> isnan(half2){{$}}
+; CHECK-NEXT: _Z5isnanDv2_d -> isnan(double2){{$}}
+; CHECK-NEXT: _Z5isnanDv2_f -> isnan(float2){{$}}
+; CHECK-NEXT: _Z5isnanf -> isnan(float){{$}}
+; CHECK-NEXT: _Z6remquoffPi -> remquo(float, float, __private int *){{$}}
+; CHECK-NEXT: _Z6selectDv4_iS_S_ -> select(int4, int4, int4){{$}}
+; CHECK-NEXT: _Z6sincosfPf -> sincos(float, __private float *){{$}}
+; CHECK-NEXT: _Z7barrierj -> barrier(uint){{$}}
+; CHECK-NEXT: _Z7isequalDv8_fDv8_f -> isequal(float8, float8) -> _Z7isequalDv8_fS_
+; CHECK-NEXT: _Z7shuffleDv4_fDv4_j -> shuffle(float4, uint4){{$}}
+; CHECK-NEXT: _Z7signbitDh -> signbit(half){{$}}
+; CHECK-NEXT: _Z7signbitf -> signbit(float){{$}}
+; CHECK-NEXT: _Z8copysigndd -> copysign(double, double){{$}}
+; CHECK-NEXT: _Z8isfiniteDh -> isfinite(half){{$}}
+; CHECK-NEXT: _Z8isfiniteDv2_Dh -> isfinite(half2){{$}}
+; CHECK-NEXT: _Z8isfiniteDv2_d -> isfinite(double2){{$}}
+; CHECK-NEXT: _Z8isfiniteDv2_f -> isfinite(float2){{$}}
+; CHECK-NEXT: _Z8isfinitef -> isfinite(float){{$}}
+; CHECK-NEXT: _Z8isnormalDh -> isnormal(half){{$}}
+; CHECK-NEXT: _Z8isnormalDv2_Dh -> isnormal(half2){{$}}
+; CHECK-NEXT: _Z8isnormalDv2_d -> isnormal(double2){{$}}
+; CHECK-NEXT: _Z8isnormalDv2_f -> isnormal(float2){{$}}
+; CHECK-NEXT: _Z8isnormalf -> isnormal(float){{$}}
+; CHECK-NEXT: _Z8shuffle2Dv8_iS_Dv8_j -> shuffle2(int8, int8, uint8){{$}}
+; CHECK-NEXT: _Z9bitselectDv2_fS_S_ -> bitselect(float2, float2, float2){{$}}
+; CHECK-NEXT: _Z9get_fencePKU3AS4v -> get_fence(const __generic void *){{$}}
+; CHECK-NEXT: _Z9get_fencePU3AS4v -> get_fence(__generic void *){{$}}
+; CHECK-NEXT: _Z9mem_fencej -> mem_fence(uint){{$}}
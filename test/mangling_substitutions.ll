@@ -0,0 +1,58 @@
+; Check that builtins whose mangled names contain substitutions are mangled
+; the same way after the round trip.
+
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+; RUN: llvm-spirv -r -spirv-mangle-cache-size=0 %t.spv -o %t.nocache.bc
+; RUN: llvm-dis < %t.nocache.bc | FileCheck %s --check-prefix=CHECK-LLVM
+
+; CHECK-LLVM: call spir_func <2 x i32> @_Z3minDv2_iS_(
+; CHECK-LLVM: call spir_func <4 x float> @_Z4fmaxDv4_fS_(
+; CHECK-LLVM: call spir_func <4 x float> @_Z5clampDv4_fS_S_(
+; CHECK-LLVM: call spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(
+
+target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @test(<4 x float> addrspace(1)* %p, <4 x float> %a, <4 x float> %b) #0 {
+entry:
+  %call = tail call spir_func <2 x i32> @_Z3minDv2_iS_(<2 x i32> <i32 1, i32 10>, <2 x i32> <i32 5, i32 5>) #2
+  %call1 = tail call spir_func <4 x float> @_Z4fmaxDv4_fS_(<4 x float> %a, <4 x float> %b) #2
+  %call2 = tail call spir_func <4 x float> @_Z5clampDv4_fS_S_(<4 x float> %call1, <4 x float> %a, <4 x float> %b) #2
+  %call3 = tail call spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(<4 x float> %call2, <4 x float> addrspace(1)* %p) #2
+  store <4 x float> %call3, <4 x float> addrspace(1)* %p, align 16
+  ret void
+}
+
+declare spir_func <2 x i32> @_Z3minDv2_iS_(<2 x i32>, <2 x i32>) #1
+
+declare spir_func <4 x float> @_Z4fmaxDv4_fS_(<4 x float>, <4 x float>) #1
+
+declare spir_func <4 x float> @_Z5clampDv4_fS_S_(<4 x float>, <4 x float>, <4 x float>) #1
+
+declare spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(<4 x float>, <4 x float> addrspace(1)*) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind readnone }
+attributes #2 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!7}
+!opencl.used.extensions = !{!8}
+!opencl.used.optional.core.features = !{!8}
+!opencl.compiler.options = !{!8}
+
+!0 = !{void (<4 x float> addrspace(1)*, <4 x float>, <4 x float>)* @test, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1, i32 0, i32 0}
+!2 = !{!"kernel_arg_access_qual", !"none", !"none", !"none"}
+!3 = !{!"kernel_arg_type", !"float4*", !"float4", !"float4"}
+!4 = !{!"kernel_arg_base_type", !"float4*", !"float4", !"float4"}
+!5 = !{!"kernel_arg_type_qual", !"", !"", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{i32 2, i32 0}
+!8 = !{}
@@ -0,0 +1,18 @@
+; Check the benchmark of the translation to LLVM of a module with many forward
+; references: each loop header has phis of values defined in its latch.
+; RUN: llvm-spirv-bench -in-process -forward-ref-loops=3 -requests=2 -o %t.bc | FileCheck %s --check-prefix=CHECK-BENCH
+; RUN: llvm-dis < %t.bc | FileCheck %s
+
+; CHECK-BENCH: requests: 2
+; CHECK-BENCH-NEXT: errors: 0
+
+; CHECK-NOT: placeholder
+; CHECK: define spir_func void @forward_refs
+; CHECK: %i = phi i32 [ 0, %{{[0-9a-z.]+}} ], [ %[[INC:[0-9a-z.]+]], %[[LATCH:[0-9a-z.]+]] ]
+; CHECK: %acc = phi i32 [ 0, %{{[0-9a-z.]+}} ], [ %[[SUM:[0-9a-z.]+]], %[[LATCH]] ]
+; CHECK: %[[SUM]] = add i32 %acc,
+; CHECK: %[[INC]] = add i32 %i, 1
+; CHECK: %i{{[0-9]+}} = phi i32
+; CHECK: %i{{[0-9]+}} = phi i32
+; CHECK-NOT: %i{{[0-9]+}} = phi i32
+; CHECK-NOT: placeholder
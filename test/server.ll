@@ -0,0 +1,51 @@
+; UNSUPPORTED: system-windows
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv-bench -spawn=llvm-spirv -requests=20 -concurrency=4 -warmup=2 %t.bc %t.spv | FileCheck %s
+; RUN: llvm-spirv-bench -spawn=llvm-spirv -socket=%t.sock -requests=20 -concurrency=4 %t.bc %t.spv | FileCheck %s
+; RUN: not llvm-spirv-bench -spawn=llvm-spirv -requests=1 %s 2>&1 | FileCheck %s --check-prefix=CHECK-ERR
+
+; CHECK: requests: 20
+; CHECK-NEXT: errors: 0
+; CHECK-NEXT: throughput:
+; CHECK-NEXT: latency min:
+; CHECK-NEXT: latency p50:
+; CHECK-NEXT: latency p90:
+; CHECK-NEXT: latency p99:
+; CHECK-NEXT: latency max:
+; CHECK-NEXT: mangle cache hits: {{[0-9]+}}
+; CHECK-NEXT: mangle cache misses: {{[0-9]+}}
+
+; CHECK-ERR: errors: 1
+; CHECK-ERR: First error: Fails to load bitcode
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %0 = load i32, i32 addrspace(1)* %a, align 4
+  %add = add i32 %0, 1
+  store i32 %add, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
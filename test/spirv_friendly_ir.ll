@@ -0,0 +1,57 @@
+; Check that SPIR-V builtins are kept in SPIR-V friendly IR.
+; RUN: llvm-as < %s > %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r -spirv-friendly-ir %t.spv -o - | llvm-dis | FileCheck %s
+; RUN: llvm-spirv -r -spirv-friendly-ir %t.spv -o %t.rev.bc
+; RUN: llvm-spirv %t.rev.bc -spirv-text -o - | FileCheck %s --check-prefix=CHECK-SPIRV
+
+; CHECK: @__spirv_BuiltInGlobalInvocationId
+; CHECK-NOT: get_global_id
+; CHECK: call {{.*}}@_Z22__spirv_ControlBarrieriii(
+; CHECK-NOT: @_Z7barrierj
+; CHECK: call {{.*}}i1 @_Z13__spirv_IsNanf(
+; CHECK-NOT: @_Z5isnanf
+
+; CHECK-SPIRV: Decorate {{[0-9]+}} BuiltIn 28
+; CHECK-SPIRV: ControlBarrier
+; CHECK-SPIRV: IsNan
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @test(i32 addrspace(1)* %a, float %x) #0 {
+entry:
+  %call = call spir_func i64 @_Z13get_global_idj(i32 0) #1
+  call spir_func void @_Z7barrierj(i32 1) #0
+  %call1 = call spir_func i32 @_Z5isnanf(float %x) #1
+  %arrayidx = getelementptr inbounds i32, i32 addrspace(1)* %a, i64 %call
+  store i32 %call1, i32 addrspace(1)* %arrayidx, align 4
+  ret void
+}
+
+declare spir_func i64 @_Z13get_global_idj(i32) #1
+
+declare spir_func void @_Z7barrierj(i32) #0
+
+declare spir_func i32 @_Z5isnanf(float) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind readnone }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*, float)* @test, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1, i32 0}
+!2 = !{!"kernel_arg_access_qual", !"none", !"none"}
+!3 = !{!"kernel_arg_type", !"int*", !"float"}
+!4 = !{!"kernel_arg_base_type", !"int*", !"float"}
+!5 = !{!"kernel_arg_type_qual", !"", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
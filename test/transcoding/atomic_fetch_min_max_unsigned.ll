@@ -0,0 +1,65 @@
+; Check that C++11 atomic_fetch_min/max on unsigned atomic types are
+; translated to the unsigned SPIR-V instructions, and the signed ones to the
+; signed instructions.
+
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o %t.txt
+; RUN: FileCheck < %t.txt %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+
+; CHECK-SPIRV: AtomicUMin
+; CHECK-SPIRV: AtomicUMax
+; CHECK-SPIRV: AtomicSMin
+; CHECK-SPIRV: AtomicSMax
+
+; CHECK-LLVM: call spir_func i32 @_Z25atomic_fetch_min_explicitPVU3AS4U7_Atomicjjii(
+; CHECK-LLVM: call spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjjii(
+; CHECK-LLVM: call spir_func i32 @_Z25atomic_fetch_min_explicitPVU3AS4U7_Atomiciiii(
+; CHECK-LLVM: call spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomiciiii(
+
+target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @test(i32 addrspace(1)* %uobject, i32 addrspace(1)* %object, i32 %val) #0 {
+entry:
+  %0 = addrspacecast i32 addrspace(1)* %uobject to i32 addrspace(4)*
+  %1 = addrspacecast i32 addrspace(1)* %object to i32 addrspace(4)*
+  %call = tail call spir_func i32 @_Z16atomic_fetch_minPVU3AS4U7_Atomicjj(i32 addrspace(4)* %0, i32 %val) #2
+  %call1 = tail call spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjj12memory_order(i32 addrspace(4)* %0, i32 %val, i32 0) #2
+  %call2 = tail call spir_func i32 @_Z16atomic_fetch_minPVU3AS4U7_Atomicii(i32 addrspace(4)* %1, i32 %val) #2
+  %call3 = tail call spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicii12memory_order(i32 addrspace(4)* %1, i32 %val, i32 0) #2
+  ret void
+}
+
+declare spir_func i32 @_Z16atomic_fetch_minPVU3AS4U7_Atomicjj(i32 addrspace(4)*, i32) #1
+
+declare spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicjj12memory_order(i32 addrspace(4)*, i32, i32) #1
+
+declare spir_func i32 @_Z16atomic_fetch_minPVU3AS4U7_Atomicii(i32 addrspace(4)*, i32) #1
+
+declare spir_func i32 @_Z25atomic_fetch_max_explicitPVU3AS4U7_Atomicii12memory_order(i32 addrspace(4)*, i32, i32) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!7}
+!opencl.used.extensions = !{!8}
+!opencl.used.optional.core.features = !{!8}
+!opencl.compiler.options = !{!8}
+
+!0 = !{void (i32 addrspace(1)*, i32 addrspace(1)*, i32)* @test, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1, i32 1, i32 0}
+!2 = !{!"kernel_arg_access_qual", !"none", !"none", !"none"}
+!3 = !{!"kernel_arg_type", !"atomic_uint*", !"atomic_int*", !"int"}
+!4 = !{!"kernel_arg_base_type", !"_Atomic(uint)*", !"_Atomic(int)*", !"int"}
+!5 = !{!"kernel_arg_type_qual", !"volatile", !"volatile", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{i32 2, i32 0}
+!8 = !{}
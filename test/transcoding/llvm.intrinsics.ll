@@ -0,0 +1,93 @@
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o %t.txt
+; RUN: FileCheck < %t.txt %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+; RUN: llvm-spirv -r -spirv-ext-inst-to-intrinsics %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM-INTRINSICS
+
+; The is_zero_undef flags of ctlz and cttz are not translated.
+; CHECK-SPIRV-NOT: TypeBool
+; CHECK-SPIRV-NOT: Constant{{True|False}}
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} sqrt
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} fabs
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} fma
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} fmin
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} fmax
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} pow
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} copysign
+; CHECK-SPIRV: ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} popcount
+; CHECK-SPIRV: 6 ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} clz {{[0-9]+}}
+; CHECK-SPIRV: 6 ExtInst {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} ctz {{[0-9]+}}
+; CHECK-SPIRV: ShiftLeftLogical
+; CHECK-SPIRV: BitwiseAnd
+; CHECK-SPIRV: ShiftRightLogical
+; CHECK-SPIRV: BitwiseOr
+
+; CHECK-LLVM: call spir_func float @_Z4sqrtf(
+; CHECK-LLVM: call spir_func <4 x float> @_Z4fabsDv4_f(
+; CHECK-LLVM: call spir_func float @_Z3fmafff(
+
+; CHECK-LLVM-INTRINSICS: call float @llvm.sqrt.f32(
+; CHECK-LLVM-INTRINSICS: call <4 x float> @llvm.fabs.v4f32(
+; CHECK-LLVM-INTRINSICS: call float @llvm.fma.f32(
+; CHECK-LLVM-INTRINSICS: call float @llvm.minnum.f32(
+; CHECK-LLVM-INTRINSICS: call float @llvm.maxnum.f32(
+; CHECK-LLVM-INTRINSICS: call float @llvm.pow.f32(
+; CHECK-LLVM-INTRINSICS: call float @llvm.copysign.f32(
+; CHECK-LLVM-INTRINSICS: call i32 @llvm.ctpop.i32(
+; CHECK-LLVM-INTRINSICS: call i32 @llvm.ctlz.i32(i32 %{{[0-9a-z.]+}}, i1 false)
+; CHECK-LLVM-INTRINSICS: call i32 @llvm.cttz.i32(i32 %{{[0-9a-z.]+}}, i1 false)
+
+target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @test(float addrspace(1)* %f, <4 x float> addrspace(1)* %v, i32 addrspace(1)* %i) #0 {
+entry:
+  %0 = load float, float addrspace(1)* %f, align 4
+  %1 = load <4 x float>, <4 x float> addrspace(1)* %v, align 16
+  %2 = load i32, i32 addrspace(1)* %i, align 4
+  %sqrt = call float @llvm.sqrt.f32(float %0)
+  %fabs = call <4 x float> @llvm.fabs.v4f32(<4 x float> %1)
+  %fma = call float @llvm.fma.f32(float %0, float %sqrt, float %0)
+  %min = call float @llvm.minnum.f32(float %fma, float %0)
+  %max = call float @llvm.maxnum.f32(float %min, float %0)
+  %pow = call float @llvm.pow.f32(float %max, float %0)
+  %copysign = call float @llvm.copysign.f32(float %pow, float %0)
+  store float %copysign, float addrspace(1)* %f, align 4
+  store <4 x float> %fabs, <4 x float> addrspace(1)* %v, align 16
+  %ctpop = call i32 @llvm.ctpop.i32(i32 %2)
+  %ctlz = call i32 @llvm.ctlz.i32(i32 %ctpop, i1 false)
+  %cttz = call i32 @llvm.cttz.i32(i32 %ctlz, i1 true)
+  %bswap = call i32 @llvm.bswap.i32(i32 %cttz)
+  store i32 %bswap, i32 addrspace(1)* %i, align 4
+  ret void
+}
+
+declare float @llvm.sqrt.f32(float) #1
+declare <4 x float> @llvm.fabs.v4f32(<4 x float>) #1
+declare float @llvm.fma.f32(float, float, float) #1
+declare float @llvm.minnum.f32(float, float) #1
+declare float @llvm.maxnum.f32(float, float) #1
+declare float @llvm.pow.f32(float, float) #1
+declare float @llvm.copysign.f32(float, float) #1
+declare i32 @llvm.ctpop.i32(i32) #1
+declare i32 @llvm.ctlz.i32(i32, i1) #1
+declare i32 @llvm.cttz.i32(i32, i1) #1
+declare i32 @llvm.bswap.i32(i32) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind readnone }
+
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!0}
+!opencl.ocl.version = !{!1}
+!opencl.used.extensions = !{!2}
+!opencl.used.optional.core.features = !{!2}
+!opencl.compiler.options = !{!2}
+
+!0 = !{i32 1, i32 2}
+!1 = !{i32 2, i32 0}
+!2 = !{}
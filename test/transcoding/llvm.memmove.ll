@@ -6,29 +6,42 @@
 ; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
 
 ; CHECK-SPIRV-NOT: llvm.memmove
+; CHECK-SPIRV-NOT: Variable {{[0-9]+}} {{[0-9]+}} 7
 
-; CHECK-SPIRV: Variable {{[0-9]+}} [[mem:[0-9]+]] 7
+; The source and destination may overlap, so they are compared to choose
+; the direction of the copy loop.
+; CHECK-SPIRV: Function
+; CHECK-SPIRV: ConvertPtrToU
+; CHECK-SPIRV: ConvertPtrToU
+; CHECK-SPIRV: ULessThanEqual
+; CHECK-SPIRV: SelectionMerge
+; CHECK-SPIRV: LoopMerge
+; CHECK-SPIRV: Load [[Vec:[0-9]+]]
+; CHECK-SPIRV: Store
+; CHECK-SPIRV: LoopMerge
+; CHECK-SPIRV: Load [[Vec]]
+; CHECK-SPIRV: Store
+; CHECK-SPIRV-NOT: CopyMemorySized
+; CHECK-SPIRV: FunctionEnd
 
-; CHECK-SPIRV: LifetimeStart [[mem]] [[size:[0-9]+]]
-; CHECK-SPIRV: Bitcast [[i8Ty:[0-9]+]] [[tmp1:[0-9]+]] [[mem]]
-; CHECK-SPIRV: CopyMemorySized [[tmp1]] {{[0-9]+}} {{[0-9]+}}
-; CHECK-SPIRV: Bitcast [[i8Ty]] [[tmp2:[0-9]+]] [[mem]]
-; CHECK-SPIRV: CopyMemorySized {{[0-9]+}} [[tmp2]] {{[0-9]+}}
-; CHECK-SPIRV: LifetimeStop [[mem]] [[size]]
+; The source and destination are in different address spaces.
+; CHECK-SPIRV: Function
+; CHECK-SPIRV-NOT: LoopMerge
+; CHECK-SPIRV: CopyMemorySized {{[0-9]+}} {{[0-9]+}} {{[0-9]+}}
+; CHECK-SPIRV: FunctionEnd
 
 ; CHECK-LLVM-NOT: llvm.memmove
+; CHECK-LLVM-NOT: alloca
 
-; CHECK-LLVM: [[local:%[0-9]+]] = alloca %struct.SomeStruct
-; CHECK-LLVM: [[tmp1:%[0-9]+]] = bitcast %struct.SomeStruct* [[local]] to [[type:i[0-9]+\*]]
-; CHECK-LLVM: call void @llvm.lifetime.start({{i[0-9]+}} {{-?[0-9]+}}, [[type]] [[tmp1]])
-; CHECK-LLVM: [[tmp2:%[0-9]+]] = bitcast %struct.SomeStruct* [[local]] to [[type]]
-; CHECK-LLVM: call void @llvm.memcpy
-; CHECK-LLVM:  ([[type]] [[tmp2]],
-; CHECK-LLVM:  {{i[0-9]+}} [[size:[0-9]+]]
-; CHECK-LLVM: [[tmp3:%[0-9]+]] = bitcast %struct.SomeStruct* [[local]] to [[type]]
+; CHECK-LLVM: define spir_kernel void @test_struct
+; CHECK-LLVM: icmp ule i32
+; CHECK-LLVM: load <16 x i8>
+; CHECK-LLVM: store <16 x i8>
+; CHECK-LLVM: load <16 x i8>
+; CHECK-LLVM: store <16 x i8>
+
+; CHECK-LLVM: define spir_func void @test_local
 ; CHECK-LLVM: call void @llvm.memcpy
-; CHECK-LLVM:  , [[type]] [[tmp3]], {{i[0-9]+}} [[size]]
-; CHECK-LLVM: call void @llvm.lifetime.end({{i[0-9]+}} {{-?[0-9]+}}, [[type]] [[tmp1]])
 
 target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024-n8:16:32:64"
 target triple = "spir-unknown-unknown"
@@ -43,9 +56,20 @@ define spir_kernel void @test_struct(%struct.SomeStruct addrspace(1)* nocapture
   ret void
 }
 
+; Function Attrs: nounwind
+define spir_func void @test_local(%struct.SomeStruct addrspace(3)* nocapture readonly %in, %struct.SomeStruct addrspace(1)* nocapture %out) #0 {
+  %1 = bitcast %struct.SomeStruct addrspace(3)* %in to i8 addrspace(3)*
+  %2 = bitcast %struct.SomeStruct addrspace(1)* %out to i8 addrspace(1)*
+  call void @llvm.memmove.p1i8.p3i8.i32(i8 addrspace(1)* %2, i8 addrspace(3)* %1, i32 128, i32 64, i1 false)
+  ret void
+}
+
 ; Function Attrs: nounwind
 declare void @llvm.memmove.p1i8.p1i8.i32(i8 addrspace(1)* nocapture, i8 addrspace(1)* nocapture readonly, i32, i32, i1) #1
 
+; Function Attrs: nounwind
+declare void @llvm.memmove.p1i8.p3i8.i32(i8 addrspace(1)* nocapture, i8 addrspace(3)* nocapture readonly, i32, i32, i1) #1
+
 attributes #0 = { nounwind "less-precise-fpmad"="false" "no-frame-pointer-elim"="false" "no-infs-fp-math"="false" "no-nans-fp-math"="false" "no-realign-stack" "stack-protector-buffer-size"="8" "unsafe-fp-math"="false" "use-soft-float"="false" }
 attributes #1 = { nounwind }
 
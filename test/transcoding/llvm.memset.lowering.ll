@@ -0,0 +1,84 @@
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o %t.spt
+; RUN: FileCheck < %t.spt %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+; RUN: llvm-spirv %t.bc -spirv-memset-zero-pool-max-size=16 -spirv-text -o - | FileCheck %s --check-prefix=CHECK-SMALL-POOL
+
+; Both memsets of zero copy from a single zero-initialized constant as long
+; as the longest of them.
+; CHECK-SPIRV-DAG: Constant {{[0-9]+}} [[Len12:[0-9]+]] 12
+; CHECK-SPIRV-DAG: Constant {{[0-9]+}} [[Len32:[0-9]+]] 32
+; CHECK-SPIRV: TypeArray [[Int8x32:[0-9]+]] {{[0-9]+}} [[Len32]]
+; CHECK-SPIRV-NOT: TypeArray
+; CHECK-SPIRV: ConstantNull [[Int8x32]] [[Init:[0-9]+]]
+; CHECK-SPIRV: Variable {{[0-9]+}} [[Pool:[0-9]+]] 0 [[Init]]
+; CHECK-SPIRV-NOT: Variable {{[0-9]+}} {{[0-9]+}} 0
+
+; CHECK-SPIRV: Function
+; CHECK-SPIRV: Bitcast {{[0-9]+}} [[Source1:[0-9]+]] [[Pool]]
+; CHECK-SPIRV: CopyMemorySized {{[0-9]+}} [[Source1]] [[Len12]] 2 4
+; CHECK-SPIRV: Bitcast {{[0-9]+}} [[Source2:[0-9]+]] [[Pool]]
+; CHECK-SPIRV: CopyMemorySized {{[0-9]+}} [[Source2]] [[Len32]] 2 16
+
+; Memsets of a non-zero or variable value and of a variable length are
+; lowered to stores.
+; CHECK-SPIRV: Function
+; CHECK-SPIRV-NOT: CopyMemorySized
+; CHECK-SPIRV: LoopMerge
+; CHECK-SPIRV: Store
+; CHECK-SPIRV: FunctionEnd
+
+; CHECK-LLVM: call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %{{[0-9a-z.]+}}, i8 0, i32 12, i32 4, i1 false)
+; CHECK-LLVM: call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %{{[0-9a-z.]+}}, i8 0, i32 32, i32 16, i1 false)
+; CHECK-LLVM: define spir_kernel void @fill
+; CHECK-LLVM-NOT: call void @llvm.memset
+; CHECK-LLVM: store <16 x i8>
+; CHECK-LLVM: store i8
+
+; The memset of 32 bytes is longer than the zero pool and is lowered to two
+; stores of 16 bytes.
+; CHECK-SMALL-POOL: Constant {{[0-9]+}} [[Len12:[0-9]+]] 12
+; CHECK-SMALL-POOL: TypeArray {{[0-9]+}} {{[0-9]+}} [[Len12]]
+; CHECK-SMALL-POOL: Function
+; CHECK-SMALL-POOL: CopyMemorySized
+; CHECK-SMALL-POOL-NOT: CopyMemorySized
+; CHECK-SMALL-POOL: Store
+; CHECK-SMALL-POOL: Store
+; CHECK-SMALL-POOL: FunctionEnd
+
+target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024-n8:16:32:64"
+target triple = "spir"
+
+; Function Attrs: nounwind
+define spir_kernel void @zero(i8 addrspace(1)* %a, i8 addrspace(1)* %b) #0 {
+entry:
+  call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %a, i8 0, i32 12, i32 4, i1 false)
+  call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %b, i8 0, i32 32, i32 16, i1 false)
+  ret void
+}
+
+; Function Attrs: nounwind
+define spir_kernel void @fill(i8 addrspace(1)* %a, i8 %v, i32 %n) #0 {
+entry:
+  call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %a, i8 1, i32 256, i32 16, i1 false)
+  call void @llvm.memset.p1i8.i32(i8 addrspace(1)* %a, i8 %v, i32 %n, i32 16, i1 false)
+  ret void
+}
+
+; Function Attrs: nounwind
+declare void @llvm.memset.p1i8.i32(i8 addrspace(1)* nocapture, i8, i32, i32, i1) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!0}
+!opencl.ocl.version = !{!0}
+!opencl.used.extensions = !{!1}
+!opencl.used.optional.core.features = !{!1}
+!opencl.compiler.options = !{!1}
+
+!0 = !{i32 1, i32 2}
+!1 = !{}
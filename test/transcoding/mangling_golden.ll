@@ -0,0 +1,79 @@
+; Golden mangled names for builtins whose signatures exercise the mangler's
+; substitution table: atomics, qualified and address-space pointers, vectors
+; and image/sampler arguments. The reader re-mangles every call below, so any
+; change in substitution numbering shows up as a different name. Block
+; signatures are pinned by device_execution_multiple_blocks.ll.
+
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+; RUN: llvm-spirv -r -spirv-mangle-cache-size=0 %t.spv -o %t.nocache.bc
+; RUN: llvm-dis < %t.nocache.bc | FileCheck %s --check-prefix=CHECK-LLVM
+
+; CHECK-LLVM-DAG: call spir_func void @_Z21atomic_store_explicitPVU3AS4U7_Atomiciiii(
+; CHECK-LLVM-DAG: call spir_func i1 @_Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPiiiii(
+; CHECK-LLVM-DAG: call spir_func i1 @_Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPiiiii(
+; CHECK-LLVM-DAG: call spir_func %opencl.event_t{{.*}}* @_Z29async_work_group_strided_copyPU3AS1Dv2_hPKU3AS3S_jj9ocl_event(
+; CHECK-LLVM-DAG: call spir_func <4 x float> @_Z11read_imagef11ocl_image2d11ocl_samplerDv2_fS_S_(
+; CHECK-LLVM-DAG: call spir_func <4 x float> @_Z5clampDv4_fS_S_(
+; CHECK-LLVM-DAG: call spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(
+
+target datalayout = "e-p:32:32-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir-unknown-unknown"
+
+%opencl.event_t = type opaque
+%opencl.image2d_t = type opaque
+
+; Function Attrs: nounwind
+define spir_kernel void @test(i32 addrspace(1)* %object, i32 addrspace(1)* %expected, i32 %desired, <2 x i8> addrspace(1)* %dst, <2 x i8> addrspace(3)* %src, %opencl.image2d_t addrspace(1)* %image, i32 %sampler, <2 x float> %coord, <4 x float> addrspace(1)* %res, <4 x float> %a, <4 x float> %b) #0 {
+entry:
+  %0 = addrspacecast i32 addrspace(1)* %object to i32 addrspace(4)*
+  %1 = addrspacecast i32 addrspace(1)* %expected to i32 addrspace(4)*
+  tail call spir_func void @_Z21atomic_store_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope(i32 addrspace(4)* %0, i32 %desired, i32 3, i32 2) #2
+  %call = tail call spir_func zeroext i1 @_Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope(i32 addrspace(4)* %0, i32 addrspace(4)* %1, i32 %desired, i32 3, i32 0, i32 1) #2
+  %call1 = tail call spir_func zeroext i1 @_Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_(i32 addrspace(4)* %0, i32 addrspace(4)* %1, i32 %desired, i32 2, i32 0) #2
+  %call2 = tail call spir_func %opencl.event_t* @_Z21async_work_group_copyPU3AS1Dv2_cPKU3AS3S_j9ocl_event(<2 x i8> addrspace(1)* %dst, <2 x i8> addrspace(3)* %src, i32 16, %opencl.event_t* null) #2
+  %call3 = tail call spir_func <4 x float> @_Z11read_imagef11ocl_image2d11ocl_samplerDv2_fDv2_fDv2_f(%opencl.image2d_t addrspace(1)* %image, i32 %sampler, <2 x float> %coord, <2 x float> %coord, <2 x float> %coord) #2
+  %call4 = tail call spir_func <4 x float> @_Z5clampDv4_fS_S_(<4 x float> %call3, <4 x float> %a, <4 x float> %b) #2
+  %call5 = tail call spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(<4 x float> %call4, <4 x float> addrspace(1)* %res) #2
+  store <4 x float> %call5, <4 x float> addrspace(1)* %res, align 16
+  ret void
+}
+
+declare spir_func void @_Z21atomic_store_explicitPVU3AS4U7_Atomicii12memory_order12memory_scope(i32 addrspace(4)*, i32, i32, i32) #1
+
+declare spir_func zeroext i1 @_Z39atomic_compare_exchange_strong_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_12memory_scope(i32 addrspace(4)*, i32 addrspace(4)*, i32, i32, i32, i32) #1
+
+declare spir_func zeroext i1 @_Z37atomic_compare_exchange_weak_explicitPVU3AS4U7_AtomiciPU3AS4ii12memory_orderS4_(i32 addrspace(4)*, i32 addrspace(4)*, i32, i32, i32) #1
+
+declare spir_func %opencl.event_t* @_Z21async_work_group_copyPU3AS1Dv2_cPKU3AS3S_j9ocl_event(<2 x i8> addrspace(1)*, <2 x i8> addrspace(3)*, i32, %opencl.event_t*) #1
+
+declare spir_func <4 x float> @_Z11read_imagef11ocl_image2d11ocl_samplerDv2_fDv2_fDv2_f(%opencl.image2d_t addrspace(1)*, i32, <2 x float>, <2 x float>, <2 x float>) #1
+
+declare spir_func <4 x float> @_Z5clampDv4_fS_S_(<4 x float>, <4 x float>, <4 x float>) #1
+
+declare spir_func <4 x float> @_Z5fractDv4_fPU3AS1S_(<4 x float>, <4 x float> addrspace(1)*) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind readnone }
+attributes #2 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!7}
+!opencl.used.extensions = !{!8}
+!opencl.used.optional.core.features = !{!9}
+!opencl.compiler.options = !{!8}
+
+!0 = !{void (i32 addrspace(1)*, i32 addrspace(1)*, i32, <2 x i8> addrspace(1)*, <2 x i8> addrspace(3)*, %opencl.image2d_t addrspace(1)*, i32, <2 x float>, <4 x float> addrspace(1)*, <4 x float>, <4 x float>)* @test, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1, i32 1, i32 0, i32 1, i32 3, i32 1, i32 0, i32 0, i32 1, i32 0, i32 0}
+!2 = !{!"kernel_arg_access_qual", !"none", !"none", !"none", !"none", !"none", !"read_only", !"none", !"none", !"none", !"none", !"none"}
+!3 = !{!"kernel_arg_type", !"atomic_int*", !"int*", !"int", !"char2*", !"char2*", !"image2d_t", !"sampler_t", !"float2", !"float4*", !"float4", !"float4"}
+!4 = !{!"kernel_arg_base_type", !"_Atomic(int)*", !"int*", !"int", !"char2*", !"char2*", !"image2d_t", !"sampler_t", !"float2", !"float4*", !"float4", !"float4"}
+!5 = !{!"kernel_arg_type_qual", !"volatile", !"", !"", !"", !"", !"", !"", !"", !"", !"", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{i32 2, i32 0}
+!8 = !{}
+!9 = !{!"cl_images"}
@@ -0,0 +1,68 @@
+; Check that read_image calls are lowered according to their parameter types
+; when the image types are spelled with access qualifiers, as clang does for
+; OpenCL 2.0: with a sampler, from an MSAA image, and from a plain image.
+
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-text -o %t.txt
+; RUN: FileCheck < %t.txt %s --check-prefix=CHECK-SPIRV
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv -r %t.spv -o %t.rev.bc
+; RUN: llvm-dis < %t.rev.bc | FileCheck %s --check-prefix=CHECK-LLVM
+
+; CHECK-SPIRV: SampledImage
+; CHECK-SPIRV: ImageSampleExplicitLod
+; CHECK-SPIRV: 7 ImageRead {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} {{[0-9]+}} 64 {{[0-9]+}}
+; CHECK-SPIRV: 5 ImageRead
+
+; CHECK-LLVM: call spir_func <4 x float> @_Z11read_imagef11ocl_image2d11ocl_samplerDv2_f(
+; CHECK-LLVM: call spir_func <4 x float> @_Z11read_imagef15ocl_image2dmsaaDv2_ii(
+; CHECK-LLVM: call spir_func <4 x float> @_Z11read_imagef11ocl_image2dDv2_i(
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024-n8:16:32:64"
+target triple = "spir64"
+
+%opencl.image2d_ro_t = type opaque
+%opencl.image2d_msaa_ro_t = type opaque
+
+; Function Attrs: nounwind
+define spir_kernel void @test(%opencl.image2d_ro_t addrspace(1)* %image, %opencl.image2d_msaa_ro_t addrspace(1)* %msaa, i32 %sampler, <2 x float> %coord, <2 x i32> %icoord, <4 x float> addrspace(1)* nocapture %results) #0 {
+entry:
+  %call = tail call spir_func <4 x float> @_Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f(%opencl.image2d_ro_t addrspace(1)* %image, i32 %sampler, <2 x float> %coord) #2
+  store <4 x float> %call, <4 x float> addrspace(1)* %results, align 16
+  %call1 = tail call spir_func <4 x float> @_Z11read_imagef19ocl_image2d_msaa_roDv2_ii(%opencl.image2d_msaa_ro_t addrspace(1)* %msaa, <2 x i32> %icoord, i32 1) #2
+  %arrayidx1 = getelementptr inbounds <4 x float>, <4 x float> addrspace(1)* %results, i64 1
+  store <4 x float> %call1, <4 x float> addrspace(1)* %arrayidx1, align 16
+  %call2 = tail call spir_func <4 x float> @_Z11read_imagef14ocl_image2d_roDv2_i(%opencl.image2d_ro_t addrspace(1)* %image, <2 x i32> %icoord) #2
+  %arrayidx2 = getelementptr inbounds <4 x float>, <4 x float> addrspace(1)* %results, i64 2
+  store <4 x float> %call2, <4 x float> addrspace(1)* %arrayidx2, align 16
+  ret void
+}
+
+declare spir_func <4 x float> @_Z11read_imagef14ocl_image2d_ro11ocl_samplerDv2_f(%opencl.image2d_ro_t addrspace(1)*, i32, <2 x float>) #1
+
+declare spir_func <4 x float> @_Z11read_imagef19ocl_image2d_msaa_roDv2_ii(%opencl.image2d_msaa_ro_t addrspace(1)*, <2 x i32>, i32) #1
+
+declare spir_func <4 x float> @_Z11read_imagef14ocl_image2d_roDv2_i(%opencl.image2d_ro_t addrspace(1)*, <2 x i32>) #1
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind readnone }
+attributes #2 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!7}
+!opencl.used.extensions = !{!8}
+!opencl.used.optional.core.features = !{!9}
+!opencl.compiler.options = !{!8}
+
+!0 = !{void (%opencl.image2d_ro_t addrspace(1)*, %opencl.image2d_msaa_ro_t addrspace(1)*, i32, <2 x float>, <2 x i32>, <4 x float> addrspace(1)*)* @test, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1, i32 1, i32 0, i32 0, i32 0, i32 1}
+!2 = !{!"kernel_arg_access_qual", !"read_only", !"read_only", !"none", !"none", !"none", !"none"}
+!3 = !{!"kernel_arg_type", !"image2d_t", !"image2d_msaa_t", !"sampler_t", !"float2", !"int2", !"float4*"}
+!4 = !{!"kernel_arg_base_type", !"image2d_t", !"image2d_msaa_t", !"sampler_t", !"float2", !"int2", !"float4*"}
+!5 = !{!"kernel_arg_type_qual", !"", !"", !"", !"", !"", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{i32 2, i32 0}
+!8 = !{}
+!9 = !{!"cl_images"}
@@ -0,0 +1,44 @@
+; Check that translations served from the cache match uncached ones in both
+; directions.
+; RUN: rm -rf %t.cache
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-spirv %t.bc -o %t.spv
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -o %t.1.spv
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -o %t.2.spv
+; RUN: cmp %t.spv %t.1.spv
+; RUN: cmp %t.spv %t.2.spv
+; RUN: llvm-spirv -r %t.spv -spirv-cache-dir=%t.cache -o %t.1.bc
+; RUN: llvm-spirv -r %t.spv -spirv-cache-dir=%t.cache -o %t.2.bc
+; RUN: llvm-dis %t.2.bc -o - | FileCheck %s
+
+; CHECK: define spir_kernel void @foo(i32 addrspace(1)* %a)
+; CHECK: store i32 42, i32 addrspace(1)* %a
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  store i32 42, i32 addrspace(1)* %a, align 4
+  ret void
+}
+
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
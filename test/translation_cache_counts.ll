@@ -0,0 +1,18 @@
+; Check that the hits and misses of the translation cache are reported with
+; -time-passes, so also in builds without assertions, and that an entry which
+; can not be used counts as a miss.
+; RUN: rm -rf %t.cache %t.rcache
+; RUN: llvm-as %S/translation_cache.ll -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -time-passes -o %t.1.spv 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -time-passes -o %t.2.spv 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-spirv -r %t.1.spv -spirv-cache-dir=%t.rcache -o %t.1.bc
+; RUN: find %t.rcache -type f -exec cp %s {} \;
+; RUN: llvm-spirv -r %t.1.spv -spirv-cache-dir=%t.rcache -time-passes -o %t.2.bc 2>&1 | FileCheck %s --check-prefix=MISS
+
+; MISS: Translation cache lookup
+; MISS: Translation cache hits: 0
+; MISS-NEXT: Translation cache misses: 1
+
+; HIT: Translation cache lookup
+; HIT: Translation cache hits: 1
+; HIT-NEXT: Translation cache misses: 0
@@ -0,0 +1,26 @@
+; Check that the second translation of the module of translation_cache.ll is
+; found in the translation cache in both directions, that an option affecting
+; the result is part of the key, that one which does not is not, and that
+; the version of the translator is part of the key.
+; REQUIRES: asserts
+; RUN: rm -rf %t.cache
+; RUN: llvm-as %S/translation_cache.ll -o %t.bc
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -stats -o %t.1.spv 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -stats -o %t.2.spv 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-verify=none -stats -o %t.3.spv 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-mem2reg=false -stats -o %t.4.spv 2>&1 | FileCheck %s --check-prefix=MISS
+; A result of another version of the translator is not reused.
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-cache-version=old -stats -o %t.5.spv 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-cache-version=old -stats -o %t.6.spv 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-spirv %t.bc -spirv-cache-dir=%t.cache -spirv-cache-version=new -stats -o %t.7.spv 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: llvm-spirv -r %t.1.spv -spirv-cache-dir=%t.cache -stats -o %t.1.bc 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: llvm-spirv -r %t.1.spv -spirv-cache-dir=%t.cache -stats -o %t.2.bc 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-spirv -r %t.1.spv -spirv-cache-dir=%t.cache -spirv-cache-version=old -stats -o %t.3.bc 2>&1 | FileCheck %s --check-prefix=MISS
+
+; MISS-NOT: Number of translations found in the translation cache
+; MISS: 1 spirv - Number of translations not found in the translation cache
+; MISS-NOT: Number of translations found in the translation cache
+
+; HIT-NOT: Number of translations not found in the translation cache
+; HIT: 1 spirv - Number of translations found in the translation cache
+; HIT-NOT: Number of translations not found in the translation cache
@@ -0,0 +1,41 @@
+; Check that a module found broken by the end of pipeline verification fails
+; the translation, and that verifying after each pass stops at the first pass.
+; RUN: llvm-as -disable-verify %s -o %t.bc
+; RUN: not llvm-spirv %t.bc -spirv-verify=end -o %t.spv 2>&1 | FileCheck %s
+; RUN: not llvm-spirv %t.bc -spirv-verify=each-pass -o %t.spv 2>&1 | FileCheck %s --check-prefix=CHECK-EACH
+; RUN: llvm-spirv %t.bc -spirv-verify=none -o %t.spv
+
+; CHECK: Fails to save LLVM as SPIRV: Fails to verify module after LLVM to SPIR-V translation: Unfinished range!
+
+; CHECK-EACH: LLVM ERROR: Fails to verify module after TransOCLMD: Unfinished range!
+
+target datalayout = "e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-v256:256-v512:512-v1024:1024"
+target triple = "spir64-unknown-unknown"
+
+; Function Attrs: nounwind
+define spir_kernel void @foo(i32 addrspace(1)* %a) #0 {
+entry:
+  %0 = load i32, i32 addrspace(1)* %a, align 4, !range !8
+  %add = add i32 %0, 1
+  store i32 %add, i32 addrspace(1)* %a, align 4
+  ret void
+}
+attributes #0 = { nounwind }
+
+!opencl.kernels = !{!0}
+!opencl.enable.FP_CONTRACT = !{}
+!opencl.spir.version = !{!6}
+!opencl.ocl.version = !{!6}
+!opencl.used.extensions = !{!7}
+!opencl.used.optional.core.features = !{!7}
+!opencl.compiler.options = !{!7}
+
+!0 = !{void (i32 addrspace(1)*)* @foo, !1, !2, !3, !4, !5}
+!1 = !{!"kernel_arg_addr_space", i32 1}
+!2 = !{!"kernel_arg_access_qual", !"none"}
+!3 = !{!"kernel_arg_type", !"int*"}
+!4 = !{!"kernel_arg_base_type", !"int*"}
+!5 = !{!"kernel_arg_type_qual", !""}
+!6 = !{i32 1, i32 2}
+!7 = !{}
+!8 = !{i32 0}
@@ -0,0 +1,706 @@
+//===-- llvm-spirv-bench.cpp - Load test of the llvm-spirv server -*- C++ -*-===//
+//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+/// \file
+///
+///  Sends translation requests to a llvm-spirv server, or translates them in
+///  process, and reports the throughput and the latency percentiles of the
+///  responses. It also reports how many builtin names the translating
+///  process found in its cache of mangled names and how many it mangled.
+///
+///  Common Usage:
+///  llvm-spirv-bench -socket=s x.bc      - Load test the server listening
+///                                         on the socket s with x.bc
+///  llvm-spirv-bench -spawn=llvm-spirv x.bc y.spv
+///                                       - Start llvm-spirv -server with
+///                                         pipes and load test it with x.bc
+///                                         and y.spv
+///  llvm-spirv-bench -in-process x.bc    - Translate x.bc in this process
+///                                         with the in-memory WriteSPIRV
+///  llvm-spirv-bench -in-process -forward-ref-loops=1000
+///                                       - Translate to LLVM a generated
+///                                         module whose phis have many
+///                                         forward references
+///
+///  Inputs starting with the SPIR-V magic number are translated to LLVM,
+///  the others to SPIR-V.
+///
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "SPIRV.h"
+#include "SPIRVServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef LLVM_ON_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
+
+using namespace llvm;
+using namespace SPIRV;
+
+static cl::list<std::string>
+InputFiles(cl::Positional, cl::ZeroOrMore, cl::desc("<input files>"));
+
+static cl::opt<std::string>
+SocketPath("socket", cl::desc("Unix domain socket of the server"),
+    cl::value_desc("path"));
+
+static cl::opt<std::string>
+SpawnServer("spawn", cl::desc("Start the given llvm-spirv as server for the "
+    "test, listening on -socket if given and on pipes otherwise"),
+    cl::value_desc("program"));
+
+static cl::list<std::string>
+ServerArgs("server-arg", cl::desc("Argument passed to the spawned server"),
+    cl::value_desc("arg"));
+
+static cl::opt<unsigned>
+NumRequests("requests", cl::desc("Number of measured requests"),
+    cl::init(100));
+
+static cl::opt<unsigned>
+Concurrency("concurrency", cl::desc("Number of requests in flight. Each of "
+    "them has its own connection to a socket"), cl::init(4));
+
+static cl::opt<unsigned>
+NumWarmup("warmup", cl::desc("Number of requests sent before the "
+    "measurement"), cl::init(0));
+
+static cl::opt<bool>
+InProcess("in-process", cl::desc("Translate the inputs in this process "
+    "instead of sending them to a server"));
+
+static cl::opt<std::string>
+OutputFile("o", cl::desc("With -in-process, write the translation of the "
+    "first input to the file"), cl::value_desc("filename"));
+
+static cl::opt<unsigned>
+ForwardRefLoops("forward-ref-loops", cl::desc("With -in-process, also "
+    "translate a generated SPIR-V function with the given number of loops. "
+    "Each loop has several phis whose values on the back edge are forward "
+    "references"), cl::init(0));
+
+namespace {
+/// An input of the load test.
+struct BenchInput {
+  std::string Name;
+  std::unique_ptr<MemoryBuffer> Buffer;
+  uint32_t Kind;
+  /// The words of a SPIR-V input, aligned for the in-memory ReadSPIRV.
+  std::vector<uint32_t> Words;
+};
+} // anonymous namespace
+
+static std::vector<BenchInput> Inputs;
+
+/// Send the request \p I on behalf of the worker \p W and wait for its
+/// response.
+/// \returns false and the error in \p ErrMsg if the request fails.
+typedef std::function<bool(unsigned W, unsigned I, std::string &ErrMsg)>
+  RequestSender;
+
+#ifdef LLVM_ON_UNIX
+namespace {
+/// A connection to the server which can have several requests in flight.
+class ClientConnection {
+public:
+  /// Requests are written to \p OutFD and responses read from \p InFD.
+  ClientConnection(int InFD, int OutFD)
+    :InFD(InFD), OutFD(OutFD), NextId(0), Broken(false) {
+    Reader = std::thread([this]{ readResponses(); });
+  }
+
+  /// Close the connection after the responses of all the requests sent
+  /// have been received.
+  ~ClientConnection() {
+    if (InFD == OutFD)
+      ::shutdown(OutFD, SHUT_WR);
+    else
+      ::close(OutFD);
+    Reader.join();
+    ::close(InFD);
+  }
+
+  /// Send a request and wait for its response.
+  /// \returns false if the connection is broken.
+  bool request(uint32_t Kind, StringRef Payload, uint32_t &Status,
+      std::string &Response);
+
+private:
+  struct PendingResponse {
+    bool Done;
+    uint32_t Status;
+    std::string Payload;
+    PendingResponse():Done(false), Status(SPIRVServerError) {}
+  };
+
+  int InFD;
+  int OutFD;
+  std::mutex WriteLock;
+  /// Guards the members below.
+  std::mutex Lock;
+  std::condition_variable Answered;
+  std::map<uint32_t, PendingResponse *> Pending;
+  uint32_t NextId;
+  bool Broken;
+  std::thread Reader;
+
+  void readResponses();
+};
+} // anonymous namespace
+
+bool
+ClientConnection::request(uint32_t Kind, StringRef Payload, uint32_t &Status,
+    std::string &Response) {
+  PendingResponse R;
+  uint32_t Id;
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (Broken)
+      return false;
+    Id = NextId++;
+    Pending[Id] = &R;
+  }
+  bool Sent;
+  {
+    std::lock_guard<std::mutex> Guard(WriteLock);
+    Sent = writeSPIRVServerFrame(OutFD, Id, Kind, Payload);
+  }
+  std::unique_lock<std::mutex> Guard(Lock);
+  if (Sent)
+    Answered.wait(Guard, [&]{ return R.Done || Broken; });
+  if (!R.Done) {
+    Pending.erase(Id);
+    return false;
+  }
+  Status = R.Status;
+  Response.swap(R.Payload);
+  return true;
+}
+
+void
+ClientConnection::readResponses() {
+  uint32_t Id, Status;
+  std::string Payload;
+  while (readSPIRVServerFrame(InFD, Id, Status, Payload)) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto Loc = Pending.find(Id);
+    if (Loc == Pending.end())
+      continue;
+    Loc->second->Status = Status;
+    Loc->second->Payload.swap(Payload);
+    Loc->second->Done = true;
+    Pending.erase(Loc);
+    Answered.notify_all();
+  }
+  std::lock_guard<std::mutex> Guard(Lock);
+  Broken = true;
+  Answered.notify_all();
+}
+
+static int
+connectToSocket(StringRef Path) {
+  sockaddr_un Addr;
+  memset(&Addr, 0, sizeof(Addr));
+  Addr.sun_family = AF_UNIX;
+  if (Path.size() >= sizeof(Addr.sun_path))
+    return -1;
+  memcpy(Addr.sun_path, Path.data(), Path.size());
+  int FD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (FD < 0)
+    return -1;
+  if (::connect(FD, reinterpret_cast<sockaddr *>(&Addr), sizeof(Addr)) < 0) {
+    ::close(FD);
+    return -1;
+  }
+  return FD;
+}
+
+/// Start the server. Its stdin and stdout are connected to \p ToServer and
+/// \p FromServer unless it listens on a socket.
+/// \returns the process id of the server, or -1 on failure.
+static pid_t
+spawnServer(int &ToServer, int &FromServer) {
+  std::vector<std::string> Args;
+  Args.push_back(SpawnServer);
+  Args.push_back("-server");
+  if (!SocketPath.empty())
+    Args.push_back("-socket=" + SocketPath);
+  Args.insert(Args.end(), ServerArgs.begin(), ServerArgs.end());
+  std::vector<char *> Argv;
+  for (auto &A : Args)
+    Argv.push_back(&A[0]);
+  Argv.push_back(nullptr);
+
+  int In[2], Out[2];
+  bool UsePipes = SocketPath.empty();
+  if (UsePipes && (::pipe(In) < 0 || ::pipe(Out) < 0))
+    return -1;
+  pid_t Pid = ::fork();
+  if (Pid == 0) {
+    if (UsePipes) {
+      ::dup2(In[0], STDIN_FILENO);
+      ::dup2(Out[1], STDOUT_FILENO);
+      ::close(In[0]); ::close(In[1]);
+      ::close(Out[0]); ::close(Out[1]);
+    }
+    ::execvp(Argv[0], Argv.data());
+    ::_exit(127);
+  }
+  if (UsePipes) {
+    ::close(In[0]);
+    ::close(Out[1]);
+    ToServer = In[1];
+    FromServer = Out[0];
+  }
+  return Pid;
+}
+
+/// Connect to the socket, waiting for up to ten seconds for a spawned
+/// server to start listening.
+static int
+waitForSocket(pid_t Server) {
+  for (unsigned Retry = 0; Retry < 1000; ++Retry) {
+    int FD = connectToSocket(SocketPath);
+    if (FD >= 0 || Server < 0)
+      return FD;
+    int Status;
+    if (::waitpid(Server, &Status, WNOHANG) == Server)
+      return -1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return -1;
+}
+#endif
+
+static double
+getPercentile(const std::vector<double> &Sorted, double P) {
+  size_t Rank = static_cast<size_t>(std::ceil(P / 100 * Sorted.size()));
+  return Sorted[std::max<size_t>(Rank, 1) - 1];
+}
+
+static bool
+loadInputs() {
+  for (auto &Name : InputFiles) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> Mem = MemoryBuffer::getFile(Name);
+    if (auto EC = Mem.getError()) {
+      errs() << "Fails to open input file " << Name << ": " << EC.message()
+             << '\n';
+      return false;
+    }
+    BenchInput In;
+    In.Name = Name;
+    In.Buffer = std::move(Mem.get());
+    StringRef Buf = In.Buffer->getBuffer();
+    uint32_t Magic = 0;
+    if (Buf.size() >= sizeof(Magic))
+      memcpy(&Magic, Buf.data(), sizeof(Magic));
+    In.Kind = Magic == 0x07230203 ? SPIRVServerSPIRVToLLVM
+                                  : SPIRVServerLLVMToSPIRV;
+    if (In.Kind == SPIRVServerSPIRVToLLVM) {
+      In.Words.resize(Buf.size() / sizeof(uint32_t));
+      memcpy(In.Words.data(), Buf.data(),
+          In.Words.size() * sizeof(uint32_t));
+    }
+    Inputs.push_back(std::move(In));
+  }
+  return true;
+}
+
+/// Generate a SPIR-V module with a function of ForwardRefLoops consecutive
+/// loops and add it to the inputs. The values of the phis of a loop header
+/// on the back edge are defined in the latch, which follows the header, so
+/// the reader sees each of them as a forward reference.
+static bool
+addForwardRefInput() {
+  const unsigned NumPhis = 8;
+  LLVMContext Context;
+  Module M("forward_refs", Context);
+  M.setTargetTriple("spir64-unknown-unknown");
+  M.setDataLayout("e-i64:64-v16:16-v24:32-v32:32-v48:64-v96:128-v192:256-"
+      "v256:256-v512:512-v1024:1024");
+  for (auto Name : {"opencl.spir.version", "opencl.ocl.version"}) {
+    Metadata *Ver[] = {
+      ConstantAsMetadata::get(ConstantInt::get(Type::getInt32Ty(Context), 1)),
+      ConstantAsMetadata::get(ConstantInt::get(Type::getInt32Ty(Context), 2))
+    };
+    M.getOrInsertNamedMetadata(Name)->addOperand(MDNode::get(Context, Ver));
+  }
+
+  IRBuilder<> B(Context);
+  Type *Int32Ty = B.getInt32Ty();
+  Type *Params[] = {PointerType::get(Int32Ty, 1), Int32Ty};
+  Function *F = Function::Create(
+      FunctionType::get(B.getVoidTy(), Params, false),
+      GlobalValue::ExternalLinkage, "forward_refs", &M);
+  F->setCallingConv(CallingConv::SPIR_FUNC);
+  auto Arg = F->arg_begin();
+  Value *Res = &*Arg++;
+  Value *N = &*Arg;
+
+  B.SetInsertPoint(BasicBlock::Create(Context, "entry", F));
+  SmallVector<Value *, NumPhis> Acc(NumPhis, B.getInt32(0));
+  for (unsigned L = 0; L < ForwardRefLoops; ++L) {
+    BasicBlock *Preheader = B.GetInsertBlock();
+    BasicBlock *Header = BasicBlock::Create(Context, "loop", F);
+    BasicBlock *Latch = BasicBlock::Create(Context, "latch", F);
+    BasicBlock *Exit = BasicBlock::Create(Context, "exit", F);
+    B.CreateBr(Header);
+
+    B.SetInsertPoint(Header);
+    PHINode *I = B.CreatePHI(Int32Ty, 2, "i");
+    I->addIncoming(B.getInt32(0), Preheader);
+    SmallVector<PHINode *, NumPhis> Phis;
+    for (unsigned K = 0; K < NumPhis; ++K) {
+      Phis.push_back(B.CreatePHI(Int32Ty, 2, "acc"));
+      Phis.back()->addIncoming(Acc[K], Preheader);
+    }
+    B.CreateCondBr(B.CreateICmpSLT(I, N), Latch, Exit);
+
+    B.SetInsertPoint(Latch);
+    for (unsigned K = 0; K < NumPhis; ++K)
+      Phis[K]->addIncoming(B.CreateAdd(Phis[K],
+          B.CreateXor(I, B.getInt32(K))), Latch);
+    I->addIncoming(B.CreateAdd(I, B.getInt32(1)), Latch);
+    B.CreateBr(Header);
+
+    B.SetInsertPoint(Exit);
+    Acc.clear();
+    Acc.append(Phis.begin(), Phis.end());
+  }
+  Value *Sum = Acc[0];
+  for (unsigned K = 1; K < NumPhis; ++K)
+    Sum = B.CreateAdd(Sum, Acc[K]);
+  B.CreateStore(Sum, Res);
+  B.CreateRetVoid();
+
+  SmallVector<uint32_t, 0> Words;
+  std::string ErrMsg;
+  if (!WriteSPIRV(&M, Words, ErrMsg)) {
+    errs() << "Fails to generate the forward reference module: " << ErrMsg
+           << '\n';
+    return false;
+  }
+  BenchInput In;
+  In.Name = "<forward references>";
+  In.Kind = SPIRVServerSPIRVToLLVM;
+  In.Words.assign(Words.begin(), Words.end());
+  In.Buffer = MemoryBuffer::getMemBufferCopy(
+      StringRef(reinterpret_cast<const char *>(Words.data()),
+          Words.size() * sizeof(uint32_t)), In.Name);
+  Inputs.push_back(std::move(In));
+  return true;
+}
+
+/// Send the warmup and the measured requests and report the throughput and
+/// the latencies.
+static int
+runRequests(const RequestSender &Send) {
+  std::atomic<unsigned> Next(0), Errors(0);
+  std::mutex ErrorLock;
+  std::string FirstError;
+  auto SendRequest = [&](unsigned W, unsigned I) {
+    std::string ErrMsg;
+    if (Send(W, I, ErrMsg))
+      return;
+    ++Errors;
+    std::lock_guard<std::mutex> Guard(ErrorLock);
+    if (FirstError.empty())
+      FirstError = ErrMsg;
+  };
+
+  for (unsigned I = 0; I < NumWarmup; ++I)
+    SendRequest(0, I);
+  Errors = 0;
+
+  std::vector<std::vector<double>> Latencies(Concurrency);
+  auto Start = std::chrono::steady_clock::now();
+  std::vector<std::thread> Workers;
+  for (unsigned W = 0; W < Concurrency; ++W)
+    Workers.emplace_back([&, W]{
+      for (unsigned I; (I = Next++) < NumRequests;) {
+        auto Begin = std::chrono::steady_clock::now();
+        SendRequest(W, I);
+        std::chrono::duration<double, std::milli> Latency =
+          std::chrono::steady_clock::now() - Begin;
+        Latencies[W].push_back(Latency.count());
+      }
+    });
+  for (auto &T : Workers)
+    T.join();
+  std::chrono::duration<double> Elapsed =
+    std::chrono::steady_clock::now() - Start;
+
+  std::vector<double> Sorted;
+  for (auto &L : Latencies)
+    Sorted.insert(Sorted.end(), L.begin(), L.end());
+  std::sort(Sorted.begin(), Sorted.end());
+
+  outs() << "requests: " << NumRequests << '\n'
+         << "errors: " << Errors << '\n';
+  if (!Sorted.empty()) {
+    outs() << format("throughput: %.1f requests/s\n",
+                     Sorted.size() / Elapsed.count());
+    outs() << format("latency min: %.3f ms\n", Sorted.front())
+           << format("latency p50: %.3f ms\n", getPercentile(Sorted, 50))
+           << format("latency p90: %.3f ms\n", getPercentile(Sorted, 90))
+           << format("latency p99: %.3f ms\n", getPercentile(Sorted, 99))
+           << format("latency max: %.3f ms\n", Sorted.back());
+  }
+  if (Errors) {
+    outs().flush();
+    errs() << "First error: " << FirstError << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+/// Translate an input in this process.
+/// \returns true if succeeds.
+static bool
+translateInProcess(const BenchInput &In, std::string &Output,
+    std::string &ErrMsg) {
+  LLVMContext Context;
+  if (In.Kind == SPIRVServerLLVMToSPIRV) {
+    Expected<std::unique_ptr<Module>> ModOrErr =
+      parseBitcodeFile(In.Buffer->getMemBufferRef(), Context);
+    if (!ModOrErr) {
+      ErrMsg = "Fails to load bitcode: " + toString(ModOrErr.takeError());
+      return false;
+    }
+    SmallVector<uint32_t, 0> Words;
+    if (!WriteSPIRV(ModOrErr->get(), Words, ErrMsg))
+      return false;
+    Output.assign(reinterpret_cast<const char *>(Words.data()),
+        Words.size() * sizeof(uint32_t));
+    return true;
+  }
+
+  Module *M = nullptr;
+  if (!ReadSPIRV(Context, In.Words, M, ErrMsg))
+    return false;
+  std::unique_ptr<Module> Guard(M);
+  std::string VerifyErr;
+  raw_string_ostream ErrorOS(VerifyErr);
+  if (verifyModule(*M, &ErrorOS)) {
+    ErrMsg = "Fails to verify module: " + ErrorOS.str();
+    return false;
+  }
+  raw_string_ostream OS(Output);
+  WriteBitcodeToFile(M, OS);
+  OS.flush();
+  return true;
+}
+
+static int
+runInProcess() {
+  if (!loadInputs() || (ForwardRefLoops && !addForwardRefInput()))
+    return -1;
+  if (Inputs.empty()) {
+    errs() << "No input files\n";
+    return -1;
+  }
+
+  if (!OutputFile.empty()) {
+    std::string Output, ErrMsg;
+    if (!translateInProcess(Inputs[0], Output, ErrMsg)) {
+      errs() << "Fails to translate " << Inputs[0].Name << ": " << ErrMsg
+             << '\n';
+      return -1;
+    }
+    std::error_code EC;
+    tool_output_file Out(OutputFile.c_str(), EC, sys::fs::F_None);
+    if (EC) {
+      errs() << "Fails to open output file: " << EC.message();
+      return -1;
+    }
+    Out.os() << Output;
+    Out.keep();
+  }
+
+  int Ret = runRequests([](unsigned W, unsigned I, std::string &ErrMsg) {
+    std::string Output;
+    return translateInProcess(Inputs[I % Inputs.size()], Output, ErrMsg);
+  });
+
+  uint64_t Hits, Misses;
+  getMangleCacheStats(Hits, Misses);
+  outs() << "mangle cache hits: " << Hits << '\n'
+         << "mangle cache misses: " << Misses << '\n';
+  return Ret;
+}
+
+#ifdef LLVM_ON_UNIX
+static int
+runLoadTest() {
+  if (!loadInputs())
+    return -1;
+  if (Inputs.empty()) {
+    errs() << "No input files\n";
+    return -1;
+  }
+
+  pid_t Server = -1;
+  int ToServer = -1, FromServer = -1;
+  if (!SpawnServer.empty()) {
+    Server = spawnServer(ToServer, FromServer);
+    if (Server < 0) {
+      errs() << "Fails to start " << SpawnServer << ": " << strerror(errno)
+             << '\n';
+      return -1;
+    }
+  }
+
+  // Requests on pipes share one connection. On a socket each request in
+  // flight has its own.
+  std::vector<std::unique_ptr<ClientConnection>> Conns;
+  if (!SocketPath.empty()) {
+    for (unsigned I = 0; I < Concurrency; ++I) {
+      int FD = waitForSocket(Server);
+      if (FD < 0) {
+        errs() << "Fails to connect to " << SocketPath << '\n';
+        Conns.clear();
+        if (Server > 0) {
+          ::kill(Server, SIGTERM);
+          ::waitpid(Server, nullptr, 0);
+        }
+        return -1;
+      }
+      Conns.emplace_back(new ClientConnection(FD, FD));
+    }
+  } else
+    Conns.emplace_back(new ClientConnection(FromServer, ToServer));
+
+  int Ret = runRequests([&](unsigned W, unsigned I, std::string &ErrMsg) {
+    const BenchInput &In = Inputs[I % Inputs.size()];
+    uint32_t Status;
+    std::string Response;
+    if (!Conns[W % Conns.size()]->request(In.Kind, In.Buffer->getBuffer(),
+        Status, Response)) {
+      ErrMsg = "Connection to the server lost";
+      return false;
+    }
+    if (Status == SPIRVServerSuccess)
+      return true;
+    ErrMsg = Response;
+    return false;
+  });
+
+  // A server which does not know the request answers it with an error, and
+  // then its counters are not reported.
+  uint32_t Status;
+  std::string Stats;
+  if (Conns[0]->request(SPIRVServerStats, "", Status, Stats) &&
+      Status == SPIRVServerSuccess)
+    outs() << Stats;
+
+  Conns.clear();
+  if (Server > 0) {
+    if (!SocketPath.empty())
+      ::kill(Server, SIGTERM);
+    ::waitpid(Server, nullptr, 0);
+  }
+  return Ret;
+}
+#endif
+
+int
+main(int ac, char** av) {
+  EnablePrettyStackTrace();
+  sys::PrintStackTraceOnErrorSignal(av[0]);
+  PrettyStackTraceProgram X(ac, av);
+  llvm_shutdown_obj Y;
+
+  cl::ParseCommandLineOptions(ac, av, "llvm-spirv server load test");
+
+  if (!Concurrency) {
+    errs() << "-concurrency must not be zero\n";
+    return -1;
+  }
+
+  if (InProcess) {
+    if (!SocketPath.empty() || !SpawnServer.empty()) {
+      errs() << "Cannot use -in-process with -socket, -spawn\n";
+      return -1;
+    }
+    return runInProcess();
+  }
+  if (!OutputFile.empty() || ForwardRefLoops) {
+    errs() << "-o and -forward-ref-loops require -in-process\n";
+    return -1;
+  }
+
+#ifdef LLVM_ON_UNIX
+  if (SocketPath.empty() && SpawnServer.empty()) {
+    errs() << "Either -socket, -spawn or -in-process is required\n";
+    return -1;
+  }
+  // A server which went away is reported as an error of its requests.
+  ::signal(SIGPIPE, SIG_IGN);
+  return runLoadTest();
+#else
+  errs() << "The llvm-spirv server is not supported on this platform\n";
+  return -1;
+#endif
+}
@@ -0,0 +1,348 @@
+//===- SPIRVServer.cpp - Resident LLVM/SPIR-V translation server ----------===//
+//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file implements the server mode of llvm-spirv. The server stays
+// resident between translations, so the pass registry, the parsed command
+// line, the SPIR-V tables and the cache of mangled builtin names are set up
+// once and stay warm for every request instead of once per process.
+//
+// Each connection has a thread reading its requests, which are queued for a
+// pool of worker threads. Every request is translated in its own
+// LLVMContext. Only SPIR-V errors are turned into error responses; a fatal
+// error or an unreachable in the translator still ends the server.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SPIRVServer.h"
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "SPIRV.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef LLVM_ON_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+using namespace llvm;
+
+namespace SPIRV {
+// Defined in libSPIRV. A SPIR-V error must not abort the server.
+extern bool SPIRVDbgAssertOnError;
+}
+
+using namespace SPIRV;
+
+/// Translate the payload of a request.
+/// \returns true if succeeds.
+static bool
+translateRequest(uint32_t Kind, StringRef Input, const TranslatorOptions &Opts,
+    std::string &Output, std::string &ErrMsg) {
+  LLVMContext Context;
+  switch (Kind) {
+  case SPIRVServerPing:
+    return true;
+  case SPIRVServerStats: {
+    uint64_t Hits, Misses;
+    getMangleCacheStats(Hits, Misses);
+    raw_string_ostream OS(Output);
+    OS << "mangle cache hits: " << Hits << '\n'
+       << "mangle cache misses: " << Misses << '\n';
+    OS.flush();
+    return true;
+  }
+  case SPIRVServerLLVMToSPIRV: {
+    Expected<std::unique_ptr<Module>> ModOrErr =
+      parseBitcodeFile(MemoryBufferRef(Input, ""), Context);
+    if (!ModOrErr) {
+      ErrMsg = "Fails to load bitcode: " + toString(ModOrErr.takeError());
+      return false;
+    }
+    raw_string_ostream OS(Output);
+    bool Succeed = WriteSPIRV(ModOrErr->get(), OS, Opts, ErrMsg);
+    OS.flush();
+    return Succeed;
+  }
+  case SPIRVServerSPIRVToLLVM: {
+    if (Input.size() % sizeof(uint32_t)) {
+      ErrMsg = "Invalid SPIR-V binary size";
+      return false;
+    }
+    // The words are decoded in place, so copy them to aligned storage.
+    std::vector<uint32_t> Words(Input.size() / sizeof(uint32_t));
+    if (!Words.empty())
+      memcpy(Words.data(), Input.data(), Input.size());
+    Module *M = nullptr;
+    if (!ReadSPIRV(Context, Words, Opts, M, ErrMsg))
+      return false;
+    std::unique_ptr<Module> Guard(M);
+    std::string VerifyErr;
+    raw_string_ostream ErrorOS(VerifyErr);
+    if (verifyModule(*M, &ErrorOS)) {
+      ErrMsg = "Fails to verify module: " + ErrorOS.str();
+      return false;
+    }
+    raw_string_ostream OS(Output);
+    WriteBitcodeToFile(M, OS);
+    OS.flush();
+    return true;
+  }
+  default:
+    ErrMsg = "Unknown request kind " + std::to_string(Kind);
+    return false;
+  }
+}
+
+#ifdef LLVM_ON_UNIX
+namespace {
+/// A stream of requests and their responses.
+struct ServerConnection {
+  int InFD;
+  int OutFD;
+  /// Serializes the responses written by the workers.
+  std::mutex WriteLock;
+  /// Number of requests read but not yet answered, guarded by PendingLock.
+  unsigned Pending;
+  std::mutex PendingLock;
+  std::condition_variable Answered;
+
+  ServerConnection(int InFD, int OutFD)
+    :InFD(InFD), OutFD(OutFD), Pending(0) {}
+};
+
+struct ServerRequest {
+  std::shared_ptr<ServerConnection> Conn;
+  uint32_t Id;
+  uint32_t Kind;
+  std::string Payload;
+};
+
+class TranslationServer {
+public:
+  TranslationServer(const TranslatorOptions &Opts, unsigned Threads)
+    :Opts(Opts), Stopping(false), Connections(0) {
+    for (unsigned I = 0; I < Threads; ++I)
+      Workers.emplace_back([this]{ work(); });
+  }
+
+  ~TranslationServer() {
+    {
+      std::lock_guard<std::mutex> Lock(QueueLock);
+      Stopping = true;
+    }
+    Queued.notify_all();
+    for (auto &T : Workers)
+      T.join();
+  }
+
+  /// Queue the requests of \p Conn until its input ends, then wait until
+  /// all of them have been answered.
+  void serve(std::shared_ptr<ServerConnection> Conn);
+
+  /// Serve the socket \p FD on a new thread and close it afterwards.
+  void serveSocket(int FD);
+
+  /// Wait until the sockets served by serveSocket are closed.
+  void waitForSockets();
+
+private:
+  TranslatorOptions Opts;
+  std::vector<std::thread> Workers;
+  std::deque<ServerRequest> Queue;
+  std::mutex QueueLock;
+  std::condition_variable Queued;
+  bool Stopping;
+  /// Number of sockets being served, guarded by ConnectionLock.
+  unsigned Connections;
+  std::mutex ConnectionLock;
+  std::condition_variable Closed;
+
+  void work();
+};
+} // anonymous namespace
+
+void
+TranslationServer::serve(std::shared_ptr<ServerConnection> Conn) {
+  ServerRequest R;
+  R.Conn = Conn;
+  while (readSPIRVServerFrame(Conn->InFD, R.Id, R.Kind, R.Payload)) {
+    {
+      std::lock_guard<std::mutex> Lock(Conn->PendingLock);
+      ++Conn->Pending;
+    }
+    {
+      std::lock_guard<std::mutex> Lock(QueueLock);
+      Queue.push_back(std::move(R));
+    }
+    Queued.notify_one();
+    R.Conn = Conn;
+  }
+  std::unique_lock<std::mutex> Lock(Conn->PendingLock);
+  Conn->Answered.wait(Lock, [&]{ return Conn->Pending == 0; });
+}
+
+void
+TranslationServer::serveSocket(int FD) {
+  {
+    std::lock_guard<std::mutex> Lock(ConnectionLock);
+    ++Connections;
+  }
+  std::thread([this, FD]{
+    serve(std::make_shared<ServerConnection>(FD, FD));
+    ::close(FD);
+    std::lock_guard<std::mutex> Lock(ConnectionLock);
+    if (--Connections == 0)
+      Closed.notify_all();
+  }).detach();
+}
+
+void
+TranslationServer::waitForSockets() {
+  std::unique_lock<std::mutex> Lock(ConnectionLock);
+  Closed.wait(Lock, [&]{ return Connections == 0; });
+}
+
+void
+TranslationServer::work() {
+  for (;;) {
+    ServerRequest R;
+    {
+      std::unique_lock<std::mutex> Lock(QueueLock);
+      Queued.wait(Lock, [&]{ return Stopping || !Queue.empty(); });
+      if (Queue.empty())
+        return;
+      R = std::move(Queue.front());
+      Queue.pop_front();
+    }
+    std::string Output, ErrMsg;
+    bool Succeed = translateRequest(R.Kind, R.Payload, Opts, Output, ErrMsg);
+    R.Payload.clear();
+    {
+      // A client which went away is not an error of the server, so the
+      // result of the write is ignored.
+      std::lock_guard<std::mutex> Lock(R.Conn->WriteLock);
+      writeSPIRVServerFrame(R.Conn->OutFD, R.Id,
+          Succeed ? SPIRVServerSuccess : SPIRVServerError,
+          Succeed ? Output : ErrMsg);
+    }
+    std::lock_guard<std::mutex> Lock(R.Conn->PendingLock);
+    if (--R.Conn->Pending == 0)
+      R.Conn->Answered.notify_all();
+  }
+}
+
+static int
+listenOnSocket(StringRef SocketPath) {
+  sockaddr_un Addr;
+  memset(&Addr, 0, sizeof(Addr));
+  Addr.sun_family = AF_UNIX;
+  if (SocketPath.size() >= sizeof(Addr.sun_path)) {
+    errs() << "Socket path is too long: " << SocketPath << '\n';
+    return -1;
+  }
+  memcpy(Addr.sun_path, SocketPath.data(), SocketPath.size());
+
+  int FD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (FD < 0) {
+    errs() << "Fails to create socket: " << strerror(errno) << '\n';
+    return -1;
+  }
+  ::unlink(Addr.sun_path);
+  if (::bind(FD, reinterpret_cast<sockaddr *>(&Addr), sizeof(Addr)) < 0 ||
+      ::listen(FD, SOMAXCONN) < 0) {
+    errs() << "Fails to listen on " << SocketPath << ": " << strerror(errno)
+           << '\n';
+    ::close(FD);
+    return -1;
+  }
+  sys::RemoveFileOnSignal(SocketPath);
+  return FD;
+}
+#endif
+
+int
+SPIRV::runSPIRVServer(const TranslatorOptions &Opts, StringRef SocketPath,
+    unsigned Threads) {
+#ifdef LLVM_ON_UNIX
+  SPIRVDbgAssertOnError = false;
+  // Writing to a client which went away must not terminate the server.
+  ::signal(SIGPIPE, SIG_IGN);
+  if (!Threads)
+    Threads = std::max(1u, std::thread::hardware_concurrency());
+  TranslationServer Server(Opts, Threads);
+
+  if (SocketPath.empty()) {
+    Server.serve(std::make_shared<ServerConnection>(STDIN_FILENO,
+        STDOUT_FILENO));
+    return 0;
+  }
+
+  int ListenFD = listenOnSocket(SocketPath);
+  if (ListenFD < 0)
+    return -1;
+  for (;;) {
+    int FD = ::accept(ListenFD, nullptr, nullptr);
+    if (FD >= 0) {
+      Server.serveSocket(FD);
+      continue;
+    }
+    if (errno == EINTR || errno == ECONNABORTED)
+      continue;
+    errs() << "Fails to accept connection: " << strerror(errno) << '\n';
+    break;
+  }
+  ::close(ListenFD);
+  Server.waitForSockets();
+  return -1;
+#else
+  errs() << "Server mode is not supported on this platform\n";
+  return -1;
+#endif
+}
@@ -0,0 +1,167 @@
+//===- SPIRVServer.h - Resident LLVM/SPIR-V translation server --*- C++ -*-===//
+//
+//
+//                     The LLVM/SPIRV Translator
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal with the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimers.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimers in the documentation
+// and/or other materials provided with the distribution.
+// Neither the names of Advanced Micro Devices, Inc., nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// Software without specific prior written permission.
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS WITH
+// THE SOFTWARE.
+//
+//
+// This file declares the resident translation server of llvm-spirv and the
+// framed protocol it speaks, which is shared with the llvm-spirv-bench load
+// test client.
+//
+// A frame is a little-endian 32-bit length followed by that many bytes: a
+// 32-bit request id, a 32-bit code and the payload. The code of a request is
+// a SPIRVServerRequestKind and the code of a response a
+// SPIRVServerResponseStatus. A response has the id of its request and carries
+// either the translated module or an error message. Responses on one
+// connection are sent in the order their translations complete, so a client
+// may have several requests in flight and match the responses by id.
+//
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_SPIRV_SERVER_H
+#define LLVM_SPIRV_SERVER_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/Endian.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#ifdef LLVM_ON_UNIX
+#include <unistd.h>
+#endif
+
+namespace SPIRV {
+struct TranslatorOptions;
+
+enum SPIRVServerRequestKind : uint32_t {
+  /// Do nothing. The response has an empty payload.
+  SPIRVServerPing = 0,
+  /// Translate the LLVM bitcode payload to SPIR-V binary.
+  SPIRVServerLLVMToSPIRV = 1,
+  /// Translate the SPIR-V binary payload to LLVM bitcode.
+  SPIRVServerSPIRVToLLVM = 2,
+  /// Report the counters of the server since it started. The response
+  /// payload is text with a "name: value" line for each counter.
+  SPIRVServerStats = 3,
+};
+
+enum SPIRVServerResponseStatus : uint32_t {
+  SPIRVServerSuccess = 0,
+  SPIRVServerError = 1,
+};
+
+/// Size of the id and the code of a frame.
+const uint32_t SPIRVServerFrameHeaderSize = 8;
+/// Frames longer than this are rejected and close the connection.
+const uint32_t SPIRVServerMaxFrameSize = 1u << 30;
+
+#ifdef LLVM_ON_UNIX
+/// Read exactly \p Size bytes from \p FD.
+/// \returns false at the end of the input or on an error.
+inline bool readSPIRVServerBytes(int FD, char *Buf, size_t Size) {
+  while (Size) {
+    ssize_t N = ::read(FD, Buf, Size);
+    if (N < 0 && errno == EINTR)
+      continue;
+    if (N <= 0)
+      return false;
+    Buf += N;
+    Size -= N;
+  }
+  return true;
+}
+
+/// Write all \p Size bytes of \p Buf to \p FD.
+inline bool writeSPIRVServerBytes(int FD, const char *Buf, size_t Size) {
+  while (Size) {
+    ssize_t N = ::write(FD, Buf, Size);
+    if (N < 0 && errno == EINTR)
+      continue;
+    if (N <= 0)
+      return false;
+    Buf += N;
+    Size -= N;
+  }
+  return true;
+}
+
+/// Read one frame from \p FD.
+/// \returns false at the end of the input, on an error or if the frame is
+/// malformed.
+inline bool readSPIRVServerFrame(int FD, uint32_t &Id, uint32_t &Code,
+    std::string &Payload) {
+  using namespace llvm::support;
+  char Header[4 + SPIRVServerFrameHeaderSize];
+  if (!readSPIRVServerBytes(FD, Header, sizeof(Header)))
+    return false;
+  uint32_t Length = endian::read32le(Header);
+  if (Length < SPIRVServerFrameHeaderSize || Length > SPIRVServerMaxFrameSize)
+    return false;
+  Id = endian::read32le(Header + 4);
+  Code = endian::read32le(Header + 8);
+  Payload.resize(Length - SPIRVServerFrameHeaderSize);
+  return readSPIRVServerBytes(FD, &Payload[0], Payload.size());
+}
+
+/// Write one frame to \p FD with a single write, so that frames written by
+/// different threads under a common lock are not split by other output.
+inline bool writeSPIRVServerFrame(int FD, uint32_t Id, uint32_t Code,
+    llvm::StringRef Payload) {
+  using namespace llvm::support;
+  if (Payload.size() > SPIRVServerMaxFrameSize - SPIRVServerFrameHeaderSize)
+    return false;
+  std::string Frame(4 + SPIRVServerFrameHeaderSize, '\0');
+  endian::write32le(&Frame[0], SPIRVServerFrameHeaderSize + Payload.size());
+  endian::write32le(&Frame[4], Id);
+  endian::write32le(&Frame[8], Code);
+  Frame.append(Payload.begin(), Payload.end());
+  return writeSPIRVServerBytes(FD, Frame.data(), Frame.size());
+}
+#endif
+
+/// Serve translation requests with \p Opts until the input ends, using
+/// \p Threads worker threads. Requests are read from stdin and responses
+/// written to stdout, unless \p SocketPath is not empty, in which case the
+/// server listens on the Unix domain socket at that path and serves every
+/// connection until it is terminated.
+///
+/// A translation failing with a SPIR-V error is answered with an error
+/// response and the server goes on. Errors the translator reports through
+/// report_fatal_error or llvm_unreachable still terminate the whole process,
+/// together with the requests of every connection in flight, so clients
+/// must be prepared to restart the server.
+/// \returns the exit code of the tool.
+int runSPIRVServer(const TranslatorOptions &Opts, llvm::StringRef SocketPath,
+    unsigned Threads);
+
+} // End namespace SPIRV
+
+#endif
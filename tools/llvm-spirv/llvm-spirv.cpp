@@ -39,6 +39,21 @@
 ///  llvm-spirv -r       - Read SPIRV from stdin, write LLVM bitcode to stdout
 ///  llvm-spirv -r x.bil - Read SPIRV from the x.bil file, write SPIR-V to
 ///                        the x.bc file
+///  llvm-spirv -server  - Serve translation requests framed as described in
+///                        SPIRVServer.h, read from stdin or from the Unix
+///                        domain socket given by -socket
+///  llvm-spirv x.spv -link y.spv
+///                      - Link the SPIR-V modules x.spv and y.spv, write the
+///                        result to the x.spv file unless -o is given
+///  llvm-spirv -demangle-builtins x.txt
+///                      - Demangle the OpenCL builtin names in x.txt, one per
+///                        line, and print their signatures and the names
+///                        mangled again from the signatures if they differ
+///  llvm-spirv -in-memory -time-passes x.bc
+///                      - Translate through the ReadSPIRV and WriteSPIRV
+///                        overloads taking vectors of words, and report the
+///                        time of the translation, to compare it with the
+///                        stream based overloads used without -in-memory
 ///
 ///  Options:
 ///      --help   - Output command line options
@@ -50,12 +65,15 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Pass.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/ToolOutputFile.h"
 
 #ifndef _SPIRV_SUPPORT_TEXT_FMT
@@ -63,7 +81,9 @@
 #endif
 
 #include "SPIRV.h"
+#include "SPIRVServer.h"
 
+#include <cstring>
 #include <memory>
 #include <fstream>
 #include <iostream>
@@ -92,6 +112,41 @@ static cl::opt<bool>
 IsRegularization("s", cl::desc(
     "Regularize LLVM to be representable by SPIR-V"));
 
+static cl::opt<std::string>
+KernelName("kernel", cl::desc("Translate only the given kernel and the "
+    "functions and global variables it uses (SPIR-V to LLVM)"),
+    cl::value_desc("name"));
+
+static cl::opt<bool>
+IsServer("server", cl::desc("Stay resident and serve translation requests "
+    "read from stdin, or from the socket given by -socket"));
+
+static cl::opt<std::string>
+SocketPath("socket", cl::desc("Unix domain socket the server listens on"),
+    cl::value_desc("path"));
+
+static cl::opt<unsigned>
+ServerThreads("server-threads", cl::desc("Number of requests the server "
+    "translates concurrently (default: number of hardware threads)"),
+    cl::init(0));
+
+static cl::list<std::string>
+LinkFiles("link", cl::desc("Link the given SPIR-V module into the input one"),
+    cl::value_desc("file"));
+
+static cl::opt<bool>
+InMemory("in-memory", cl::desc("Translate through the ReadSPIRV and "
+    "WriteSPIRV overloads taking vectors of words instead of streams"));
+
+static cl::opt<bool>
+IsDemangle("demangle-builtins", cl::desc("Demangle the OpenCL builtin names "
+    "read from the input, one per line"));
+
+namespace SPIRV {
+// Defined in libSPIRV.
+extern bool SPIRVDbgAssertOnError;
+}
+
 #ifdef _SPIRV_SUPPORT_TEXT_FMT
 namespace SPIRV {
 // Use textual format for SPIRV.
@@ -157,7 +212,22 @@ convertLLVMToSPIRV() {
   llvm::StringRef outFile(OutputFile);
   std::error_code EC;
   llvm::raw_fd_ostream OFS(outFile, EC, llvm::sys::fs::F_None);
-  if (!WriteSPIRV(M.get(), OFS, Err)) {
+  bool Succeed;
+  if (InMemory) {
+    // Writing the words is timed too, as the stream based overload writes
+    // the output while translating.
+    NamedRegionTimer T("translate", "LLVM to SPIR-V translation",
+        "llvm-spirv", "LLVM/SPIR-V translator", TimePassesIsEnabled);
+    SmallVector<uint32_t, 0> Words;
+    Succeed = WriteSPIRV(M.get(), Words, Err);
+    OFS.write(reinterpret_cast<const char *>(Words.data()),
+        Words.size() * sizeof(uint32_t));
+  } else {
+    NamedRegionTimer T("translate", "LLVM to SPIR-V translation",
+        "llvm-spirv", "LLVM/SPIR-V translator", TimePassesIsEnabled);
+    Succeed = WriteSPIRV(M.get(), OFS, Err);
+  }
+  if (!Succeed) {
     errs() << "Fails to save LLVM as SPIRV: " << Err << '\n';
     return -1;
   }
@@ -167,11 +237,35 @@ convertLLVMToSPIRV() {
 static int
 convertSPIRVToLLVM() {
   LLVMContext Context;
-  std::ifstream IFS(InputFile, std::ios::binary);
   Module *M;
   std::string Err;
-
-  if (!ReadSPIRV(Context, IFS, M, Err)) {
+  SPIRV::TranslatorOptions Opts = SPIRV::getDefaultTranslatorOptions();
+  Opts.KernelName = KernelName;
+
+  bool Succeed;
+  if (InMemory) {
+    // Reading and copying the input are timed too, as the stream based
+    // overload reads the input while translating.
+    NamedRegionTimer T("translate", "SPIR-V to LLVM translation",
+        "llvm-spirv", "LLVM/SPIR-V translator", TimePassesIsEnabled);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> Mem =
+        MemoryBuffer::getFileOrSTDIN(InputFile);
+    if (auto EC = Mem.getError()) {
+      errs() << "Fails to open input file: " << EC.message() << '\n';
+      return -1;
+    }
+    // The buffer is copied to have the words aligned.
+    StringRef Buf = Mem.get()->getBuffer();
+    std::vector<uint32_t> Words(Buf.size() / sizeof(uint32_t));
+    memcpy(Words.data(), Buf.data(), Words.size() * sizeof(uint32_t));
+    Succeed = ReadSPIRV(Context, Words, Opts, M, Err);
+  } else {
+    std::ifstream IFS(InputFile, std::ios::binary);
+    NamedRegionTimer T("translate", "SPIR-V to LLVM translation",
+        "llvm-spirv", "LLVM/SPIR-V translator", TimePassesIsEnabled);
+    Succeed = ReadSPIRV(Context, IFS, Opts, M, Err);
+  }
+  if (!Succeed) {
     errs() << "Fails to load SPIRV as LLVM Module: " << Err << '\n';
     return -1;
   }
@@ -296,12 +390,116 @@ regularizeLLVM() {
   return 0;
 }
 
+static int
+linkSPIRV() {
+  // Modules which do not link are an error of the input, which is reported
+  // rather than asserted.
+  SPIRV::SPIRVDbgAssertOnError = false;
+  std::vector<std::vector<uint32_t>> Modules;
+  std::vector<std::string> Files(1, InputFile);
+  Files.insert(Files.end(), LinkFiles.begin(), LinkFiles.end());
+  for (auto &File : Files) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> Mem =
+        MemoryBuffer::getFileOrSTDIN(File);
+    if (auto EC = Mem.getError()) {
+      errs() << "Fails to open input file " << File << ": " << EC.message()
+             << '\n';
+      return -1;
+    }
+    // The buffer is copied to have the words aligned.
+    StringRef Buf = Mem.get()->getBuffer();
+    Modules.emplace_back(Buf.size() / sizeof(uint32_t));
+    memcpy(Modules.back().data(), Buf.data(),
+        Modules.back().size() * sizeof(uint32_t));
+  }
+  std::vector<ArrayRef<uint32_t>> Inputs(Modules.begin(), Modules.end());
+
+  if (OutputFile.empty()) {
+    if (InputFile == "-")
+      OutputFile = "-";
+    else
+      OutputFile = removeExt(InputFile) + kExt::SpirvBinary;
+  }
+
+  std::error_code EC;
+  tool_output_file Out(OutputFile.c_str(), EC, sys::fs::F_None);
+  if (EC) {
+    errs() << "Fails to open output file: " << EC.message();
+    return -1;
+  }
+
+  std::string Err;
+  if (!LinkSPIRV(Inputs, Out.os(), Err)) {
+    errs() << "Fails to link SPIRV: " << Err << '\n';
+    return -1;
+  }
+  Out.keep();
+  return 0;
+}
+
+static int
+demangleBuiltins() {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Mem =
+      MemoryBuffer::getFileOrSTDIN(InputFile);
+  if (auto EC = Mem.getError()) {
+    errs() << "Fails to open input file: " << EC.message() << '\n';
+    return -1;
+  }
+  if (OutputFile.empty())
+    OutputFile = "-";
+  std::error_code EC;
+  tool_output_file Out(OutputFile.c_str(), EC, sys::fs::F_None);
+  if (EC) {
+    errs() << "Fails to open output file: " << EC.message();
+    return -1;
+  }
+  // Each name is printed with its signature, followed by the name mangled
+  // again from the signature if that is a different one.
+  SmallVector<StringRef, 64> Lines;
+  Mem.get()->getBuffer().split(Lines, '\n', -1, false);
+  for (StringRef Line : Lines) {
+    std::string Name = Line.trim().str();
+    if (Name.empty())
+      continue;
+    std::string Signature, Remangled;
+    Out.os() << Name << " -> ";
+    if (!DemangleOpenCLBuiltin(Name, Signature, Remangled)) {
+      Out.os() << "<invalid>\n";
+      continue;
+    }
+    Out.os() << Signature;
+    if (Remangled != Name)
+      Out.os() << " -> " << Remangled;
+    Out.os() << '\n';
+  }
+  Out.keep();
+  return 0;
+}
+
+namespace {
+/// Print the timers of -time-passes on exit, followed by the hit and miss
+/// counts of the translation cache, which timers can not show.
+struct TimingReport {
+  ~TimingReport() {
+    if (!TimePassesIsEnabled ||
+        SPIRV::getDefaultTranslatorOptions().CacheDir.empty())
+      return;
+    TimerGroup::printAll(errs());
+    uint64_t Hits, Misses;
+    SPIRV::getTranslationCacheStats(Hits, Misses);
+    errs() << "Translation cache hits: " << Hits << '\n'
+           << "Translation cache misses: " << Misses << '\n';
+  }
+};
+} // anonymous namespace
 
 int
 main(int ac, char** av) {
   EnablePrettyStackTrace();
   sys::PrintStackTraceOnErrorSignal(av[0]);
   PrettyStackTraceProgram X(ac, av);
+  llvm_shutdown_obj Y;  // Call llvm_shutdown() on exit to print timers.
+  TimingReport R;
 
   cl::ParseCommandLineOptions(ac, av, "LLVM/SPIR-V translator");
 
@@ -320,6 +518,39 @@ main(int ac, char** av) {
     return convertSPIRV();
 #endif
 
+  if (IsDemangle) {
+    if (IsReverse || IsRegularization || IsServer || !LinkFiles.empty()) {
+      errs() << "Cannot use -demangle-builtins with -r, -s, -server, -link\n";
+      return -1;
+    }
+    return demangleBuiltins();
+  }
+
+  if (!LinkFiles.empty()) {
+    if (IsReverse || IsRegularization || IsServer ||
+        SPIRV::SPIRVUseTextFormat) {
+      errs() << "Cannot use -link with -r, -s, -server, -spirv-text\n";
+      return -1;
+    }
+    return linkSPIRV();
+  }
+
+  if (InMemory && (IsRegularization || IsServer ||
+      SPIRV::SPIRVUseTextFormat)) {
+    errs() << "Cannot use -in-memory with -s, -server, -spirv-text\n";
+    return -1;
+  }
+
+  if (IsServer) {
+    if (IsReverse || IsRegularization || SPIRV::SPIRVUseTextFormat) {
+      errs() << "Cannot use -server with -r, -s, -spirv-text\n";
+      return -1;
+    }
+    SPIRV::TranslatorOptions Opts = SPIRV::getDefaultTranslatorOptions();
+    Opts.KernelName = KernelName;
+    return SPIRV::runSPIRVServer(Opts, SocketPath, ServerThreads);
+  }
+
   if (!IsReverse && !IsRegularization)
     return convertLLVMToSPIRV();
 